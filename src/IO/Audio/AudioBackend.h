@@ -0,0 +1,82 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 JAQUBA (https://github.com/JAQUBA)
+// Part of JQB_WindowsLib — https://github.com/JAQUBA/JQB_WindowsLib
+
+/**
+ * AudioBackend.h — device interface used by AudioEngine
+ *
+ * AudioEngine owns the threads, generators, snapshots, decimation and the
+ * capture stream; a backend only moves buffers of interleaved device
+ * samples. Each direction is a queue of numBuffers buffers of bufferFrames
+ * frames: the engine thread waits for the next free output buffer / the
+ * next recorded input buffer, fills or consumes it and hands it back, in
+ * queue order.
+ *
+ * Backends: AudioWinMMBackend (waveOut / waveIn, default), AudioNullBackend
+ * (no device — silence or RAW file, real-time or as-fast-as-possible clock)
+ * and AudioLoopbackBackend (output played straight back into the input).
+ *
+ * Nie zależy od WinAPI.
+ */
+
+#ifndef AUDIO_BACKEND_H
+#define AUDIO_BACKEND_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "AudioFormat.h"
+
+#define AUDIO_MAX_CHANNELS    8       // Kanałów na strumień (AudioEngine, backendy)
+
+// Stream parameters for open; sampleRate is the preferred rate on input and
+// the negotiated one on return
+struct AudioStreamConfig {
+    int      channels;
+    AudioSampleFormat format;
+    uint32_t sampleRate;
+    int      numBuffers;
+    int      bufferFrames;
+
+    int blockAlign() const { return channels * AudioFormat::sampleBytes(format); }
+    size_t bufferBytes() const { return (size_t)bufferFrames * blockAlign(); }
+};
+
+class AudioBackend {
+public:
+    virtual ~AudioBackend() {}
+
+    virtual std::vector<std::string> enumOutputDevices() = 0;
+    virtual std::vector<std::string> enumInputDevices() = 0;
+
+    // ---- Output (open/close: control thread, the rest: engine output thread) ----
+    virtual bool openOutput(int device, AudioStreamConfig& config) = 0;
+    virtual void closeOutput() = 0;
+    // Next free buffer (config.bufferBytes()), oldest first; nullptr after timeoutMs.
+    // Right after open all buffers are free — the engine primes the queue.
+    virtual char* waitOutputBuffer(uint32_t timeoutMs) = 0;
+    virtual void  submitOutputBuffer(char* buffer) = 0;
+    // Wakes a waitOutputBuffer() in progress (stop)
+    virtual void  wakeOutput() {}
+    // Frames played since open (modulo 2^32); false if unknown. Any thread.
+    virtual bool  getOutputPosition(uint32_t& frames) const = 0;
+    // Episodes of an empty queue (device had nothing to play)
+    virtual uint32_t getOutputUnderruns() const = 0;
+
+    // ---- Input (open/close: control thread, the rest: engine input thread) ----
+    // Opens and starts recording
+    virtual bool openInput(int device, AudioStreamConfig& config) = 0;
+    virtual void closeInput() = 0;
+    // Oldest recorded buffer and its frame count; nullptr after timeoutMs
+    virtual const char* waitInputBuffer(uint32_t timeoutMs, int& frames) = 0;
+    // Returns the buffer from waitInputBuffer() to the device
+    virtual void  releaseInputBuffer() = 0;
+    virtual void  wakeInput() {}
+    // Frames recorded since open (modulo 2^32), without frames lost to overruns;
+    // false if unknown. Any thread.
+    virtual bool  getInputPosition(uint32_t& frames) const = 0;
+    // Episodes of a full queue (device had nowhere to record, samples lost)
+    virtual uint32_t getInputOverruns() const = 0;
+};
+
+#endif // AUDIO_BACKEND_H
@@ -0,0 +1,131 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 JAQUBA (https://github.com/JAQUBA)
+// Part of JQB_WindowsLib — https://github.com/JAQUBA/JQB_WindowsLib
+
+#include "AudioCaptureRing.h"
+#include <cmath>
+
+AudioCaptureRing::AudioCaptureRing(size_t capacity)
+    : m_mask(0)
+    , m_start(0)
+    , m_pins(0)
+    , m_begin(0)
+    , m_end(0)
+{
+    setCapacity(capacity);
+}
+
+bool AudioCaptureRing::setCapacity(size_t capacity) {
+    size_t cap = 64;
+    while (cap < capacity) cap <<= 1;
+    if (cap == m_data.size()) return true;
+    if (pinned()) return false;         // Wątek konsumenta czyta z obecnego bufora
+
+    // Numeracja próbek biegnie dalej; stara zawartość przepada (czytelnicy
+    // dostaną ją jako overrun)
+    std::vector<std::atomic<float>> data(cap);
+    for (std::atomic<float>& v : data) v.store(0.0f, std::memory_order_relaxed);
+    m_data.swap(data);
+    m_mask = cap - 1;
+    m_start = m_end.load(std::memory_order_relaxed);
+    return true;
+}
+
+uint64_t AudioCaptureRing::oldestPosition(uint64_t end) const {
+    uint64_t cap = m_data.size();
+    uint64_t oldest = end > cap ? end - cap : 0;
+    return oldest > m_start ? oldest : m_start;
+}
+
+// ============================================================================
+// Pisarz
+// ============================================================================
+template <class T, class Convert>
+void AudioCaptureRing::writeBlock(const T* samples, size_t count, Convert convert) {
+    if (count == 0) return;
+    uint64_t end = m_end.load(std::memory_order_relaxed);
+    uint64_t newEnd = end + count;
+
+    // Ogłoś nadpisywany zakres, zanim zmieni się jakakolwiek próbka
+    m_begin.store(newEnd, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    // Blok dłuższy niż bufor: zostaje tylko jego koniec (numeracja rośnie o całość)
+    size_t skip = count > m_data.size() ? count - m_data.size() : 0;
+    for (size_t i = skip; i < count; i++) {
+        m_data[(size_t)(end + i) & m_mask].store(convert(samples[i]), std::memory_order_relaxed);
+    }
+    m_end.store(newEnd, std::memory_order_release);
+}
+
+void AudioCaptureRing::write(const int16_t* samples, size_t count) {
+    writeBlock(samples, count, [](int16_t s) { return (float)s * (1.0f / 32768.0f); });
+}
+
+void AudioCaptureRing::write(const float* samples, size_t count) {
+    writeBlock(samples, count, [](float s) { return s; });
+}
+
+// ============================================================================
+// Czytelnicy
+// ============================================================================
+AudioCaptureRing::Reader AudioCaptureRing::attach(size_t history) const {
+    uint64_t end = m_end.load(std::memory_order_acquire);
+    uint64_t oldest = oldestPosition(end);
+    Reader reader;
+    reader.position = end - oldest > history ? end - history : oldest;
+    return reader;
+}
+
+size_t AudioCaptureRing::available(const Reader& reader) const {
+    uint64_t end = m_end.load(std::memory_order_acquire);
+    if (reader.position >= end) return 0;
+    uint64_t oldest = oldestPosition(end);
+    return (size_t)(end - (reader.position > oldest ? reader.position : oldest));
+}
+
+template <class T, class Convert>
+size_t AudioCaptureRing::readBlock(Reader& reader, T* out, size_t maxSamples, Convert convert) const {
+    uint64_t cap = m_data.size();
+    for (;;) {
+        uint64_t end = m_end.load(std::memory_order_acquire);
+        if (reader.position > end) reader.position = end;
+        uint64_t oldest = oldestPosition(end);
+        if (reader.position < oldest) {
+            reader.overruns += oldest - reader.position;
+            reader.position = oldest;
+        }
+
+        uint64_t n = end - reader.position;
+        if (n > maxSamples) n = maxSamples;
+        if (n == 0) return 0;
+        for (uint64_t i = 0; i < n; i++) {
+            out[i] = convert(m_data[(size_t)(reader.position + i) & m_mask].load(std::memory_order_relaxed));
+        }
+
+        // Czy pisarz w międzyczasie nie nadpisał początku skopiowanego zakresu?
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint64_t begin = m_begin.load(std::memory_order_relaxed);
+        uint64_t safe = begin > cap ? begin - cap : 0;
+        if (reader.position >= safe) {
+            reader.position += n;
+            return (size_t)n;
+        }
+        // Kopia nieważna — pomiń nadpisane próbki i spróbuj jeszcze raz
+        reader.overruns += safe - reader.position;
+        reader.position = safe;
+    }
+}
+
+size_t AudioCaptureRing::read(Reader& reader, float* out, size_t maxSamples) const {
+    return readBlock(reader, out, maxSamples, [](float v) { return v; });
+}
+
+size_t AudioCaptureRing::read(Reader& reader, int16_t* out, size_t maxSamples) const {
+    return readBlock(reader, out, maxSamples, [](float v) {
+        float s = std::floor(v * 32768.0f + 0.5f);
+        if (s > 32767.0f)  s = 32767.0f;
+        if (s < -32768.0f) s = -32768.0f;
+        return (int16_t)s;
+    });
+}
@@ -0,0 +1,80 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 JAQUBA (https://github.com/JAQUBA)
+// Part of JQB_WindowsLib — https://github.com/JAQUBA/JQB_WindowsLib
+
+/**
+ * AudioCaptureRing.h — gap-free full-rate sample stream, one writer, many readers
+ *
+ * The audio thread appends every captured sample (float, full scale ±1.0);
+ * each consumer (FFT, logger, meter) keeps its own Reader cursor — a sample
+ * sequence number — and reads every sample in order at its own pace.
+ * The writer never waits: a reader that falls more than capacity() samples
+ * behind loses its oldest samples, and the count is added to its overrun
+ * counter. Torn reads are detected seqlock-style (write window announced
+ * before the copy, checked after it), so no lock is shared with readers.
+ *
+ * Nie korzysta z WinAPI, std::thread ani std::mutex — bezpieczne dla MinGW.org.
+ */
+
+#ifndef AUDIO_CAPTURE_RING_H
+#define AUDIO_CAPTURE_RING_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+class AudioCaptureRing {
+public:
+    // Consumer cursor — one per consumer, used from one thread
+    struct Reader {
+        uint64_t position = 0;          // sequence number of the next sample to read
+        uint64_t overruns = 0;          // samples lost because the reader fell behind
+    };
+
+    explicit AudioCaptureRing(size_t capacity = 1 << 18);
+
+    // Power of two (rounded up). Reallocates the buffer: only while nothing writes
+    // and no other thread reads. Refused (false, capacity unchanged) while pinned.
+    bool   setCapacity(size_t capacity);
+    size_t capacity() const { return m_data.size(); }
+
+    // Consumers that read on their own thread (AudioMeter, AudioRecorder) pin the
+    // ring for as long as they hold it — the buffer is never reallocated under them
+    void pin()   { m_pins.fetch_add(1, std::memory_order_acq_rel); }
+    void unpin() { m_pins.fetch_sub(1, std::memory_order_acq_rel); }
+    bool pinned() const { return m_pins.load(std::memory_order_acquire) > 0; }
+
+    // ---- Writer (one thread) ----
+    void write(const int16_t* samples, size_t count);     // s / 32768
+    void write(const float* samples, size_t count);
+    // Total samples written = sequence number of the next sample
+    uint64_t writePosition() const { return m_end.load(std::memory_order_acquire); }
+
+    // ---- Readers (any number, each with its own Reader) ----
+    // Cursor starting `history` samples before the newest one (0 = only new samples)
+    Reader attach(size_t history = 0) const;
+    size_t available(const Reader& reader) const;
+    // Next samples in order; returns count read (0 if nothing new). Samples
+    // overwritten before they could be read are skipped and counted in overruns.
+    size_t read(Reader& reader, float* out, size_t maxSamples) const;
+    size_t read(Reader& reader, int16_t* out, size_t maxSamples) const;
+
+private:
+    std::vector<std::atomic<float>> m_data;
+    size_t m_mask;
+    uint64_t m_start;                   // Pierwsza próbka zapisana po setCapacity()
+    std::atomic<int> m_pins;
+    // m_begin: koniec bloku, który pisarz właśnie zapisuje (ogłaszany przed zapisem),
+    // m_end: koniec bloku już zapisanego
+    alignas(64) std::atomic<uint64_t> m_begin;
+    alignas(64) std::atomic<uint64_t> m_end;
+
+    uint64_t oldestPosition(uint64_t end) const;
+    template <class T, class Convert>
+    void writeBlock(const T* samples, size_t count, Convert convert);
+    template <class T, class Convert>
+    size_t readBlock(Reader& reader, T* out, size_t maxSamples, Convert convert) const;
+};
+
+#endif // AUDIO_CAPTURE_RING_H
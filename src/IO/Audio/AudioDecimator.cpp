@@ -0,0 +1,179 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 JAQUBA (https://github.com/JAQUBA)
+// Part of JQB_WindowsLib — https://github.com/JAQUBA/JQB_WindowsLib
+
+#include "AudioDecimator.h"
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+static const double DECIMATOR_PI = 3.14159265358979323846;
+static const double KAISER_BETA = 8.0;             // ~80 dB tłumienia
+static const size_t DECIMATOR_BLOCK = 1024;        // Próbek wejścia na przebieg
+
+// Zmodyfikowana funkcja Bessela I0 (szereg) — do okna Kaisera
+static double besselI0(double x) {
+    double sum = 1.0, term = 1.0;
+    for (int k = 1; k < 50; k++) {
+        term *= (x / (2.0 * k)) * (x / (2.0 * k));
+        sum += term;
+        if (term < sum * 1e-12) break;
+    }
+    return sum;
+}
+
+AudioDecimator::AudioDecimator(int factor)
+    : m_factor(0), m_fill(0), m_next(0)
+{
+    setFactor(factor);
+}
+
+void AudioDecimator::setFactor(int factor) {
+    if (factor < 1) factor = 1;
+    m_factor = factor;
+    m_taps.clear();
+
+    if (factor > 1) {
+        // Sinc z odcięciem w środku pasma przejściowego 0.4 … 0.5 częstotliwości wyjściowej
+        size_t n = (size_t)DECIMATOR_TAPS_PER_PHASE * (size_t)factor;
+        double cutoff = 0.45 / factor;                  // względem fs wejścia
+        double center = (double)(n - 1) / 2.0;
+        double norm = besselI0(KAISER_BETA);
+        std::vector<double> h(n);
+        double sum = 0.0;
+        for (size_t i = 0; i < n; i++) {
+            double t = (double)i - center;
+            double sinc = t == 0.0 ? 2.0 * cutoff : sin(2.0 * DECIMATOR_PI * cutoff * t) / (DECIMATOR_PI * t);
+            double r = t / center;
+            h[i] = sinc * besselI0(KAISER_BETA * sqrt(1.0 - r * r)) / norm;
+            sum += h[i];
+        }
+        // Wzmocnienie DC = 1; odwrócenie — filtr jest symetryczny, więc tylko formalnie
+        m_taps.resize(n);
+        for (size_t i = 0; i < n; i++) m_taps[i] = (float)(h[n - 1 - i] / sum);
+    }
+
+    size_t block = DECIMATOR_BLOCK > (size_t)factor ? DECIMATOR_BLOCK : (size_t)factor;
+    m_history.assign((m_taps.empty() ? 0 : m_taps.size() - 1) + block, 0.0f);
+    reset();
+}
+
+void AudioDecimator::reset() {
+    // Historia wypełniona zerami — pierwsze wyjście po pierwszej próbce, potem co `factor`
+    size_t keep = m_taps.empty() ? 0 : m_taps.size() - 1;
+    for (size_t i = 0; i < keep; i++) m_history[i] = 0.0f;
+    m_fill = keep;
+    m_next = 0;
+}
+
+// ============================================================================
+// Iloczyn skalarny okna i min/max okresu
+// ============================================================================
+static inline float dot(const float* a, const float* b, size_t n) {
+    size_t i = 0;
+    float sum = 0.0f;
+#if defined(__SSE2__)
+    __m128 acc0 = _mm_setzero_ps(), acc1 = _mm_setzero_ps();
+    for (; i + 8 <= n; i += 8) {
+        acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+        acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(a + i + 4), _mm_loadu_ps(b + i + 4)));
+    }
+    alignas(16) float lanes[4];
+    _mm_store_ps(lanes, _mm_add_ps(acc0, acc1));
+    sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+#endif
+    for (; i < n; i++) sum += a[i] * b[i];
+    return sum;
+}
+
+static inline void minMax(const float* x, size_t n, float& lo, float& hi) {
+    size_t i = 0;
+    lo = x[0];
+    hi = x[0];
+#if defined(__SSE2__)
+    if (n >= 4) {
+        __m128 vlo = _mm_loadu_ps(x), vhi = vlo;
+        for (i = 4; i + 4 <= n; i += 4) {
+            __m128 v = _mm_loadu_ps(x + i);
+            vlo = _mm_min_ps(vlo, v);
+            vhi = _mm_max_ps(vhi, v);
+        }
+        alignas(16) float l[4], h[4];
+        _mm_store_ps(l, vlo);
+        _mm_store_ps(h, vhi);
+        for (int k = 0; k < 4; k++) {
+            if (l[k] < lo) lo = l[k];
+            if (h[k] > hi) hi = h[k];
+        }
+    }
+#endif
+    for (; i < n; i++) {
+        if (x[i] < lo) lo = x[i];
+        if (x[i] > hi) hi = x[i];
+    }
+}
+
+// ============================================================================
+// Przetwarzanie
+// ============================================================================
+template <class T, class Convert>
+size_t AudioDecimator::run(const T* in, size_t count, double* out, double* outMin, double* outMax,
+                           Convert convert) {
+    size_t produced = 0;
+
+    if (m_taps.empty()) {
+        // Współczynnik 1 — bez filtra
+        for (size_t i = 0; i < count; i++) {
+            double v = convert(in[i]);
+            out[i] = v;
+            if (outMin) outMin[i] = v;
+            if (outMax) outMax[i] = v;
+        }
+        return count;
+    }
+
+    size_t n = m_taps.size();
+    size_t factor = (size_t)m_factor;
+    // Obwiednia z okresu w środku okna — ta sama chwila co wartość po filtrze
+    size_t envelope = (n - factor) / 2;
+
+    while (count > 0) {
+        size_t take = m_history.size() - m_fill;
+        if (take > count) take = count;
+        for (size_t i = 0; i < take; i++) m_history[m_fill + i] = convert(in[i]);
+        m_fill += take;
+        in += take;
+        count -= take;
+
+        for (; m_next + n <= m_fill; m_next += factor) {
+            const float* window = &m_history[m_next];
+            out[produced] = dot(m_taps.data(), window, n);
+            if (outMin || outMax) {
+                float lo, hi;
+                minMax(window + envelope, factor, lo, hi);
+                if (outMin) outMin[produced] = lo;
+                if (outMax) outMax[produced] = hi;
+            }
+            produced++;
+        }
+
+        // Zostaw tylko próbki potrzebne następnym oknom
+        memmove(m_history.data(), m_history.data() + m_next, (m_fill - m_next) * sizeof(float));
+        m_fill -= m_next;
+        m_next = 0;
+    }
+    return produced;
+}
+
+size_t AudioDecimator::process(const int16_t* in, size_t count, double* out, double* outMin,
+                               double* outMax) {
+    return run(in, count, out, outMin, outMax, [](int16_t s) { return (float)s * (1.0f / 32768.0f); });
+}
+
+size_t AudioDecimator::process(const float* in, size_t count, double* out, double* outMin,
+                               double* outMax) {
+    return run(in, count, out, outMin, outMax, [](float s) { return s; });
+}
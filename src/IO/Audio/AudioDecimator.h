@@ -0,0 +1,60 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 JAQUBA (https://github.com/JAQUBA)
+// Part of JQB_WindowsLib — https://github.com/JAQUBA/JQB_WindowsLib
+
+/**
+ * AudioDecimator.h — anti-aliased decimation by any integer factor + min/max envelope
+ *
+ * Polyphase FIR decimator: only every factor-th output of a Kaiser-windowed
+ * sinc low-pass is computed (DECIMATOR_TAPS_PER_PHASE taps per input sample,
+ * SSE2 dot product). Passband to 0.4 × output rate (flat within ±0.001 dB),
+ * ≥ 60 dB at 0.5 × output rate and ≥ 85 dB from 0.55 × — content above the
+ * new Nyquist no longer folds into the display.
+ *
+ * The envelope outputs are the raw min/max of the input samples of each
+ * output period (aligned with the filter delay), so short peaks stay visible
+ * even though the filtered line cannot show them.
+ *
+ * Nie korzysta z WinAPI — działa na wątku audio bez alokacji po setFactor().
+ */
+
+#ifndef AUDIO_DECIMATOR_H
+#define AUDIO_DECIMATOR_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+#define DECIMATOR_TAPS_PER_PHASE  48
+
+class AudioDecimator {
+public:
+    explicit AudioDecimator(int factor = 1);
+
+    // Rebuilds the filter and clears history (allocates — not per buffer)
+    void setFactor(int factor);
+    int  getFactor() const { return m_factor; }
+    // Filter delay in input samples
+    int  getDelay() const { return (int)(m_taps.size() / 2); }
+    void reset();
+
+    // Input normalized to ±1.0 (int16 / 32768). Writes one output per
+    // `factor` inputs — up to count / factor + 1 values; outMin / outMax may
+    // be nullptr. Returns number of outputs written.
+    size_t process(const int16_t* in, size_t count, double* out, double* outMin = nullptr,
+                   double* outMax = nullptr);
+    size_t process(const float* in, size_t count, double* out, double* outMin = nullptr,
+                   double* outMax = nullptr);
+
+private:
+    int m_factor;
+    std::vector<float> m_taps;          // Odwrócone — iloczyn skalarny wprost na historii
+    std::vector<float> m_history;       // taps - 1 próbek z przeszłości + miejsce na blok wejścia
+    size_t m_fill;                      // Ważnych próbek w m_history
+    size_t m_next;                      // Początek okna następnego wyjścia
+
+    template <class T, class Convert>
+    size_t run(const T* in, size_t count, double* out, double* outMin, double* outMax, Convert convert);
+};
+
+#endif // AUDIO_DECIMATOR_H
@@ -3,146 +3,160 @@
 // Part of JQB_WindowsLib — https://github.com/JAQUBA/JQB_WindowsLib
 
 #include "AudioEngine.h"
-#include <cstring>
 
 // ============================================================================
 // Constructor / Destructor
 // ============================================================================
 AudioEngine::AudioEngine()
-    : m_hWaveOut(NULL)
-    , m_outputRunning(false)
-    , m_outputEvent(NULL)
-    , m_outputThread(NULL)
-    , m_hWaveIn(NULL)
-    , m_inputRunning(false)
-    , m_inputEvent(NULL)
-    , m_inputThread(NULL)
+    : m_backend(&m_defaultBackend)
+    , m_channels(AUDIO_CHANNELS)
+    , m_format(AUDIO_FORMAT_PCM16)
     , m_downsample(AUDIO_DOWNSAMPLE)
     , m_preferredRate(AUDIO_SAMPLE_RATE)
     , m_actualRate(AUDIO_SAMPLE_RATE)
-    , m_outputSnapshotCount(0)
-    , m_inputSnapshotCount(0)
-    , m_newOutputData(false)
-    , m_newInputData(false)
+    , m_numBuffers(AUDIO_NUM_BUFFERS)
+    , m_bufferSamples(AUDIO_BUFFER_SAMPLES)
+    , m_outNumBuffers(0)
+    , m_outBufferSamples(0)
+    , m_outChannels(AUDIO_CHANNELS)
+    , m_outFormat(AUDIO_FORMAT_PCM16)
+    , m_outputRunning(false)
+    , m_outWritten(0)
+    , m_inNumBuffers(0)
+    , m_inBufferSamples(0)
+    , m_inChannels(AUDIO_CHANNELS)
+    , m_inFormat(AUDIO_FORMAT_PCM16)
+    , m_inputRunning(false)
+    , m_inDelivered(0)
+    , m_outputSnapshot(AUDIO_SNAPSHOT_SIZE + 1, 3)
+    , m_inputSnapshot(AUDIO_SNAPSHOT_SIZE + 1, 3)
+    , m_captureCapacity(1 << 18)
 {
-    for (int i = 0; i < AUDIO_NUM_BUFFERS; i++) {
-        m_outBuffers[i] = nullptr;
-        m_inBuffers[i]  = nullptr;
-        ZeroMemory(&m_outHeaders[i], sizeof(WAVEHDR));
-        ZeroMemory(&m_inHeaders[i], sizeof(WAVEHDR));
+    // Pierścień kanału 0 od razu w pełnym rozmiarze (jak dotąd), pozostałe
+    // minimalne — startInput() nadaje rozmiar tylko używanym kanałom
+    for (int ch = 0; ch < AUDIO_MAX_CHANNELS; ch++) {
+        m_inputCapture[ch].reset(new AudioCaptureRing(ch == 0 ? m_captureCapacity : 64));
     }
-    ZeroMemory(m_outputSnapshot, sizeof(m_outputSnapshot));
-    ZeroMemory(m_inputSnapshot, sizeof(m_inputSnapshot));
-
-    InitializeCriticalSection(&m_csOutput);
-    InitializeCriticalSection(&m_csInput);
-    initFormat();
 }
 
 AudioEngine::~AudioEngine() {
     stopOutput();
     stopInput();
-    DeleteCriticalSection(&m_csOutput);
-    DeleteCriticalSection(&m_csInput);
 }
 
-void AudioEngine::initFormat() {
-    ZeroMemory(&m_wfx, sizeof(m_wfx));
-    m_wfx.wFormatTag      = WAVE_FORMAT_PCM;
-    m_wfx.nChannels        = AUDIO_CHANNELS;
-    m_wfx.nSamplesPerSec   = m_actualRate;
-    m_wfx.wBitsPerSample   = AUDIO_BITS;
-    m_wfx.nBlockAlign      = (AUDIO_CHANNELS * AUDIO_BITS) / 8;
-    m_wfx.nAvgBytesPerSec  = m_actualRate * m_wfx.nBlockAlign;
-    m_wfx.cbSize           = 0;
+bool AudioEngine::setBackend(AudioBackend* backend) {
+    if (m_outputRunning || m_inputRunning) return false;
+    m_backend = backend ? backend : &m_defaultBackend;
+    return true;
+}
+
+void AudioEngine::setChannels(int channels) {
+    if (channels < 1)                  channels = 1;
+    if (channels > AUDIO_MAX_CHANNELS) channels = AUDIO_MAX_CHANNELS;
+    m_channels = channels;
+}
+
+// ============================================================================
+// Buffer geometry
+// ============================================================================
+void AudioEngine::setBufferGeometry(int numBuffers, int bufferSamples) {
+    if (numBuffers < 2)         numBuffers = 2;
+    if (numBuffers > 64)        numBuffers = 64;
+    if (bufferSamples < 64)     bufferSamples = 64;
+    if (bufferSamples > 65536)  bufferSamples = 65536;
+    m_numBuffers    = numBuffers;
+    m_bufferSamples = bufferSamples;
+}
+
+void AudioEngine::setLatencyPreset(AudioLatencyPreset preset) {
+    switch (preset) {
+        case AUDIO_LATENCY_LOW:    setBufferGeometry(4, 256); break;
+        case AUDIO_LATENCY_ROBUST: setBufferGeometry(8, 4096); break;
+        default:                   setBufferGeometry(AUDIO_NUM_BUFFERS, AUDIO_BUFFER_SAMPLES); break;
+    }
+}
+
+double AudioEngine::getNominalLatencyMs() const {
+    return (double)m_numBuffers * m_bufferSamples * 1000.0 / m_actualRate;
+}
+
+double AudioEngine::getOutputLatencyMs() const {
+    if (!m_outputRunning) return 0.0;
+    uint32_t played;
+    if (!m_backend->getOutputPosition(played)) {
+        return (double)m_outNumBuffers * m_outBufferSamples * 1000.0 / m_actualRate;
+    }
+    uint32_t queued = m_outWritten.load(std::memory_order_relaxed) - played;
+    return queued * 1000.0 / m_actualRate;
+}
+
+double AudioEngine::getInputLatencyMs() const {
+    if (!m_inputRunning) return 0.0;
+    uint32_t recorded;
+    if (!m_backend->getInputPosition(recorded)) {
+        return m_inBufferSamples * 1000.0 / m_actualRate;
+    }
+    uint32_t pending = recorded - m_inDelivered.load(std::memory_order_relaxed);
+    // Więcej niż mieści kolejka to ramki utracone w przepełnieniu (urządzenie,
+    // którego pozycja biegnie dalej) — nie czekają na odbiór
+    uint32_t queue = (uint32_t)(m_inNumBuffers * m_inBufferSamples);
+    if (pending > queue) pending = queue;
+    return pending * 1000.0 / m_actualRate;
 }
 
 // ============================================================================
 // Device Enumeration
 // ============================================================================
 std::vector<std::string> AudioEngine::enumOutputDevices() {
-    std::vector<std::string> devices;
-    UINT count = waveOutGetNumDevs();
-    for (UINT i = 0; i < count; i++) {
-        WAVEOUTCAPSW caps;
-        if (waveOutGetDevCapsW(i, &caps, sizeof(caps)) == MMSYSERR_NOERROR) {
-            char name[128];
-            WideCharToMultiByte(CP_UTF8, 0, caps.szPname, -1, name, 128, NULL, NULL);
-            devices.push_back(name);
-        }
-    }
-    return devices;
+    return m_backend->enumOutputDevices();
 }
 
 std::vector<std::string> AudioEngine::enumInputDevices() {
-    std::vector<std::string> devices;
-    UINT count = waveInGetNumDevs();
-    for (UINT i = 0; i < count; i++) {
-        WAVEINCAPSW caps;
-        if (waveInGetDevCapsW(i, &caps, sizeof(caps)) == MMSYSERR_NOERROR) {
-            char name[128];
-            WideCharToMultiByte(CP_UTF8, 0, caps.szPname, -1, name, 128, NULL, NULL);
-            devices.push_back(name);
-        }
-    }
-    return devices;
+    return m_backend->enumInputDevices();
 }
 
 // ============================================================================
-// Output — waveOut
+// Output
 // ============================================================================
 bool AudioEngine::startOutput(int deviceIndex) {
     if (m_outputRunning) return false;
 
-    m_outputEvent = CreateEvent(NULL, FALSE, FALSE, NULL);
-    if (!m_outputEvent) return false;
-
-    // Try preferred rate, then fall back to lower rates
-    static const uint32_t fallbackRates[] = { 192000, 96000, 48000, 44100 };
-    bool opened = false;
-
-    // First try preferred rate
-    m_actualRate = m_preferredRate;
-    initFormat();
-    MMRESULT result = waveOutOpen(&m_hWaveOut, (UINT)deviceIndex, &m_wfx,
-                                   (DWORD_PTR)m_outputEvent, 0, CALLBACK_EVENT);
-    if (result == MMSYSERR_NOERROR) {
-        opened = true;
-    } else {
-        // Try fallback rates (descending)
-        for (int r = 0; r < 4; r++) {
-            if (fallbackRates[r] == m_preferredRate) continue;
-            m_actualRate = fallbackRates[r];
-            initFormat();
-            result = waveOutOpen(&m_hWaveOut, (UINT)deviceIndex, &m_wfx,
-                                  (DWORD_PTR)m_outputEvent, 0, CALLBACK_EVENT);
-            if (result == MMSYSERR_NOERROR) {
-                opened = true;
-                break;
-            }
-        }
+    // Backend próbuje preferowanej częstotliwości, potem zastępczych
+    AudioStreamConfig config;
+    config.channels     = m_channels;
+    config.format       = m_format;
+    config.sampleRate   = m_preferredRate;
+    config.numBuffers   = m_numBuffers;
+    config.bufferFrames = m_bufferSamples;
+    if (!m_backend->openOutput(deviceIndex, config)) return false;
+
+    // Geometria ustalona na czas działania
+    m_actualRate       = config.sampleRate;
+    m_outChannels      = config.channels;
+    m_outFormat        = config.format;
+    m_outNumBuffers    = config.numBuffers;
+    m_outBufferSamples = config.bufferFrames;
+    m_outPlanar.assign((size_t)m_outChannels * m_outBufferSamples, 0.0f);
+    m_outputSnapshot.resize(m_outBufferSamples + 1, 3 * m_outChannels);
+    // Filtry przygotowane przed startem wątku — bez alokacji przy pierwszym buforze
+    for (int ch = 0; ch < m_outChannels; ch++) m_outputDecimator[ch].setFactor(m_downsample);
+    m_outWritten = 0;
+
+    // Cała kolejka wypełniona przed startem wątku
+    for (int i = 0; i < m_outNumBuffers; i++) {
+        char* buffer = m_backend->waitOutputBuffer(0);
+        if (!buffer) break;
+        renderOutput(buffer);
+        m_backend->submitOutputBuffer(buffer);
+        m_outWritten += m_outBufferSamples;
     }
 
-    if (!opened) {
-        CloseHandle(m_outputEvent);
-        m_outputEvent = NULL;
+    m_outputRunning = true;
+    if (!m_outputThread.start(outputThreadProc, this)) {
+        m_outputRunning = false;
+        m_backend->closeOutput();
         return false;
     }
-
-    for (int i = 0; i < AUDIO_NUM_BUFFERS; i++) {
-        m_outBuffers[i] = new int16_t[AUDIO_BUFFER_SAMPLES];
-        ZeroMemory(&m_outHeaders[i], sizeof(WAVEHDR));
-        m_outHeaders[i].lpData         = (LPSTR)m_outBuffers[i];
-        m_outHeaders[i].dwBufferLength = AUDIO_BUFFER_SAMPLES * sizeof(int16_t);
-
-        waveOutPrepareHeader(m_hWaveOut, &m_outHeaders[i], sizeof(WAVEHDR));
-
-        m_waveGen.fillBuffer(m_outBuffers[i], AUDIO_BUFFER_SAMPLES, m_actualRate);
-        waveOutWrite(m_hWaveOut, &m_outHeaders[i], sizeof(WAVEHDR));
-    }
-
-    m_outputRunning = true;
-    m_outputThread = CreateThread(NULL, 0, outputThreadProc, this, 0, NULL);
     return true;
 }
 
@@ -150,116 +164,79 @@ void AudioEngine::stopOutput() {
     if (!m_outputRunning) return;
 
     m_outputRunning = false;
-    if (m_outputEvent) SetEvent(m_outputEvent);
+    m_backend->wakeOutput();
 
-    if (m_outputThread) {
-        WaitForSingleObject(m_outputThread, 2000);
-        CloseHandle(m_outputThread);
-        m_outputThread = NULL;
-    }
-
-    if (m_hWaveOut) {
-        waveOutReset(m_hWaveOut);
-        for (int i = 0; i < AUDIO_NUM_BUFFERS; i++) {
-            if (m_outBuffers[i]) {
-                waveOutUnprepareHeader(m_hWaveOut, &m_outHeaders[i], sizeof(WAVEHDR));
-                delete[] m_outBuffers[i];
-                m_outBuffers[i] = nullptr;
-            }
-        }
-        waveOutClose(m_hWaveOut);
-        m_hWaveOut = NULL;
-    }
+    m_outputThread.join();
 
-    if (m_outputEvent) {
-        CloseHandle(m_outputEvent);
-        m_outputEvent = NULL;
-    }
+    m_backend->closeOutput();
 }
 
-DWORD WINAPI AudioEngine::outputThreadProc(LPVOID param) {
+void AudioEngine::outputThreadProc(void* param) {
     AudioEngine* self = (AudioEngine*)param;
     while (self->m_outputRunning) {
-        WaitForSingleObject(self->m_outputEvent, 100);
+        // Najstarszy zwolniony bufor — backend oddaje je w kolejności kolejki
+        char* buffer = self->m_backend->waitOutputBuffer(100);
         if (!self->m_outputRunning) break;
+        if (buffer) self->refillOutputBuffer(buffer);
+    }
+}
 
-        for (int i = 0; i < AUDIO_NUM_BUFFERS; i++) {
-            if (self->m_outHeaders[i].dwFlags & WHDR_DONE) {
-                self->refillOutputBuffer(i);
-            }
-        }
+// Generatory kanałów → płaszczyzny float → przeplot w formacie urządzenia
+void AudioEngine::renderOutput(char* buffer) {
+    int frames = m_outBufferSamples;
+    float* planes[AUDIO_MAX_CHANNELS];
+    for (int ch = 0; ch < m_outChannels; ch++) {
+        planes[ch] = &m_outPlanar[(size_t)ch * frames];
+        m_waveGen[ch].fillBuffer(planes[ch], (uint32_t)frames, m_actualRate);
     }
-    return 0;
+    AudioFormat::interleave(planes, m_outChannels, (size_t)frames, m_outFormat, buffer);
 }
 
-void AudioEngine::refillOutputBuffer(int index) {
-    m_waveGen.fillBuffer(m_outBuffers[index], AUDIO_BUFFER_SAMPLES, m_actualRate);
+void AudioEngine::refillOutputBuffer(char* buffer) {
+    renderOutput(buffer);
 
-    int snapCount = AUDIO_BUFFER_SAMPLES / m_downsample;
-    EnterCriticalSection(&m_csOutput);
-    for (int i = 0; i < snapCount; i++) {
-        m_outputSnapshot[i] = m_outBuffers[index][i * m_downsample] / 32768.0;
-    }
-    m_outputSnapshotCount = snapCount;
-    m_newOutputData = true;
-    LeaveCriticalSection(&m_csOutput);
+    publishSnapshot(m_outputSnapshot, m_outputDecimator, m_outPlanar.data(), m_outBufferSamples,
+                    m_outChannels, m_outBufferSamples);
 
-    waveOutWrite(m_hWaveOut, &m_outHeaders[index], sizeof(WAVEHDR));
+    m_backend->submitOutputBuffer(buffer);
+    m_outWritten += m_outBufferSamples;
 }
 
 // ============================================================================
-// Input — waveIn
+// Input
 // ============================================================================
 bool AudioEngine::startInput(int deviceIndex) {
     if (m_inputRunning) return false;
 
-    m_inputEvent = CreateEvent(NULL, FALSE, FALSE, NULL);
-    if (!m_inputEvent) return false;
-
-    // Try the same rate that output negotiated, then fall back
-    static const uint32_t fallbackRates[] = { 192000, 96000, 48000, 44100 };
-    bool opened = false;
-    uint32_t tryRate = m_actualRate;  // start with output's actual rate
-
-    initFormat();  // m_actualRate already set from output
-    MMRESULT result = waveInOpen(&m_hWaveIn, (UINT)deviceIndex, &m_wfx,
-                                  (DWORD_PTR)m_inputEvent, 0, CALLBACK_EVENT);
-    if (result == MMSYSERR_NOERROR) {
-        opened = true;
-    } else {
-        for (int r = 0; r < 4; r++) {
-            if (fallbackRates[r] == tryRate) continue;
-            m_actualRate = fallbackRates[r];
-            initFormat();
-            result = waveInOpen(&m_hWaveIn, (UINT)deviceIndex, &m_wfx,
-                                 (DWORD_PTR)m_inputEvent, 0, CALLBACK_EVENT);
-            if (result == MMSYSERR_NOERROR) {
-                opened = true;
-                break;
-            }
-        }
-    }
+    // Najpierw częstotliwość wynegocjowana przez wyjście, potem zastępcze
+    AudioStreamConfig config;
+    config.channels     = m_channels;
+    config.format       = m_format;
+    config.sampleRate   = m_actualRate;
+    config.numBuffers   = m_numBuffers;
+    config.bufferFrames = m_bufferSamples;
+    if (!m_backend->openInput(deviceIndex, config)) return false;
+
+    // Inna tylko po zastępczej częstotliwości — wątek wyjścia czyta m_actualRate
+    if (config.sampleRate != m_actualRate) m_actualRate = config.sampleRate;
+    m_inChannels      = config.channels;
+    m_inFormat        = config.format;
+    m_inNumBuffers    = config.numBuffers;
+    m_inBufferSamples = config.bufferFrames;
+    // Pierścień przypięty przez wątek konsumenta nie jest realokowany (rozmiar przy następnym starcie)
+    for (int ch = 0; ch < m_inChannels; ch++) m_inputCapture[ch]->setCapacity(m_captureCapacity);
+    m_inPlanar.assign((size_t)m_inChannels * m_inBufferSamples, 0.0f);
+    m_inputSnapshot.resize(m_inBufferSamples + 1, 3 * m_inChannels);
+    // Filtry przygotowane przed startem wątku — bez alokacji przy pierwszym buforze
+    for (int ch = 0; ch < m_inChannels; ch++) m_inputDecimator[ch].setFactor(m_downsample);
+    m_inDelivered = 0;
 
-    if (!opened) {
-        CloseHandle(m_inputEvent);
-        m_inputEvent = NULL;
+    m_inputRunning = true;
+    if (!m_inputThread.start(inputThreadProc, this)) {
+        m_inputRunning = false;
+        m_backend->closeInput();
         return false;
     }
-
-    for (int i = 0; i < AUDIO_NUM_BUFFERS; i++) {
-        m_inBuffers[i] = new int16_t[AUDIO_BUFFER_SAMPLES];
-        ZeroMemory(&m_inHeaders[i], sizeof(WAVEHDR));
-        m_inHeaders[i].lpData         = (LPSTR)m_inBuffers[i];
-        m_inHeaders[i].dwBufferLength = AUDIO_BUFFER_SAMPLES * sizeof(int16_t);
-
-        waveInPrepareHeader(m_hWaveIn, &m_inHeaders[i], sizeof(WAVEHDR));
-        waveInAddBuffer(m_hWaveIn, &m_inHeaders[i], sizeof(WAVEHDR));
-    }
-
-    waveInStart(m_hWaveIn);
-
-    m_inputRunning = true;
-    m_inputThread = CreateThread(NULL, 0, inputThreadProc, this, 0, NULL);
     return true;
 }
 
@@ -267,91 +244,91 @@ void AudioEngine::stopInput() {
     if (!m_inputRunning) return;
 
     m_inputRunning = false;
-    if (m_inputEvent) SetEvent(m_inputEvent);
+    m_backend->wakeInput();
 
-    if (m_inputThread) {
-        WaitForSingleObject(m_inputThread, 2000);
-        CloseHandle(m_inputThread);
-        m_inputThread = NULL;
-    }
-
-    if (m_hWaveIn) {
-        waveInStop(m_hWaveIn);
-        waveInReset(m_hWaveIn);
-        for (int i = 0; i < AUDIO_NUM_BUFFERS; i++) {
-            if (m_inBuffers[i]) {
-                waveInUnprepareHeader(m_hWaveIn, &m_inHeaders[i], sizeof(WAVEHDR));
-                delete[] m_inBuffers[i];
-                m_inBuffers[i] = nullptr;
-            }
-        }
-        waveInClose(m_hWaveIn);
-        m_hWaveIn = NULL;
-    }
+    m_inputThread.join();
 
-    if (m_inputEvent) {
-        CloseHandle(m_inputEvent);
-        m_inputEvent = NULL;
-    }
+    m_backend->closeInput();
 }
 
-DWORD WINAPI AudioEngine::inputThreadProc(LPVOID param) {
+void AudioEngine::inputThreadProc(void* param) {
     AudioEngine* self = (AudioEngine*)param;
     while (self->m_inputRunning) {
-        WaitForSingleObject(self->m_inputEvent, 100);
+        // W kolejności nagrania — strumień AudioCaptureRing musi być ciągły
+        int frames = 0;
+        const char* data = self->m_backend->waitInputBuffer(100, frames);
         if (!self->m_inputRunning) break;
-
-        for (int i = 0; i < AUDIO_NUM_BUFFERS; i++) {
-            if (self->m_inHeaders[i].dwFlags & WHDR_DONE) {
-                self->processInputBuffer(i);
-            }
-        }
+        if (!data) continue;
+        self->processInputBuffer(data, frames);
+        self->m_backend->releaseInputBuffer();
     }
-    return 0;
 }
 
-void AudioEngine::processInputBuffer(int index) {
-    int snapCount = AUDIO_BUFFER_SAMPLES / m_downsample;
-    EnterCriticalSection(&m_csInput);
-    for (int i = 0; i < snapCount; i++) {
-        m_inputSnapshot[i] = m_inBuffers[index][i * m_downsample] / 32768.0;
-    }
-    m_inputSnapshotCount = snapCount;
-    m_newInputData = true;
-    LeaveCriticalSection(&m_csInput);
+void AudioEngine::processInputBuffer(const char* data, int frames) {
+    float* planes[AUDIO_MAX_CHANNELS];
+    for (int ch = 0; ch < m_inChannels; ch++) planes[ch] = &m_inPlanar[(size_t)ch * m_inBufferSamples];
+    AudioFormat::deinterleave(data, m_inChannels, (size_t)frames, m_inFormat, planes);
+
+    // Pełny strumień — każda nagrana próbka, zanim bufor wróci do urządzenia
+    for (int ch = 0; ch < m_inChannels; ch++) m_inputCapture[ch]->write(planes[ch], (size_t)frames);
+    m_inDelivered += (uint32_t)frames;
 
-    waveInAddBuffer(m_hWaveIn, &m_inHeaders[index], sizeof(WAVEHDR));
+    publishSnapshot(m_inputSnapshot, m_inputDecimator, m_inPlanar.data(), m_inBufferSamples,
+                    m_inChannels, frames);
 }
 
 // ============================================================================
-// Thread-safe snapshot access
+// Snapshot access — wait-free (AudioSnapshot), the UI never blocks the audio threads
 // ============================================================================
-bool AudioEngine::getOutputSnapshot(double* buffer, int maxSamples, int& outCount) {
-    EnterCriticalSection(&m_csOutput);
-    if (!m_newOutputData) {
-        LeaveCriticalSection(&m_csOutput);
-        return false;
+// Wywoływane na wątku audio: filtr decymujący + obwiednia min/max, wszystkie
+// kanały w jednym slocie (płaszczyzna kanał * 3 + 0/1/2); kanały wejścia co stride próbek
+void AudioEngine::publishSnapshot(AudioSnapshot& snapshot, AudioDecimator* decimators,
+                                  const float* planar, int stride, int channels, int frames) {
+    int factor = m_downsample;
+    int snapCount = 0;
+    for (int ch = 0; ch < channels; ch++) {
+        AudioDecimator& decimator = decimators[ch];
+        if (factor != decimator.getFactor()) decimator.setFactor(factor);
+        // Ten sam współczynnik i stan — ta sama liczba wyjść w każdym kanale
+        snapCount = (int)decimator.process(planar + (size_t)ch * stride, (size_t)frames,
+                                           snapshot.beginWrite(3 * ch), snapshot.beginWrite(3 * ch + 1),
+                                           snapshot.beginWrite(3 * ch + 2));
     }
-    int count = m_outputSnapshotCount;
-    if (count > maxSamples) count = maxSamples;
-    memcpy(buffer, m_outputSnapshot, count * sizeof(double));
-    outCount = count;
-    m_newOutputData = false;
-    LeaveCriticalSection(&m_csOutput);
-    return true;
+    snapshot.publish(snapCount);
+}
+
+bool AudioEngine::getOutputSnapshot(double* buffer, int maxSamples, int& outCount) {
+    return m_outputSnapshot.read(buffer, maxSamples, outCount);
 }
 
 bool AudioEngine::getInputSnapshot(double* buffer, int maxSamples, int& outCount) {
-    EnterCriticalSection(&m_csInput);
-    if (!m_newInputData) {
-        LeaveCriticalSection(&m_csInput);
-        return false;
-    }
-    int count = m_inputSnapshotCount;
-    if (count > maxSamples) count = maxSamples;
-    memcpy(buffer, m_inputSnapshot, count * sizeof(double));
-    outCount = count;
-    m_newInputData = false;
-    LeaveCriticalSection(&m_csInput);
-    return true;
+    return m_inputSnapshot.read(buffer, maxSamples, outCount);
+}
+
+bool AudioEngine::borrowOutputEnvelope(const double*& data, const double*& minData, const double*& maxData,
+                                       int& count) {
+    bool fresh = m_outputSnapshot.borrow(data, count);
+    minData = m_outputSnapshot.borrowed(1);
+    maxData = m_outputSnapshot.borrowed(2);
+    return fresh;
+}
+
+bool AudioEngine::borrowInputEnvelope(const double*& data, const double*& minData, const double*& maxData,
+                                      int& count) {
+    bool fresh = m_inputSnapshot.borrow(data, count);
+    minData = m_inputSnapshot.borrowed(1);
+    maxData = m_inputSnapshot.borrowed(2);
+    return fresh;
+}
+
+const double* AudioEngine::borrowedOutputChannel(int channel, int plane) const {
+    int index = 3 * channel + plane;
+    if (channel < 0 || plane < 0 || plane > 2 || index >= m_outputSnapshot.planes()) return nullptr;
+    return m_outputSnapshot.borrowed(index);
+}
+
+const double* AudioEngine::borrowedInputChannel(int channel, int plane) const {
+    int index = 3 * channel + plane;
+    if (channel < 0 || plane < 0 || plane > 2 || index >= m_inputSnapshot.planes()) return nullptr;
+    return m_inputSnapshot.borrowed(index);
 }
@@ -5,96 +5,197 @@
 #ifndef AUDIO_ENGINE_H
 #define AUDIO_ENGINE_H
 
-#include <windows.h>
-#include <mmsystem.h>
 #include <vector>
 #include <string>
 #include <cstdint>
 #include "WaveGen.h"
+#include "AudioSnapshot.h"
+#include "AudioCaptureRing.h"
+#include "AudioDecimator.h"
+#include "AudioFormat.h"
+#include "AudioBackend.h"
+#include "AudioThread.h"
+#include <atomic>
+#include <memory>
+
+// Backend wbudowany (setBackend(nullptr)); poza Windows — bez urządzenia
+#ifdef _WIN32
+#include "AudioWinMMBackend.h"
+typedef AudioWinMMBackend AudioDefaultBackend;
+#else
+#include "AudioNullBackend.h"
+typedef AudioNullBackend AudioDefaultBackend;
+#endif
 
 #define AUDIO_SAMPLE_RATE     48000
-#define AUDIO_CHANNELS        1
+#define AUDIO_CHANNELS        1       // Domyślny format — setChannels() / setSampleFormat()
 #define AUDIO_BITS            16
-#define AUDIO_BUFFER_SAMPLES  4096
+#define AUDIO_BUFFER_SAMPLES  4096    // Domyślna geometria — setBufferGeometry() w trakcie działania
 #define AUDIO_NUM_BUFFERS     3
 #define AUDIO_DOWNSAMPLE      8
-#define AUDIO_SNAPSHOT_SIZE   AUDIO_BUFFER_SAMPLES
+#define AUDIO_SNAPSHOT_SIZE   AUDIO_BUFFER_SAMPLES  // Dla domyślnej geometrii — ogólnie getSnapshotSize()
+
+// Buffer geometry presets (count × samples per buffer)
+enum AudioLatencyPreset {
+    AUDIO_LATENCY_LOW = 0,      // 4 × 256  — ~21 ms at 48 kHz, needs a responsive system
+    AUDIO_LATENCY_BALANCED,     // 3 × 4096 — default (AUDIO_NUM_BUFFERS × AUDIO_BUFFER_SAMPLES)
+    AUDIO_LATENCY_ROBUST        // 8 × 4096 — ~680 ms at 48 kHz, survives long stalls
+};
 
 class AudioEngine {
 public:
     AudioEngine();
     ~AudioEngine();
 
-    // Device enumeration
+    // Device backend — nullptr restores the built-in one: waveOut/waveIn on
+    // Windows, AudioNullBackend (real-time clock, silence) elsewhere.
+    // Not owned; only while both directions are stopped (returns false otherwise).
+    // AudioNullBackend / AudioLoopbackBackend run without an audio device.
+    bool setBackend(AudioBackend* backend);
+    AudioBackend& getBackend() { return *m_backend; }
+
+    // Device enumeration (of the current backend)
     std::vector<std::string> enumOutputDevices();
     std::vector<std::string> enumInputDevices();
 
-    // Output (waveOut)
+    // Output
     bool startOutput(int deviceIndex);
     void stopOutput();
     bool isOutputRunning() const { return m_outputRunning; }
 
-    // Input (waveIn)
+    // Input
     bool startInput(int deviceIndex);
     void stopInput();
     bool isInputRunning() const { return m_inputRunning; }
 
-    // Waveform generator access
-    WaveGen& getWaveGen() { return m_waveGen; }
-
-    // Thread-safe snapshot access for UI/chart rendering
+    // Waveform generator access — one generator per output channel
+    WaveGen& getWaveGen(int channel = 0) { return m_waveGen[clampChannel(channel)]; }
+
+    // Stream format — applied by the next startOutput()/startInput(); a running
+    // direction keeps the format it was started with. Channels 1..AUDIO_MAX_CHANNELS;
+    // waveOut/waveIn open anything but mono/stereo PCM16 as WAVE_FORMAT_EXTENSIBLE.
+    void setChannels(int channels);
+    void setSampleFormat(AudioSampleFormat format) { m_format = format; }
+    int  getChannels() const                       { return m_channels; }
+    AudioSampleFormat getSampleFormat() const      { return m_format; }
+    // Channel count / format of the running (or last started) stream
+    int  getOutputChannels() const { return m_outChannels; }
+    int  getInputChannels()  const { return m_inChannels; }
+    AudioSampleFormat getOutputSampleFormat() const { return m_outFormat; }
+    AudioSampleFormat getInputSampleFormat()  const { return m_inFormat; }
+
+    // Thread-safe snapshot access for UI/chart rendering (one reader thread).
+    // Wait-free triple buffer — the audio threads never block on the UI.
     // Returns true if new data was available (resets flag)
     bool getOutputSnapshot(double* buffer, int maxSamples, int& outCount);
     bool getInputSnapshot(double* buffer, int maxSamples, int& outCount);
-
-    // Configuration
-    void setDownsampleFactor(int factor) { m_downsample = factor; }
+    // Zero-copy: pointer to the latest snapshot, valid until the next
+    // get/borrow call for the same direction. Returns true if it is new.
+    bool borrowOutputSnapshot(const double*& data, int& count) { return m_outputSnapshot.borrow(data, count); }
+    bool borrowInputSnapshot(const double*& data, int& count)  { return m_inputSnapshot.borrow(data, count); }
+    // Snapshot with its min/max envelope (raw peaks of each decimated period)
+    bool borrowOutputEnvelope(const double*& data, const double*& minData, const double*& maxData, int& count);
+    bool borrowInputEnvelope(const double*& data, const double*& minData, const double*& maxData, int& count);
+    // Any channel of the snapshot returned by the last get/borrow call for the
+    // same direction — all channels of a buffer are published together, so
+    // they are always time-aligned. plane: 0 value, 1 min, 2 max. nullptr if
+    // the stream has fewer channels.
+    const double* borrowedOutputChannel(int channel, int plane = 0) const;
+    const double* borrowedInputChannel(int channel, int plane = 0) const;
+
+    // Full-rate input stream — every captured sample in order, for any number
+    // of consumers (each with its own AudioCaptureRing::Reader). One ring per
+    // channel (0..AUDIO_MAX_CHANNELS-1); equal positions = the same frame while
+    // the channel count stays the same. Survives stop/start; numbering continues.
+    AudioCaptureRing& getInputCapture(int channel = 0) { return *m_inputCapture[clampChannel(channel)]; }
+    // Ring size in samples (power of two, default 2^18) — applied by the next
+    // startInput(), not while input is running. A ring pinned by a consumer
+    // thread (running AudioMeter / AudioRecorder) keeps its size until a later
+    // start; other reader threads must not read across startInput().
+    void setCaptureCapacity(size_t samples) { m_captureCapacity = samples; }
+
+    // Configuration — any integer factor; snapshots go through an anti-aliasing
+    // decimation filter on the audio thread (AudioDecimator)
+    void setDownsampleFactor(int factor) { m_downsample = factor < 1 ? 1 : factor; }
     int  getDownsampleFactor() const     { return m_downsample; }
-    int  getSnapshotSize()     const     { return AUDIO_BUFFER_SAMPLES / m_downsample; }
+    int  getSnapshotSize()     const     { return (m_bufferSamples + m_downsample - 1) / m_downsample; }
 
     // Sample rate: set preferred rate, actual may differ after negotiation
     void setSampleRate(uint32_t rate) { m_preferredRate = rate; }
     uint32_t getActualSampleRate() const { return m_actualRate; }
 
+    // Buffer geometry — applied by the next startOutput()/startInput(); a running
+    // direction keeps the geometry it was started with. Count 2..64, samples 64..65536.
+    void setBufferGeometry(int numBuffers, int bufferSamples);
+    void setLatencyPreset(AudioLatencyPreset preset);
+    int  getNumBuffers()    const { return m_numBuffers; }
+    int  getBufferSamples() const { return m_bufferSamples; }
+    // Queue length of the configured geometry: numBuffers × bufferSamples / rate
+    double getNominalLatencyMs() const;
+
+    // Measured: samples queued but not yet played / recorded but not yet
+    // delivered (device position vs. buffers handed over), in ms. 0 when stopped.
+    double getOutputLatencyMs() const;
+    double getInputLatencyMs()  const;
+    // Output queue ran dry (every buffer returned before a refill) / input had
+    // no free buffer to record into. Counted per episode, reset by start.
+    uint32_t getOutputUnderruns() const { return m_backend->getOutputUnderruns(); }
+    uint32_t getInputOverruns()   const { return m_backend->getInputOverruns(); }
+
 private:
-    WaveGen m_waveGen;
-    WAVEFORMATEX m_wfx;
-    int m_downsample;
+    WaveGen m_waveGen[AUDIO_MAX_CHANNELS];
+    AudioDefaultBackend m_defaultBackend;
+    AudioBackend* m_backend;            // m_defaultBackend albo backend użytkownika
+    int      m_channels;                // Konfiguracja dla następnego startu
+    AudioSampleFormat m_format;
+    std::atomic<int> m_downsample;
     uint32_t m_preferredRate;
     uint32_t m_actualRate;
+    int      m_numBuffers;          // Konfiguracja dla następnego startu
+    int      m_bufferSamples;
 
     // --- Output ---
-    HWAVEOUT m_hWaveOut;
-    WAVEHDR  m_outHeaders[AUDIO_NUM_BUFFERS];
-    int16_t* m_outBuffers[AUDIO_NUM_BUFFERS];
-    volatile bool m_outputRunning;
-    HANDLE   m_outputEvent;
-    HANDLE   m_outputThread;
+    std::vector<float>   m_outPlanar;   // Kanał po kanale, float ±1.0
+    int      m_outNumBuffers;           // Geometria z chwili startOutput()
+    int      m_outBufferSamples;        // Ramek na bufor
+    int      m_outChannels;
+    AudioSampleFormat m_outFormat;
+    std::atomic<bool> m_outputRunning;
+    AudioThread m_outputThread;
+    std::atomic<uint32_t> m_outWritten;     // Próbek przekazanych backendowi (modulo 2^32)
 
     // --- Input ---
-    HWAVEIN  m_hWaveIn;
-    WAVEHDR  m_inHeaders[AUDIO_NUM_BUFFERS];
-    int16_t* m_inBuffers[AUDIO_NUM_BUFFERS];
-    volatile bool m_inputRunning;
-    HANDLE   m_inputEvent;
-    HANDLE   m_inputThread;
+    std::vector<float>   m_inPlanar;
+    int      m_inNumBuffers;            // Geometria z chwili startInput()
+    int      m_inBufferSamples;
+    int      m_inChannels;
+    AudioSampleFormat m_inFormat;
+    std::atomic<bool> m_inputRunning;
+    AudioThread m_inputThread;
+    std::atomic<uint32_t> m_inDelivered;    // Próbek odebranych z bufora (modulo 2^32)
 
     // --- Snapshot data (downsampled for charts) ---
-    CRITICAL_SECTION m_csOutput;
-    CRITICAL_SECTION m_csInput;
-    double   m_outputSnapshot[AUDIO_SNAPSHOT_SIZE];
-    double   m_inputSnapshot[AUDIO_SNAPSHOT_SIZE];
-    int      m_outputSnapshotCount;
-    int      m_inputSnapshotCount;
-    bool     m_newOutputData;
-    bool     m_newInputData;
-
-    void initFormat();
-    void refillOutputBuffer(int index);
-    void processInputBuffer(int index);
-
-    static DWORD WINAPI outputThreadProc(LPVOID param);
-    static DWORD WINAPI inputThreadProc(LPVOID param);
+    AudioSnapshot m_outputSnapshot;     // Płaszczyzny: kanał * 3 + (wartość, min, max)
+    AudioSnapshot m_inputSnapshot;
+    AudioDecimator m_outputDecimator[AUDIO_MAX_CHANNELS];  // Tylko wątek wyjścia
+    AudioDecimator m_inputDecimator[AUDIO_MAX_CHANNELS];   // Tylko wątek wejścia
+
+    // --- Full-rate capture ---
+    std::unique_ptr<AudioCaptureRing> m_inputCapture[AUDIO_MAX_CHANNELS];
+    size_t   m_captureCapacity;
+
+    // Indeks kanału w zakresie 0..AUDIO_MAX_CHANNELS-1 (jak setChannels())
+    static int clampChannel(int channel) {
+        return channel < 0 ? 0 : (channel >= AUDIO_MAX_CHANNELS ? AUDIO_MAX_CHANNELS - 1 : channel);
+    }
+    void renderOutput(char* buffer);
+    void refillOutputBuffer(char* buffer);
+    void processInputBuffer(const char* data, int frames);
+    void publishSnapshot(AudioSnapshot& snapshot, AudioDecimator* decimators, const float* planar,
+                         int stride, int channels, int frames);
+
+    static void outputThreadProc(void* param);
+    static void inputThreadProc(void* param);
 };
 
 #endif // AUDIO_ENGINE_H
@@ -0,0 +1,208 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 JAQUBA (https://github.com/JAQUBA)
+// Part of JQB_WindowsLib — https://github.com/JAQUBA/JQB_WindowsLib
+
+#include "AudioFormat.h"
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace AudioFormat {
+
+int sampleBytes(AudioSampleFormat format) {
+    switch (format) {
+        case AUDIO_FORMAT_PCM24:   return 3;
+        case AUDIO_FORMAT_FLOAT32: return 4;
+        default:                   return 2;
+    }
+}
+
+int bitsPerSample(AudioSampleFormat format) {
+    return sampleBytes(format) * 8;
+}
+
+// ============================================================================
+// Konwersja pojedynczej próbki (pętle skalarne i końcówki bloków)
+// ============================================================================
+// Skala wyjścia: ±1.0 → ±32767 (bez przesterowania); odwrotność wejścia: ×32768
+struct Scale {
+    float pcm16, pcm24, limit;
+    explicit Scale(bool exactInverse)
+        : pcm16(exactInverse ? 32768.0f : 32767.0f)
+        , pcm24(exactInverse ? 8388608.0f : 8388607.0f)
+        , limit(exactInverse ? FLT_MAX : 1.0f) {}
+};
+
+static inline int16_t toPcm16(float x, const Scale& s) {
+    float v = fminf(fmaxf(x * s.pcm16, -32768.0f), 32767.0f);
+    return (int16_t)lrintf(v);
+}
+
+static inline int32_t toPcm24(float x, const Scale& s) {
+    float v = fminf(fmaxf(x * s.pcm24, -8388608.0f), 8388607.0f);
+    return (int32_t)lrintf(v);
+}
+
+static inline float clampUnit(float x, const Scale& s) {
+    return fminf(fmaxf(x, -s.limit), s.limit);
+}
+
+static inline void storePcm24(uint8_t* p, int32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+}
+
+static inline float loadPcm24(const uint8_t* p) {
+    // Bajt najstarszy na górę int32, przesunięcie arytmetyczne rozszerza znak
+    int32_t v = (int32_t)((uint32_t)p[0] << 8 | (uint32_t)p[1] << 16 | (uint32_t)p[2] << 24) >> 8;
+    return (float)v * (1.0f / 8388608.0f);
+}
+
+static void interleaveScalar(const float* const* planes, int channels, size_t from, size_t frames,
+                             AudioSampleFormat format, void* out, const Scale& s) {
+    for (int ch = 0; ch < channels; ch++) {
+        const float* src = planes[ch];
+        switch (format) {
+            case AUDIO_FORMAT_PCM24: {
+                uint8_t* dst = (uint8_t*)out + ch * 3;
+                for (size_t f = from; f < frames; f++) storePcm24(dst + f * channels * 3, toPcm24(src[f], s));
+                break;
+            }
+            case AUDIO_FORMAT_FLOAT32: {
+                float* dst = (float*)out + ch;
+                for (size_t f = from; f < frames; f++) dst[f * channels] = clampUnit(src[f], s);
+                break;
+            }
+            default: {
+                int16_t* dst = (int16_t*)out + ch;
+                for (size_t f = from; f < frames; f++) dst[f * channels] = toPcm16(src[f], s);
+                break;
+            }
+        }
+    }
+}
+
+static void deinterleaveScalar(const void* in, int channels, size_t from, size_t frames,
+                               AudioSampleFormat format, float* const* planes) {
+    for (int ch = 0; ch < channels; ch++) {
+        float* dst = planes[ch];
+        switch (format) {
+            case AUDIO_FORMAT_PCM24: {
+                const uint8_t* src = (const uint8_t*)in + ch * 3;
+                for (size_t f = from; f < frames; f++) dst[f] = loadPcm24(src + f * channels * 3);
+                break;
+            }
+            case AUDIO_FORMAT_FLOAT32: {
+                const float* src = (const float*)in + ch;
+                for (size_t f = from; f < frames; f++) dst[f] = src[f * channels];
+                break;
+            }
+            default: {
+                const int16_t* src = (const int16_t*)in + ch;
+                for (size_t f = from; f < frames; f++) dst[f] = src[f * channels] * (1.0f / 32768.0f);
+                break;
+            }
+        }
+    }
+}
+
+// ============================================================================
+// Płaszczyzny → przeplot
+// ============================================================================
+void interleave(const float* const* planes, int channels, size_t frames,
+                AudioSampleFormat format, void* out, bool exactInverse) {
+    Scale s(exactInverse);
+    size_t f = 0;
+#if defined(__SSE2__)
+    if (format == AUDIO_FORMAT_PCM16 && (channels == 1 || channels == 2)) {
+        __m128 g = _mm_set1_ps(s.pcm16);
+        __m128 lo = _mm_set1_ps(-32768.0f), hi = _mm_set1_ps(32767.0f);
+        int16_t* dst = (int16_t*)out;
+        const float* l = planes[0];
+        const float* r = planes[channels - 1];
+        for (; f + 8 <= frames; f += 8) {
+            __m128 a = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(l + f), g), lo), hi);
+            __m128 b = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(l + f + 4), g), lo), hi);
+            __m128i left = _mm_packs_epi32(_mm_cvtps_epi32(a), _mm_cvtps_epi32(b));
+            if (channels == 1) {
+                _mm_storeu_si128((__m128i*)(dst + f), left);
+                continue;
+            }
+            a = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(r + f), g), lo), hi);
+            b = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(r + f + 4), g), lo), hi);
+            __m128i right = _mm_packs_epi32(_mm_cvtps_epi32(a), _mm_cvtps_epi32(b));
+            _mm_storeu_si128((__m128i*)(dst + 2 * f), _mm_unpacklo_epi16(left, right));
+            _mm_storeu_si128((__m128i*)(dst + 2 * f + 8), _mm_unpackhi_epi16(left, right));
+        }
+    } else if (format == AUDIO_FORMAT_FLOAT32 && (channels == 1 || channels == 2)) {
+        __m128 lo = _mm_set1_ps(-s.limit), hi = _mm_set1_ps(s.limit);
+        float* dst = (float*)out;
+        const float* l = planes[0];
+        const float* r = planes[channels - 1];
+        for (; f + 4 <= frames; f += 4) {
+            __m128 left = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(l + f), lo), hi);
+            if (channels == 1) {
+                _mm_storeu_ps(dst + f, left);
+                continue;
+            }
+            __m128 right = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(r + f), lo), hi);
+            _mm_storeu_ps(dst + 2 * f, _mm_unpacklo_ps(left, right));
+            _mm_storeu_ps(dst + 2 * f + 4, _mm_unpackhi_ps(left, right));
+        }
+    }
+#endif
+    interleaveScalar(planes, channels, f, frames, format, out, s);
+}
+
+// ============================================================================
+// Przeplot → płaszczyzny
+// ============================================================================
+void deinterleave(const void* in, int channels, size_t frames,
+                  AudioSampleFormat format, float* const* planes) {
+    size_t f = 0;
+#if defined(__SSE2__)
+    if (format == AUDIO_FORMAT_PCM16 && channels == 1) {
+        const int16_t* src = (const int16_t*)in;
+        __m128 scale = _mm_set1_ps(1.0f / 32768.0f);
+        for (; f + 8 <= frames; f += 8) {
+            __m128i x = _mm_loadu_si128((const __m128i*)(src + f));
+            // Próbka w górnej połowie int32, przesunięcie arytmetyczne rozszerza znak
+            __m128i a = _mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16);
+            __m128i b = _mm_srai_epi32(_mm_unpackhi_epi16(x, x), 16);
+            _mm_storeu_ps(planes[0] + f, _mm_mul_ps(_mm_cvtepi32_ps(a), scale));
+            _mm_storeu_ps(planes[0] + f + 4, _mm_mul_ps(_mm_cvtepi32_ps(b), scale));
+        }
+    } else if (format == AUDIO_FORMAT_PCM16 && channels == 2) {
+        const int16_t* src = (const int16_t*)in;
+        __m128 scale = _mm_set1_ps(1.0f / 32768.0f);
+        for (; f + 4 <= frames; f += 4) {
+            // Każdy int32 to jedna ramka: L w dolnej połowie, R w górnej
+            __m128i x = _mm_loadu_si128((const __m128i*)(src + 2 * f));
+            __m128i left  = _mm_srai_epi32(_mm_slli_epi32(x, 16), 16);
+            __m128i right = _mm_srai_epi32(x, 16);
+            _mm_storeu_ps(planes[0] + f, _mm_mul_ps(_mm_cvtepi32_ps(left), scale));
+            _mm_storeu_ps(planes[1] + f, _mm_mul_ps(_mm_cvtepi32_ps(right), scale));
+        }
+    } else if (format == AUDIO_FORMAT_FLOAT32 && channels == 1) {
+        memcpy(planes[0], in, frames * sizeof(float));
+        f = frames;
+    } else if (format == AUDIO_FORMAT_FLOAT32 && channels == 2) {
+        const float* src = (const float*)in;
+        for (; f + 4 <= frames; f += 4) {
+            __m128 a = _mm_loadu_ps(src + 2 * f);       // L0 R0 L1 R1
+            __m128 b = _mm_loadu_ps(src + 2 * f + 4);   // L2 R2 L3 R3
+            _mm_storeu_ps(planes[0] + f, _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+            _mm_storeu_ps(planes[1] + f, _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+        }
+    }
+#endif
+    deinterleaveScalar(in, channels, f, frames, format, planes);
+}
+
+} // namespace AudioFormat
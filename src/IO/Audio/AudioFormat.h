@@ -0,0 +1,49 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 JAQUBA (https://github.com/JAQUBA)
+// Part of JQB_WindowsLib — https://github.com/JAQUBA/JQB_WindowsLib
+
+/**
+ * AudioFormat.h — konwersja próbek urządzenia ↔ płaszczyzny float
+ *
+ * Bufory waveOut/waveIn są przeplecione (ramka = po jednej próbce każdego
+ * kanału) w formacie urządzenia; przetwarzanie (generatory, decymacja,
+ * strumień przechwytywania) działa na osobnej płaszczyźnie float ±1.0 dla
+ * każdego kanału. Przy __SSE2__ przeplatanie z konwersją idzie wektorowo dla
+ * PCM16 i float32 (mono i stereo — wspólne przypadki); 24-bit i więcej
+ * kanałów — pętla skalarna.
+ *
+ * Nie korzysta z WinAPI — bezpieczne poza AudioEngine.
+ */
+
+#ifndef AUDIO_FORMAT_H
+#define AUDIO_FORMAT_H
+
+#include <cstddef>
+
+enum AudioSampleFormat {
+    AUDIO_FORMAT_PCM16 = 0,     // int16, full scale 32767
+    AUDIO_FORMAT_PCM24,         // packed 3-byte int, full scale 8388607
+    AUDIO_FORMAT_FLOAT32        // IEEE float, full scale 1.0
+};
+
+namespace AudioFormat {
+
+// Bytes per sample of one channel (block align = bytes × channels)
+int sampleBytes(AudioSampleFormat format);
+int bitsPerSample(AudioSampleFormat format);
+
+// Planar float → interleaved device samples. planes[ch][frame], values
+// clamped to ±1.0 for every format (the device never sees overs).
+// exactInverse: ×32768 / ×8388608 (clamped to the int range) and float not
+// clamped — the exact inverse of deinterleave(), for re-encoding captured
+// samples bit-exactly (recorder).
+void interleave(const float* const* planes, int channels, size_t frames,
+                AudioSampleFormat format, void* out, bool exactInverse = false);
+
+// Interleaved device samples → planar float (int16 / 32768, int24 / 8388608)
+void deinterleave(const void* in, int channels, size_t frames,
+                  AudioSampleFormat format, float* const* planes);
+
+} // namespace AudioFormat
+
+#endif // AUDIO_FORMAT_H
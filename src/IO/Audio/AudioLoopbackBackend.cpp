@@ -0,0 +1,153 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 JAQUBA (https://github.com/JAQUBA)
+// Part of JQB_WindowsLib — https://github.com/JAQUBA/JQB_WindowsLib
+
+#include "AudioLoopbackBackend.h"
+#include <algorithm>
+#include <cstring>
+
+AudioLoopbackBackend::AudioLoopbackBackend(AudioBackendClock clock)
+    : AudioNullBackend(clock)
+    , m_fifoRead(0)
+    , m_fifoFill(0)
+    , m_overflowing(false)
+    , m_framesCaptured(0)
+    , m_loopOverruns(0)
+{
+}
+
+AudioLoopbackBackend::~AudioLoopbackBackend() {
+    closeOutput();
+    closeInput();
+}
+
+std::vector<std::string> AudioLoopbackBackend::enumOutputDevices() {
+    return std::vector<std::string>(1, "Loopback output");
+}
+
+std::vector<std::string> AudioLoopbackBackend::enumInputDevices() {
+    return std::vector<std::string>(1, "Loopback input");
+}
+
+// ============================================================================
+// Output → kolejka wejścia (wątek wyjścia)
+// ============================================================================
+bool AudioLoopbackBackend::outputPlayed(const char* data, size_t bytes) {
+    m_lock.lock();
+    if (m_inOpen) {
+        size_t frames   = (size_t)m_outConfig.bufferFrames;
+        size_t need     = frames * m_inConfig.blockAlign();
+        size_t capacity = m_fifo.size();
+
+        // Pełna kolejka: bez zegara wyjście czeka na wejście, z zegarem — przepełnienie
+        if (m_fifoFill + need > capacity && m_clock == AUDIO_CLOCK_FAST && m_fifoFill > 0) {
+            m_lock.unlock();
+            return false;
+        }
+
+        // Format i kanały wejścia; kanały, których wyjście nie ma — cisza
+        size_t planeSize = std::max(frames, (size_t)1);
+        size_t planes = (size_t)std::max(m_outConfig.channels, m_inConfig.channels);
+        if (m_planar.size() != planes * planeSize) m_planar.assign(planes * planeSize, 0.0f);
+        if (m_converted.size() != need) m_converted.assign(need, 0);
+        float* in[AUDIO_MAX_CHANNELS];
+        float* out[AUDIO_MAX_CHANNELS];
+        for (size_t ch = 0; ch < planes; ch++) {
+            in[ch] = out[ch] = &m_planar[ch * planeSize];
+        }
+        AudioFormat::deinterleave(data, m_outConfig.channels, frames, m_outConfig.format, out);
+        for (int ch = m_outConfig.channels; ch < m_inConfig.channels; ch++) {
+            memset(in[ch], 0, frames * sizeof(float));
+        }
+        AudioFormat::interleave(in, m_inConfig.channels, frames, m_inConfig.format, m_converted.data(), true);
+
+        const char* src = m_converted.data();
+        if (need > capacity) {              // Bufor wyjścia większy niż cała kolejka
+            src  += need - capacity;
+            need  = capacity;
+        }
+        if (m_fifoFill + need > capacity) {
+            size_t drop = m_fifoFill + need - capacity;
+            m_fifoRead  = (m_fifoRead + drop) % capacity;
+            m_fifoFill -= drop;
+            m_framesCaptured -= drop / m_inConfig.blockAlign();
+            if (!m_overflowing) m_loopOverruns++;
+            m_overflowing = true;
+        }
+
+        size_t write = (m_fifoRead + m_fifoFill) % capacity;
+        size_t first = std::min(need, capacity - write);
+        memcpy(&m_fifo[write], src, first);
+        memcpy(&m_fifo[0], src + first, need - first);
+        m_fifoFill += need;
+        m_framesCaptured += need / m_inConfig.blockAlign();   // Pozycja = oddane + w kolejce
+        m_inWake.set();
+    }
+    m_lock.unlock();
+    return AudioNullBackend::outputPlayed(data, bytes);
+}
+
+// ============================================================================
+// Input
+// ============================================================================
+bool AudioLoopbackBackend::openInput(int, AudioStreamConfig& config) {
+    if (m_inOpen) return false;
+    m_lock.lock();
+    if (m_outOpen) config.sampleRate = m_outConfig.sampleRate;    // Jeden zegar dla obu kierunków
+    m_inConfig = config;
+    m_fifo.assign((size_t)config.numBuffers * config.bufferBytes(), 0);
+    m_inBuffer.assign(config.bufferBytes(), 0);
+    m_fifoRead       = 0;
+    m_fifoFill       = 0;
+    m_overflowing    = false;
+    m_framesCaptured = 0;
+    m_framesRecorded = 0;
+    m_loopOverruns   = 0;
+    m_inOpen = true;
+    m_lock.unlock();
+    return true;
+}
+
+void AudioLoopbackBackend::closeInput() {
+    m_lock.lock();
+    m_inOpen = false;
+    m_lock.unlock();
+}
+
+const char* AudioLoopbackBackend::waitInputBuffer(uint32_t timeoutMs, int& frames) {
+    size_t bytes = m_inConfig.bufferBytes();
+    for (int attempt = 0; attempt < 2; attempt++) {
+        m_lock.lock();
+        if (!m_inOpen) {
+            m_lock.unlock();
+            return nullptr;
+        }
+        if (m_fifoFill >= bytes) {
+            size_t capacity = m_fifo.size();
+            size_t first = std::min(bytes, capacity - m_fifoRead);
+            memcpy(m_inBuffer.data(), &m_fifo[m_fifoRead], first);
+            memcpy(m_inBuffer.data() + first, &m_fifo[0], bytes - first);
+            m_fifoRead  = (m_fifoRead + bytes) % capacity;
+            m_fifoFill -= bytes;
+            m_overflowing = false;
+            m_lock.unlock();
+            frames = m_inConfig.bufferFrames;
+            return m_inBuffer.data();
+        }
+        m_lock.unlock();
+        if (attempt == 0) m_inWake.wait(timeoutMs);
+    }
+    return nullptr;
+}
+
+void AudioLoopbackBackend::releaseInputBuffer() {
+    m_framesRecorded += m_inConfig.bufferFrames;
+    // Miejsce w kolejce — wyjście bez zegara może ruszyć dalej
+    m_outWake.set();
+}
+
+bool AudioLoopbackBackend::getInputPosition(uint32_t& frames) const {
+    if (!m_inOpen) return false;
+    frames = (uint32_t)m_framesCaptured.load(std::memory_order_relaxed);
+    return true;
+}
@@ -0,0 +1,56 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 JAQUBA (https://github.com/JAQUBA)
+// Part of JQB_WindowsLib — https://github.com/JAQUBA/JQB_WindowsLib
+
+/**
+ * AudioLoopbackBackend.h — wyjście podane prosto na wejście (bez urządzenia)
+ *
+ * Wyjście działa jak AudioNullBackend (ten sam zegar); każdy bufor, który
+ * skończył "grać", trafia do kolejki wejścia — po konwersji do formatu i
+ * liczby kanałów wejścia (kanał i ← kanał i wyjścia, nadmiarowe: cisza).
+ * Generator → AudioCaptureRing / AudioMeter / AudioRecorder bez karty
+ * dźwiękowej i kabla.
+ *
+ * Kolejka wejścia mieści numBuffers buforów wejścia. Gdy wątek wejścia nie
+ * odbiera: AUDIO_CLOCK_REALTIME — najstarsze ramki przepadają (przepełnienie),
+ * AUDIO_CLOCK_FAST — wyjście czeka (żadna próbka nie ginie).
+ * Wejście przyjmuje częstotliwość wyjścia, jeśli to jest już otwarte.
+ */
+
+#ifndef AUDIO_LOOPBACK_BACKEND_H
+#define AUDIO_LOOPBACK_BACKEND_H
+
+#include "AudioNullBackend.h"
+
+class AudioLoopbackBackend : public AudioNullBackend {
+public:
+    explicit AudioLoopbackBackend(AudioBackendClock clock = AUDIO_CLOCK_REALTIME);
+    ~AudioLoopbackBackend() override;
+
+    std::vector<std::string> enumOutputDevices() override;
+    std::vector<std::string> enumInputDevices() override;
+
+    bool  openInput(int device, AudioStreamConfig& config) override;
+    void  closeInput() override;
+    const char* waitInputBuffer(uint32_t timeoutMs, int& frames) override;
+    void  releaseInputBuffer() override;
+    bool  getInputPosition(uint32_t& frames) const override;
+    uint32_t getInputOverruns() const override { return m_loopOverruns.load(std::memory_order_relaxed); }
+
+protected:
+    bool outputPlayed(const char* data, size_t bytes) override;
+
+private:
+    AudioLock         m_lock;           // Kolejka: wątek wyjścia pisze, wątek wejścia czyta
+    std::vector<char> m_fifo;           // Pierścień bajtów w formacie wejścia
+    size_t   m_fifoRead;
+    size_t   m_fifoFill;
+    bool     m_overflowing;             // Trwa przepełnienie — jeden epizod
+    std::vector<char>  m_inBuffer;      // Bufor oddany silnikowi
+    std::vector<char>  m_converted;     // Bufor wyjścia w formacie wejścia
+    std::vector<float> m_planar;
+    std::atomic<uint64_t> m_framesCaptured;
+    std::atomic<uint32_t> m_loopOverruns;
+};
+
+#endif // AUDIO_LOOPBACK_BACKEND_H
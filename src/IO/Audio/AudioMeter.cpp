@@ -0,0 +1,302 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 JAQUBA (https://github.com/JAQUBA)
+// Part of JQB_WindowsLib — https://github.com/JAQUBA/JQB_WindowsLib
+
+#include "AudioMeter.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+// AudioMeasurement jako płaszczyzna double w AudioSnapshot
+static const int METER_FIELDS = (int)(sizeof(AudioMeasurement) / sizeof(double));
+static_assert(sizeof(AudioMeasurement) == METER_FIELDS * sizeof(double), "AudioMeasurement must hold only doubles");
+
+// Połowa szerokości listka głównego okna Blackman-Harris (4 prążki) + zapas
+static const size_t METER_LOBE = 5;
+// Najmniejsza histereza licznika przejść (-80 dBFS) i jej udział w AC RMS
+static const double METER_MIN_HYSTERESIS = 1e-4;
+static const double METER_HYSTERESIS     = 0.1;
+static const double METER_TINY          = 1e-30;
+
+AudioMeter::AudioMeter()
+    : m_windowSize(AUDIO_METER_WINDOW)
+    , m_hop(AUDIO_METER_WINDOW / 2)
+    , m_lowHz(20.0)
+    , m_highHz(20000.0)
+    , m_harmonics(AUDIO_METER_HARMONICS)
+    , m_running(false)
+    , m_ring(nullptr)
+    , m_sampleRate(0)
+    , m_fill(0)
+    , m_fft(AUDIO_METER_WINDOW, FFT_WINDOW_BLACKMAN_HARRIS)
+    , m_prevSample(0.0f)
+    , m_armed(false)
+    , m_dcEstimate(0.0)
+    , m_hysteresis(1e-3)
+    , m_results(METER_FIELDS)
+    , m_overruns(0)
+{
+}
+
+AudioMeter::~AudioMeter() {
+    stop();
+}
+
+// ============================================================================
+// Konfiguracja
+// ============================================================================
+void AudioMeter::setWindowSize(size_t samples) {
+    size_t n = 256;
+    while (n < samples) n <<= 1;
+    m_windowSize = n;
+    m_hop        = n / 2;
+}
+
+void AudioMeter::setBandwidth(double lowHz, double highHz) {
+    if (lowHz < 0.0) lowHz = 0.0;
+    if (highHz <= lowHz) return;
+    m_lowHz  = lowHz;
+    m_highHz = highHz;
+}
+
+void AudioMeter::setHarmonics(int count) {
+    m_harmonics = std::min(std::max(count, 2), 50);
+}
+
+// ============================================================================
+// Start / Stop
+// ============================================================================
+bool AudioMeter::start(AudioEngine& engine, int channel) {
+    if (m_running) stop();
+    if (!engine.isInputRunning() || channel < 0 || channel >= engine.getInputChannels()) return false;
+
+    m_ring       = &engine.getInputCapture(channel);
+    m_sampleRate = engine.getActualSampleRate();
+    m_fft.setSize(m_windowSize);
+    m_window.assign(m_windowSize, 0.0f);
+    m_fftIn.assign(m_windowSize, 0.0);
+    m_power.assign(m_fft.getBinCount(), 0.0);
+    m_dcEstimate = 0.0;
+    m_hysteresis = 1e-3;
+    m_overruns   = 0;
+    m_results.resize(METER_FIELDS, 1);
+    resetState();
+    m_reader = m_ring->attach();
+
+    if (!m_thread.start(meterThreadProc, this)) return false;
+    m_ring->pin();
+    m_running = true;
+    return true;
+}
+
+void AudioMeter::stop() {
+    if (!m_running) return;
+    m_stop.set();
+    m_thread.join();
+    m_ring->unpin();
+    m_running   = false;
+}
+
+bool AudioMeter::getMeasurement(AudioMeasurement& out) {
+    const double* data;
+    int count;
+    if (!m_results.borrow(data, count) || count != METER_FIELDS) return false;
+    memcpy(static_cast<void*>(&out), data, sizeof(AudioMeasurement));
+    return true;
+}
+
+void AudioMeter::meterThreadProc(void* param) {
+    AudioMeter* self = (AudioMeter*)param;
+    do {
+        self->process();
+    } while (!self->m_stop.wait(AUDIO_METER_POLL_MS));
+}
+
+// ============================================================================
+// Wątek pomiarowy
+// ============================================================================
+void AudioMeter::resetState() {
+    m_fill = 0;
+    m_hops[0].reset();
+    m_hops[1].reset();
+    m_prevSample = 0.0f;
+    m_armed      = false;
+}
+
+void AudioMeter::process() {
+    for (;;) {
+        // Czytamy najwyżej do końca bieżącej połówki — każdy blok należy do jednego hopu
+        size_t hopEnd = (m_fill / m_hop + 1) * m_hop;
+        uint64_t lost = m_reader.overruns;
+        size_t n = m_ring->read(m_reader, m_window.data() + m_fill, hopEnd - m_fill);
+        if (m_reader.overruns != lost) {
+            // Luka w strumieniu — okno od nowa, od próbek tuż za luką
+            m_overruns.store(m_reader.overruns, std::memory_order_relaxed);
+            memmove(m_window.data(), m_window.data() + m_fill, n * sizeof(float));
+            resetState();
+        }
+        if (n == 0) break;
+
+        accumulate(m_window.data() + m_fill, n, m_reader.position - n, m_hops[m_fill < m_hop ? 0 : 1]);
+        m_fill += n;
+
+        if (m_fill == m_windowSize) {
+            measure(m_reader.position);
+            memmove(m_window.data(), m_window.data() + m_hop, m_hop * sizeof(float));
+            m_hops[0] = m_hops[1];
+            m_hops[1].reset();
+            m_fill = m_hop;
+        }
+    }
+}
+
+void AudioMeter::accumulate(const float* samples, size_t count, uint64_t position, HopStats& hop) {
+    float dc = (float)m_dcEstimate;
+    float h  = (float)m_hysteresis;
+    float prev = m_prevSample;
+    bool armed = m_armed;
+
+    double sum = hop.sum, sumSq = hop.sumSq, peak = hop.peak;
+    for (size_t i = 0; i < count; i++) {
+        float x = samples[i];
+
+        // Przejście w górę z histerezą: uzbrojenie poniżej -h, zliczenie przy >= 0
+        float y = x - dc;
+        if (y < -h) {
+            armed = true;
+        } else if (armed && y >= 0.0f) {
+            // Interpolacja liniowa między próbką i-1 a i — ułamek okresu próbkowania
+            double t = (double)(position + i) - 1.0 + (double)prev / (double)(prev - y);
+            if (hop.crossings == 0) {
+                hop.firstCrossing = t;
+                hop.firstSum      = sum;
+                hop.firstSumSq    = sumSq;
+                hop.firstIndex    = position + i;
+            }
+            hop.lastCrossing = t;
+            hop.lastSum      = sum;
+            hop.lastSumSq    = sumSq;
+            hop.lastIndex    = position + i;
+            hop.crossings++;
+            armed = false;
+        }
+        prev = y;
+
+        sum   += x;
+        sumSq += (double)x * x;
+        double a = fabs(x);
+        if (a > peak) peak = a;
+    }
+
+    hop.sum   = sum;
+    hop.sumSq = sumSq;
+    hop.peak  = peak;
+    m_prevSample = prev;
+    m_armed      = armed;
+}
+
+void AudioMeter::measure(uint64_t endPosition) {
+    const HopStats& a = m_hops[0];
+    const HopStats& b = m_hops[1];
+
+    AudioMeasurement m;
+    m.position = (double)endPosition;
+    m.peak     = std::max(a.peak, b.peak);
+
+    // Licznik odwrotnościowy: pełne okresy między pierwszym a ostatnim przejściem.
+    // Na tym samym odcinku DC i RMS — bez błędu ułamkowego okresu na brzegach okna.
+    double sum   = a.sum + b.sum;
+    double sumSq = a.sumSq + b.sumSq;
+    double n     = (double)m_windowSize;
+    uint32_t crossings = a.crossings + b.crossings;
+    if (crossings >= 2) {
+        double first = a.crossings ? a.firstCrossing : b.firstCrossing;
+        double last  = b.crossings ? b.lastCrossing  : a.lastCrossing;
+        if (last > first) {
+            m.frequency = (crossings - 1) * (double)m_sampleRate / (last - first);
+
+            // Sumy narastające okna w punktach przejść (hop b zaczyna się od sum a)
+            double s0  = a.crossings ? a.firstSum   : a.sum   + b.firstSum;
+            double q0  = a.crossings ? a.firstSumSq : a.sumSq + b.firstSumSq;
+            double s1  = b.crossings ? a.sum   + b.lastSum   : a.lastSum;
+            double q1  = b.crossings ? a.sumSq + b.lastSumSq : a.lastSumSq;
+            uint64_t i0 = a.crossings ? a.firstIndex : b.firstIndex;
+            uint64_t i1 = b.crossings ? b.lastIndex  : a.lastIndex;
+            // Odcinek próbek różni się od ułamkowego (last - first) o część próbki;
+            // brakującą część uzupełnia poziom przejścia (y = 0, czyli x = DC)
+            double d  = (last - first) - (double)(i1 - i0);
+            double x0 = m_dcEstimate;
+            sum   = s1 - s0 + d * x0;
+            sumSq = q1 - q0 + d * x0 * x0;
+            n     = last - first;
+        }
+    }
+    m.dc    = sum / n;
+    double ms = sumSq / n;
+    m.rms   = sqrt(ms);
+    m.acRms = sqrt(std::max(ms - m.dc * m.dc, 0.0));
+
+    spectrum(m);
+
+    m_dcEstimate = m.dc;
+    m_hysteresis = std::max(m.acRms * METER_HYSTERESIS, METER_MIN_HYSTERESIS);
+
+    memcpy(m_results.beginWrite(), &m, sizeof(AudioMeasurement));
+    m_results.publish(METER_FIELDS);
+}
+
+void AudioMeter::spectrum(AudioMeasurement& m) {
+    for (size_t i = 0; i < m_windowSize; i++) m_fftIn[i] = m_window[i];
+    m_fft.power(m_fftIn.data(), m_power.data());
+
+    // Pasmo pomiaru w prążkach; DC i jego listek zawsze poza pasmem
+    const double* p = m_power.data();
+    size_t bins = m_fft.getBinCount();
+    double df   = (double)m_sampleRate / (double)m_windowSize;
+    size_t lo   = std::max((size_t)ceil(m_lowHz / df), METER_LOBE + 1);
+    size_t hi   = std::min((size_t)(m_highHz / df), bins - 2);
+    if (lo >= hi) return;
+
+    double total = 0.0;
+    size_t k0 = lo;
+    for (size_t k = lo; k <= hi; k++) {
+        total += p[k];
+        if (p[k] > p[k0]) k0 = k;
+    }
+    if (total <= METER_TINY) return;
+
+    auto lobe = [&](size_t c) {
+        double s = 0.0;
+        size_t from = c > lo + METER_LOBE ? c - METER_LOBE : lo;
+        size_t to   = std::min(c + METER_LOBE, hi);
+        for (size_t k = from; k <= to; k++) s += p[k];
+        return s;
+    };
+    double fund = lobe(k0);
+
+    // Położenie podstawowej między prążkami (parabola na amplitudach) — dla harmonicznych
+    double l = sqrt(p[k0 - 1]), c = sqrt(p[k0]), r = sqrt(p[k0 + 1]);
+    double denom = l - 2.0 * c + r;
+    double kf = (double)k0 + (denom < 0.0 ? 0.5 * (l - r) / denom : 0.0);
+
+    // H2 w listku podstawowej (podstawowa <= 2 · METER_LOBE prążków) — harmonicznych
+    // nie da się oddzielić, THD i SNR są publikowane jako nieważne
+    bool resolved = (size_t)llround(2.0 * kf) > k0 + 2 * METER_LOBE;
+    double harm = 0.0;
+    for (int h = 2; resolved && h <= m_harmonics; h++) {
+        size_t kh = (size_t)llround(h * kf);
+        if (kh > hi) break;
+        harm += lobe(kh);
+    }
+
+    // Suma mocy w listku = A² · ENBW; wartość średniokwadratowa sinusa = A² / 2
+    double rest  = std::max(total - fund, METER_TINY);
+    double noise = std::max(rest - harm, METER_TINY);
+    m.fundamental = sqrt(fund / (2.0 * m_fft.getNoiseBandwidth()));
+    m.thd         = resolved ? sqrt(harm / fund) : 0.0;
+    m.thdN        = sqrt(rest / total);
+    m.sinadDb     = 10.0 * log10(total / rest);
+    m.snrDb       = resolved ? 10.0 * log10(fund / noise) : 0.0;
+    m.harmonicsValid = resolved ? 1.0 : 0.0;
+    if (m.frequency == 0.0) m.frequency = kf * df;
+}
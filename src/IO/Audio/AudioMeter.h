@@ -0,0 +1,130 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 JAQUBA (https://github.com/JAQUBA)
+// Part of JQB_WindowsLib — https://github.com/JAQUBA/JQB_WindowsLib
+
+/**
+ * AudioMeter.h — Pomiary strumieniowe wejścia AudioEngine (RMS, THD+N, f)
+ *
+ * Własny wątek czyta pełny strumień jednego kanału (AudioCaptureRing, własny
+ * kursor) i co pół okna publikuje komplet wyników z ostatnich
+ * getWindowSize() próbek: true RMS i składowa stała (z pełnych okresów
+ * między pierwszym a ostatnim przejściem przez zero), szczyt, częstotliwość
+ * (odwrotnościowy licznik przejść przez zero — czas między pierwszym a
+ * ostatnim przejściem, interpolowany między próbkami), THD, THD+N, SINAD,
+ * SNR (widmo mocy FFT z oknem Blackman-Harris, pasmo setBandwidth()).
+ *
+ * Wielkości czasowe liczone są przyrostowo — każda próbka raz, sumy połówek
+ * okna łączone przy publikacji. Wyniki idą przez AudioSnapshot (wait-free):
+ * wątek UI tylko kopiuje gotowy AudioMeasurement do ValueDisplay.
+ */
+
+#ifndef AUDIO_METER_H
+#define AUDIO_METER_H
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#include "AudioEngine.h"
+#include "AudioThread.h"
+#include "../../Util/FFT.h"
+
+#define AUDIO_METER_WINDOW      8192    // Próbek na pomiar (potęga dwójki)
+#define AUDIO_METER_HARMONICS   10      // Harmoniczne w THD (2..10)
+#define AUDIO_METER_POLL_MS     10
+
+// Wynik jednego okna — same double (publikowany jako płaszczyzna AudioSnapshot).
+// Amplitudy w skali pełnej ±1.0, współczynniki jako ułamek (0.01 = 1 %).
+struct AudioMeasurement {
+    double position     = 0;    // capture sequence number one past the window
+    double rms          = 0;    // true RMS, AC + DC, over whole periods when the counter locks
+    double acRms        = 0;    // RMS without DC
+    double peak         = 0;    // max |sample|
+    double dc           = 0;    // mean, same span as rms
+    double frequency    = 0;    // Hz; zero-crossing counter, spectral peak below 2 crossings
+    double fundamental  = 0;    // RMS of the spectral peak
+    double thd          = 0;    // harmonics 2..N / fundamental
+    double thdN         = 0;    // (total - fundamental) / total, in band
+    double sinadDb      = 0;
+    double snrDb        = 0;    // fundamental / (noise without harmonics)
+    double harmonicsValid = 0;  // 1 = thd / snrDb valid; 0 = H2 inside the fundamental lobe (both 0)
+};
+
+class AudioMeter {
+public:
+    AudioMeter();
+    ~AudioMeter();
+
+    // Before start()
+    void setWindowSize(size_t samples);                 // power of two >= 256 (rounded up)
+    size_t getWindowSize() const { return m_windowSize; }
+    void setBandwidth(double lowHz, double highHz);     // THD+N / SNR band, default 20 Hz – 20 kHz
+    void setHarmonics(int count);                       // highest harmonic in THD, 2..50
+
+    /**
+     * Startuje wątek pomiarowy na kanale wejścia (wejście musi działać).
+     * Pomiar zaczyna się od najnowszej próbki.
+     */
+    bool start(AudioEngine& engine, int channel = 0);
+    void stop();
+    bool isRunning() const { return m_running; }
+
+    // Latest result; true if new since the previous call. One reader thread (UI).
+    bool getMeasurement(AudioMeasurement& out);
+    // Samples lost because the meter thread fell more than the ring capacity behind
+    uint64_t getOverruns() const { return m_overruns.load(std::memory_order_relaxed); }
+
+private:
+    // Sumy jednej połowy okna (hop). Przy pierwszym i ostatnim przejściu
+    // zapamiętane są sumy narastające — RMS i DC z pełnych okresów.
+    struct HopStats {
+        double   sum, sumSq, peak;
+        double   firstCrossing, lastCrossing;   // Numer próbki (ułamkowy) przejścia w górę
+        double   firstSum, firstSumSq;          // Sumy hopu przed próbką pierwszego przejścia
+        double   lastSum, lastSumSq;
+        uint64_t firstIndex, lastIndex;         // Numer próbki tuż za przejściem
+        uint32_t crossings;
+        void reset() {
+            sum = sumSq = peak = 0;
+            firstCrossing = lastCrossing = 0;
+            firstSum = firstSumSq = lastSum = lastSumSq = 0;
+            firstIndex = lastIndex = 0;
+            crossings = 0;
+        }
+    };
+
+    size_t   m_windowSize;
+    size_t   m_hop;
+    double   m_lowHz, m_highHz;
+    int      m_harmonics;
+    bool     m_running;
+
+    AudioCaptureRing*        m_ring;
+    AudioCaptureRing::Reader m_reader;
+    uint32_t m_sampleRate;
+    AudioThread m_thread;
+    AudioEvent  m_stop;
+
+    // Stan wątku pomiarowego
+    std::vector<float>  m_window;       // Ostatnie m_windowSize próbek
+    size_t              m_fill;
+    HopStats            m_hops[2];      // [0] starsza połowa, [1] bieżąca
+    FFT                 m_fft;
+    std::vector<double> m_fftIn, m_power;
+    float    m_prevSample;              // Ostatnia próbka (po odjęciu DC) — przejścia między blokami
+    bool     m_armed;                   // Sygnał zszedł poniżej -histerezy od ostatniego przejścia
+    double   m_dcEstimate;              // DC i histereza z poprzedniego okna
+    double   m_hysteresis;
+
+    AudioSnapshot m_results;
+    std::atomic<uint64_t> m_overruns;
+
+    void resetState();
+    void process();
+    void accumulate(const float* samples, size_t count, uint64_t position, HopStats& hop);
+    void measure(uint64_t endPosition);
+    void spectrum(AudioMeasurement& m);
+
+    static void meterThreadProc(void* param);
+};
+
+#endif // AUDIO_METER_H
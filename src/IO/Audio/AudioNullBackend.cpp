@@ -0,0 +1,267 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 JAQUBA (https://github.com/JAQUBA)
+// Part of JQB_WindowsLib — https://github.com/JAQUBA/JQB_WindowsLib
+
+#include "AudioNullBackend.h"
+#include <cstring>
+
+AudioNullBackend::AudioNullBackend(AudioBackendClock clock)
+    : m_clock(clock)
+    , m_outConfig()
+    , m_inConfig()
+    , m_outOpen(false)
+    , m_inOpen(false)
+    , m_framesRecorded(0)
+    , m_outSubmitted(0)
+    , m_outPlayed(0)
+    , m_outStart(0)
+    , m_outQueuedFrames(0)
+    , m_framesPlayed(0)
+    , m_outUnderruns(0)
+    , m_outFile(nullptr)
+    , m_inDelivered(0)
+    , m_inStart(0)
+    , m_inOverruns(0)
+    , m_inLostFrames(0)
+    , m_inFile(nullptr)
+    , m_inFileSize(0)
+{
+}
+
+AudioNullBackend::~AudioNullBackend() {
+    closeOutput();
+    closeInput();
+}
+
+double AudioNullBackend::elapsedFrames(int64_t start, uint32_t rate) const {
+    return (double)(AudioClock::now() - start) * rate / (double)AudioClock::frequency();
+}
+
+// Czas do ramki dueFrames osi kierunku, w ms (zaokrąglony w górę, min. 0)
+static uint32_t msUntil(double dueFrames, double elapsed, uint32_t rate) {
+    double frames = dueFrames - elapsed;
+    return frames > 0.0 ? (uint32_t)(frames * 1000.0 / rate) + 1 : 0;
+}
+
+std::vector<std::string> AudioNullBackend::enumOutputDevices() {
+    return std::vector<std::string>(1, "Null output");
+}
+
+std::vector<std::string> AudioNullBackend::enumInputDevices() {
+    return std::vector<std::string>(1, "Null input");
+}
+
+// ============================================================================
+// Output
+// ============================================================================
+bool AudioNullBackend::openOutput(int, AudioStreamConfig& config) {
+    if (m_outOpen) return false;
+
+    if (!m_outputPath.empty()) {
+        m_outFile = fopen(m_outputPath.c_str(), "wb");
+        if (!m_outFile) return false;
+    }
+
+    m_outConfig = config;
+    m_outData.assign((size_t)config.numBuffers * config.bufferBytes(), 0);
+    m_outSubmitted    = 0;
+    m_outPlayed       = 0;
+    m_outStart        = AudioClock::now();
+    m_outQueuedFrames = 0;
+    m_framesPlayed    = 0;
+    m_outUnderruns    = 0;
+    m_outOpen = true;
+    return true;
+}
+
+void AudioNullBackend::closeOutput() {
+    if (!m_outOpen) return;
+    m_outOpen = false;
+    if (m_outFile) {
+        fclose(m_outFile);
+        m_outFile = nullptr;
+    }
+}
+
+bool AudioNullBackend::outputPlayed(const char* data, size_t bytes) {
+    if (m_outFile) fwrite(data, 1, bytes, m_outFile);
+    return true;
+}
+
+// Bufory, których czas grania minął, opuszczają kolejkę (w kolejności)
+void AudioNullBackend::updatePlayed() {
+    uint64_t target = m_outSubmitted;
+    if (m_clock == AUDIO_CLOCK_REALTIME) {
+        uint64_t finished = (uint64_t)(elapsedFrames(m_outStart, m_outConfig.sampleRate) / m_outConfig.bufferFrames);
+        if (finished < target) target = finished;
+    }
+    size_t bytes = m_outConfig.bufferBytes();
+    while (m_outPlayed < target) {
+        const char* data = &m_outData[(m_outPlayed % m_outConfig.numBuffers) * bytes];
+        if (!outputPlayed(data, bytes)) break;
+        m_outPlayed++;
+        m_framesPlayed += m_outConfig.bufferFrames;
+    }
+}
+
+char* AudioNullBackend::waitOutputBuffer(uint32_t timeoutMs) {
+    if (!m_outOpen) return nullptr;
+    uint64_t count = (uint64_t)m_outConfig.numBuffers;
+
+    updatePlayed();
+    if (m_outSubmitted - m_outPlayed >= count) {
+        // Kolejka pełna — do końca najstarszego bufora (albo do zwolnienia miejsca w pętli zwrotnej)
+        uint32_t wait = timeoutMs;
+        if (m_clock == AUDIO_CLOCK_REALTIME) {
+            uint32_t ms = msUntil((double)(m_outPlayed + 1) * m_outConfig.bufferFrames,
+                                  elapsedFrames(m_outStart, m_outConfig.sampleRate), m_outConfig.sampleRate);
+            if (ms < wait) wait = ms;
+        }
+        m_outWake.wait(wait);
+        updatePlayed();
+        if (m_outSubmitted - m_outPlayed >= count) return nullptr;
+    }
+    return &m_outData[(m_outSubmitted % count) * m_outConfig.bufferBytes()];
+}
+
+void AudioNullBackend::submitOutputBuffer(char*) {
+    if (m_clock == AUDIO_CLOCK_REALTIME) {
+        uint64_t queued = m_outSubmitted * (uint64_t)m_outConfig.bufferFrames;
+        if (m_outSubmitted == 0) {
+            m_outStart = AudioClock::now();     // Granie zaczyna się od pierwszego bufora
+        } else if (elapsedFrames(m_outStart, m_outConfig.sampleRate) > (double)queued) {
+            // Kolejka wyschła — urządzenie stało; oś czasu rusza od teraz
+            m_outUnderruns++;
+            m_outStart = AudioClock::now() - (int64_t)((double)queued * AudioClock::frequency() / m_outConfig.sampleRate);
+        }
+    }
+    m_outSubmitted++;
+    m_outQueuedFrames = m_outSubmitted * (uint64_t)m_outConfig.bufferFrames;
+}
+
+void AudioNullBackend::wakeOutput() {
+    m_outWake.set();
+}
+
+bool AudioNullBackend::getOutputPosition(uint32_t& frames) const {
+    if (!m_outOpen) return false;
+    uint64_t played = m_framesPlayed.load(std::memory_order_relaxed);
+    if (m_clock == AUDIO_CLOCK_REALTIME) {
+        // Pozycja z zegara, nie dalej niż to, co wysłano
+        double elapsed = elapsedFrames(m_outStart, m_outConfig.sampleRate);
+        uint64_t queued = m_outQueuedFrames.load(std::memory_order_relaxed);
+        played = elapsed < (double)queued ? (uint64_t)elapsed : queued;
+    }
+    frames = (uint32_t)played;
+    return true;
+}
+
+// ============================================================================
+// Input
+// ============================================================================
+bool AudioNullBackend::openInput(int, AudioStreamConfig& config) {
+    if (m_inOpen) return false;
+
+    if (!m_inputPath.empty()) {
+        m_inFile = fopen(m_inputPath.c_str(), "rb");
+        if (!m_inFile) return false;
+        fseek(m_inFile, 0, SEEK_END);
+        m_inFileSize = (uint64_t)ftell(m_inFile);
+        fseek(m_inFile, 0, SEEK_SET);
+        if (m_inFileSize < (uint64_t)config.blockAlign()) {
+            fclose(m_inFile);       // Pusty plik — cisza
+            m_inFile = nullptr;
+        }
+    }
+
+    m_inConfig = config;
+    m_inData.assign((size_t)config.numBuffers * config.bufferBytes(), 0);
+    m_inDelivered    = 0;
+    m_inStart        = AudioClock::now();
+    m_framesRecorded = 0;
+    m_inOverruns     = 0;
+    m_inLostFrames   = 0;
+    m_inOpen = true;
+    return true;
+}
+
+void AudioNullBackend::closeInput() {
+    if (!m_inOpen) return;
+    m_inOpen = false;
+    if (m_inFile) {
+        fclose(m_inFile);
+        m_inFile = nullptr;
+    }
+}
+
+// Kolejne bajty pliku wejściowego w pętli (albo cisza)
+void AudioNullBackend::readInput(char* buffer, size_t bytes) {
+    if (!m_inFile) {
+        memset(buffer, 0, bytes);
+        return;
+    }
+    size_t done = 0;
+    while (done < bytes) {
+        size_t n = fread(buffer + done, 1, bytes - done, m_inFile);
+        if (n == 0) fseek(m_inFile, 0, SEEK_SET);
+        done += n;
+    }
+}
+
+// Przesunięcie pliku o utracone bufory — plik biegnie razem z osią czasu
+void AudioNullBackend::skipInput(uint64_t bytes) {
+    if (!m_inFile) return;
+    uint64_t position = ((uint64_t)ftell(m_inFile) + bytes) % m_inFileSize;
+    fseek(m_inFile, (long)position, SEEK_SET);
+}
+
+const char* AudioNullBackend::waitInputBuffer(uint32_t timeoutMs, int& frames) {
+    if (!m_inOpen) return nullptr;
+    uint64_t count = (uint64_t)m_inConfig.numBuffers;
+    size_t   bytes = m_inConfig.bufferBytes();
+
+    if (m_clock == AUDIO_CLOCK_REALTIME) {
+        double elapsed = elapsedFrames(m_inStart, m_inConfig.sampleRate);
+        uint64_t ready = (uint64_t)(elapsed / m_inConfig.bufferFrames);
+        if (ready <= m_inDelivered) {
+            uint32_t ms = msUntil((double)(m_inDelivered + 1) * m_inConfig.bufferFrames, elapsed, m_inConfig.sampleRate);
+            m_inWake.wait(ms < timeoutMs ? ms : timeoutMs);
+            ready = (uint64_t)(elapsedFrames(m_inStart, m_inConfig.sampleRate) / m_inConfig.bufferFrames);
+            if (ready <= m_inDelivered) return nullptr;
+        }
+        // Nagrane więcej, niż mieści kolejka — najstarsze bufory przepadły
+        if (ready - m_inDelivered > count) {
+            uint64_t lost = ready - m_inDelivered - count;
+            skipInput(lost * bytes);
+            m_inDelivered += lost;
+            m_inLostFrames += lost * m_inConfig.bufferFrames;
+            m_inOverruns++;
+        }
+    }
+
+    char* buffer = &m_inData[(m_inDelivered % count) * bytes];
+    readInput(buffer, bytes);
+    frames = m_inConfig.bufferFrames;
+    return buffer;
+}
+
+void AudioNullBackend::releaseInputBuffer() {
+    m_inDelivered++;
+    m_framesRecorded += m_inConfig.bufferFrames;
+}
+
+void AudioNullBackend::wakeInput() {
+    m_inWake.set();
+}
+
+bool AudioNullBackend::getInputPosition(uint32_t& frames) const {
+    if (!m_inOpen) return false;
+    uint64_t recorded = m_framesRecorded.load(std::memory_order_relaxed);
+    if (m_clock == AUDIO_CLOCK_REALTIME) {
+        // Bez ramek utraconych w przepełnieniach — nigdy nie trafią do silnika
+        recorded = (uint64_t)elapsedFrames(m_inStart, m_inConfig.sampleRate) -
+                   m_inLostFrames.load(std::memory_order_relaxed);
+    }
+    frames = (uint32_t)recorded;
+    return true;
+}
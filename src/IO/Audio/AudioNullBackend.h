@@ -0,0 +1,113 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 JAQUBA (https://github.com/JAQUBA)
+// Part of JQB_WindowsLib — https://github.com/JAQUBA/JQB_WindowsLib
+
+/**
+ * AudioNullBackend.h — backend bez urządzenia audio (testy, benchmarki)
+ *
+ * Wyjście: bufory "grane" według zegara i porzucane albo dopisywane do
+ * pliku RAW. Wejście: cisza albo plik RAW odtwarzany w pętli. Zegar:
+ *  - AUDIO_CLOCK_REALTIME — tempo prawdziwego urządzenia (QueryPerformanceCounter),
+ *    z niedoborami / przepełnieniami, gdy wątek silnika nie nadąża,
+ *  - AUDIO_CLOCK_FAST — tak szybko, jak silnik przetwarza (benchmark całej ścieżki:
+ *    generator → przeplot, przeplot → pierścień, decymacja, snapshoty).
+ *
+ * Plik RAW: przeplecione próbki w formacie strumienia, bez nagłówka (jak
+ * AudioRecorder z AUDIO_FILE_RAW). Nie korzysta z winmm ani WinAPI
+ * (AudioThread) — działa też na Linuksie.
+ */
+
+#ifndef AUDIO_NULL_BACKEND_H
+#define AUDIO_NULL_BACKEND_H
+
+#include <atomic>
+#include <cstdio>
+#include "AudioBackend.h"
+#include "AudioThread.h"
+
+enum AudioBackendClock {
+    AUDIO_CLOCK_REALTIME = 0,   // buffers at the sample rate
+    AUDIO_CLOCK_FAST            // as fast as the engine consumes them
+};
+
+class AudioNullBackend : public AudioBackend {
+public:
+    explicit AudioNullBackend(AudioBackendClock clock = AUDIO_CLOCK_REALTIME);
+    ~AudioNullBackend() override;
+
+    // Before open
+    void setClock(AudioBackendClock clock) { m_clock = clock; }
+    AudioBackendClock getClock() const     { return m_clock; }
+    // Played output appended to a RAW file; empty = discarded
+    void setOutputFile(const std::string& path) { m_outputPath = path; }
+    // Input read from a RAW file in the input stream format, looped; empty = silence
+    void setInputFile(const std::string& path)  { m_inputPath = path; }
+
+    // Frames through each direction since open (any thread)
+    uint64_t getFramesPlayed()   const { return m_framesPlayed.load(std::memory_order_relaxed); }
+    uint64_t getFramesRecorded() const { return m_framesRecorded.load(std::memory_order_relaxed); }
+
+    std::vector<std::string> enumOutputDevices() override;
+    std::vector<std::string> enumInputDevices() override;
+
+    bool  openOutput(int device, AudioStreamConfig& config) override;
+    void  closeOutput() override;
+    char* waitOutputBuffer(uint32_t timeoutMs) override;
+    void  submitOutputBuffer(char* buffer) override;
+    void  wakeOutput() override;
+    bool  getOutputPosition(uint32_t& frames) const override;
+    uint32_t getOutputUnderruns() const override { return m_outUnderruns.load(std::memory_order_relaxed); }
+
+    bool  openInput(int device, AudioStreamConfig& config) override;
+    void  closeInput() override;
+    const char* waitInputBuffer(uint32_t timeoutMs, int& frames) override;
+    void  releaseInputBuffer() override;
+    void  wakeInput() override;
+    bool  getInputPosition(uint32_t& frames) const override;
+    uint32_t getInputOverruns() const override { return m_inOverruns.load(std::memory_order_relaxed); }
+
+protected:
+    AudioBackendClock m_clock;
+    AudioStreamConfig m_outConfig;
+    AudioStreamConfig m_inConfig;
+    bool     m_outOpen;
+    bool     m_inOpen;
+    AudioEvent m_outWake;               // Przerwanie oczekiwania (stop, miejsce w pętli zwrotnej)
+    AudioEvent m_inWake;
+    std::atomic<uint64_t> m_framesRecorded;
+
+    // Wątek wyjścia: bufor skończył grać (w kolejności). false — urządzenie nie
+    // przyjmuje (pętla zwrotna pełna), bufor zostaje w kolejce.
+    virtual bool outputPlayed(const char* data, size_t bytes);
+    // Ramki od początku osi czasu kierunku wg zegara czasu rzeczywistego
+    double elapsedFrames(int64_t start, uint32_t rate) const;
+
+private:
+    std::string m_outputPath;
+    std::string m_inputPath;
+
+    // --- Output ---
+    std::vector<char> m_outData;
+    uint64_t m_outSubmitted;            // Bufory wysłane (tylko wątek wyjścia)
+    uint64_t m_outPlayed;               // Bufory zagrane i zwolnione
+    std::atomic<int64_t>  m_outStart;   // Początek osi czasu odtwarzania (ticki QPC)
+    std::atomic<uint64_t> m_outQueuedFrames;   // Ramki wysłane — granica pozycji grania
+    std::atomic<uint64_t> m_framesPlayed;
+    std::atomic<uint32_t> m_outUnderruns;
+    FILE*    m_outFile;
+
+    // --- Input ---
+    std::vector<char> m_inData;
+    uint64_t m_inDelivered;             // Bufory oddane silnikowi (tylko wątek wejścia)
+    std::atomic<int64_t>  m_inStart;
+    std::atomic<uint32_t> m_inOverruns;
+    std::atomic<uint64_t> m_inLostFrames;   // Ramki pominięte przy przepełnieniu kolejki
+    FILE*    m_inFile;
+    uint64_t m_inFileSize;
+
+    void updatePlayed();
+    void readInput(char* buffer, size_t bytes);
+    void skipInput(uint64_t bytes);
+};
+
+#endif // AUDIO_NULL_BACKEND_H
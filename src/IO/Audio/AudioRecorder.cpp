@@ -0,0 +1,348 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 JAQUBA (https://github.com/JAQUBA)
+// Part of JQB_WindowsLib — https://github.com/JAQUBA/JQB_WindowsLib
+
+#include "AudioRecorder.h"
+#include "../../Util/StringUtils.h"
+#include <cstring>
+#include <ctime>
+
+// Ramek czytanych z pierścieni naraz (na kanał)
+static const size_t RECORDER_CHUNK = 4096;
+
+AudioRecorder::AudioRecorder(const std::string& filenamePrefix)
+    : m_filenamePrefix(filenamePrefix)
+    , m_fileType(AUDIO_FILE_WAV)
+    , m_sampleFormat(AUDIO_FORMAT_PCM16)
+    , m_formatSet(false)
+    , m_recording(false)
+    , m_channels(0)
+    , m_sampleRate(0)
+    , m_format(AUDIO_FORMAT_PCM16)
+    , m_blockAlign(0)
+    , m_headerBytes(0)
+    , m_startPosition(0)
+    , m_file(INVALID_HANDLE_VALUE)
+    , m_thread(NULL)
+    , m_stopEvent(NULL)
+    , m_position(0)
+    , m_dataBytes(0)
+    , m_blocksSinceHeader(0)
+    , m_staging(nullptr)
+    , m_stagingSize(0)
+    , m_stagingFill(0)
+    , m_header(nullptr)
+    , m_inGap(false)
+    , m_frames(0)
+    , m_droppedFrames(0)
+    , m_dropEvents(0)
+    , m_error(false)
+{
+    for (AudioCaptureRing*& ring : m_rings) ring = nullptr;
+}
+
+AudioRecorder::~AudioRecorder() {
+    stop();
+}
+
+std::string AudioRecorder::generateFilename() const {
+    time_t now = time(nullptr);
+    struct tm* t = localtime(&now);
+    char buf[128];
+    snprintf(buf, sizeof(buf), "%s_%04d-%02d-%02d_%02d-%02d-%02d.%s",
+             m_filenamePrefix.c_str(),
+             t->tm_year + 1900, t->tm_mon + 1, t->tm_mday,
+             t->tm_hour, t->tm_min, t->tm_sec,
+             m_fileType == AUDIO_FILE_WAV ? "wav" : "raw");
+    return std::string(buf);
+}
+
+double AudioRecorder::getDurationSeconds() const {
+    return m_sampleRate ? (double)getFramesWritten() / m_sampleRate : 0.0;
+}
+
+// ============================================================================
+// Start / Stop
+// ============================================================================
+bool AudioRecorder::start(AudioEngine& engine, const std::string& filename) {
+    if (m_recording) stop();
+    if (!engine.isInputRunning()) return false;
+
+    m_channels    = engine.getInputChannels();
+    m_sampleRate  = engine.getActualSampleRate();
+    m_format      = m_formatSet ? m_sampleFormat : engine.getInputSampleFormat();
+    m_blockAlign  = (uint32_t)(m_channels * AudioFormat::sampleBytes(m_format));
+    m_headerBytes = m_fileType == AUDIO_FILE_WAV ? AUDIO_RECORDER_SECTOR : 0;
+
+    m_filename = filename.empty() ? generateFilename() : filename;
+    std::wstring path = StringUtils::utf8ToWide(m_filename);
+    m_file = CreateFileW(path.c_str(), GENERIC_WRITE, FILE_SHARE_READ, NULL, CREATE_ALWAYS,
+                         FILE_ATTRIBUTE_NORMAL | FILE_FLAG_NO_BUFFERING | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (m_file == INVALID_HANDLE_VALUE) return false;
+
+    // Bufory zapisu bez buforowania muszą być wyrównane do sektora — strona wystarcza
+    size_t chunkBytes = RECORDER_CHUNK * m_blockAlign;
+    m_stagingSize = AUDIO_RECORDER_BLOCK + (chunkBytes + AUDIO_RECORDER_SECTOR - 1) / AUDIO_RECORDER_SECTOR * AUDIO_RECORDER_SECTOR;
+    m_staging = (uint8_t*)VirtualAlloc(NULL, m_stagingSize, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+    m_header  = (uint8_t*)VirtualAlloc(NULL, AUDIO_RECORDER_SECTOR, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+    m_stopEvent = CreateEvent(NULL, TRUE, FALSE, NULL);
+    if (!m_staging || !m_header || !m_stopEvent) {
+        m_recording = true;     // finish() sprząta częściowy start
+        finish();
+        return false;
+    }
+    m_planar.assign((size_t)m_channels * RECORDER_CHUNK, 0.0f);
+
+    for (int ch = 0; ch < m_channels; ch++) {
+        m_rings[ch] = &engine.getInputCapture(ch);
+        m_rings[ch]->pin();             // Bez realokacji pod wątkiem zapisu
+    }
+    m_startPosition     = m_rings[0]->writePosition();
+    m_position          = m_startPosition;
+    m_dataBytes         = 0;
+    m_blocksSinceHeader = 0;
+    m_stagingFill       = 0;
+    m_inGap             = false;
+    m_frames            = 0;
+    m_droppedFrames     = 0;
+    m_dropEvents        = 0;
+    m_error             = false;
+    m_recording         = true;
+
+    // Nagłówek zajmuje pierwszy sektor — dane zaczynają się wyrównane
+    if (m_headerBytes) {
+        buildHeader(0);
+        if (!writeBlock(m_header, m_headerBytes)) {
+            finish();
+            return false;
+        }
+    }
+
+    m_thread = CreateThread(NULL, 0, writerThreadProc, this, 0, NULL);
+    if (!m_thread) {
+        finish();
+        return false;
+    }
+    return true;
+}
+
+void AudioRecorder::stop() {
+    if (!m_recording) return;
+
+    if (m_thread) {
+        SetEvent(m_stopEvent);
+        WaitForSingleObject(m_thread, INFINITE);    // Ostatni drain() — do chwili stop()
+        CloseHandle(m_thread);
+        m_thread = NULL;
+    }
+    finish();
+}
+
+void AudioRecorder::finish() {
+    // Ostatni niepełny blok — dopełniony zerami do sektora (zapis bez buforowania)
+    if (m_file != INVALID_HANDLE_VALUE && m_staging && m_stagingFill && !m_error) {
+        size_t bytes = (m_stagingFill + AUDIO_RECORDER_SECTOR - 1) / AUDIO_RECORDER_SECTOR * AUDIO_RECORDER_SECTOR;
+        memset(m_staging + m_stagingFill, 0, bytes - m_stagingFill);
+        if (writeBlock(m_staging, bytes)) m_dataBytes += m_stagingFill;
+        else m_error = true;
+    }
+    m_stagingFill = 0;
+
+    if (m_file != INVALID_HANDLE_VALUE) {
+        CloseHandle(m_file);
+        m_file = INVALID_HANDLE_VALUE;
+
+        // Prawdziwa długość i końcowy nagłówek — zwykły uchwyt, dowolne przesunięcia.
+        // Nieparzysta długość danych: bajt wyrównania (zero z dopełnienia) zostaje w pliku.
+        std::wstring path = StringUtils::utf8ToWide(m_filename);
+        HANDLE h = CreateFileW(path.c_str(), GENERIC_WRITE, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                               FILE_ATTRIBUTE_NORMAL, NULL);
+        if (h != INVALID_HANDLE_VALUE) {
+            LARGE_INTEGER pos;
+            pos.QuadPart = (LONGLONG)(m_headerBytes + m_dataBytes + (m_headerBytes ? (m_dataBytes & 1) : 0));
+            SetFilePointerEx(h, pos, NULL, FILE_BEGIN);
+            SetEndOfFile(h);
+            if (m_headerBytes && m_header) {
+                buildHeader(m_dataBytes);
+                DWORD written = 0;
+                pos.QuadPart = 0;
+                SetFilePointerEx(h, pos, NULL, FILE_BEGIN);
+                WriteFile(h, m_header, m_headerBytes, &written, NULL);
+            }
+            CloseHandle(h);
+        }
+    }
+    if (m_blockAlign) m_frames = m_dataBytes / m_blockAlign;
+
+    if (m_staging) VirtualFree(m_staging, 0, MEM_RELEASE);
+    if (m_header)  VirtualFree(m_header, 0, MEM_RELEASE);
+    m_staging = nullptr;
+    m_header  = nullptr;
+    if (m_stopEvent) {
+        CloseHandle(m_stopEvent);
+        m_stopEvent = NULL;
+    }
+    for (AudioCaptureRing*& ring : m_rings) {
+        if (ring) ring->unpin();
+        ring = nullptr;
+    }
+    m_recording = false;
+}
+
+// ============================================================================
+// Wątek zapisu
+// ============================================================================
+DWORD WINAPI AudioRecorder::writerThreadProc(LPVOID param) {
+    AudioRecorder* self = (AudioRecorder*)param;
+    for (;;) {
+        bool stopping = WaitForSingleObject(self->m_stopEvent, AUDIO_RECORDER_POLL_MS) == WAIT_OBJECT_0;
+        self->drain();
+        if (stopping || self->m_error) break;
+    }
+    return 0;
+}
+
+// Próbki [position, position + count) jednego kanału; nadpisane zanim zdążyliśmy
+// je przeczytać są zastępowane zerami. Zwraca liczbę utraconych.
+size_t AudioRecorder::readAligned(AudioCaptureRing& ring, uint64_t position, size_t count, float* out) {
+    AudioCaptureRing::Reader reader;
+    reader.position = position;
+    size_t got = ring.read(reader, out, count);
+    size_t lost = reader.overruns < count ? (size_t)reader.overruns : count;
+    if (lost) {
+        // Odczyt zaczął się dalej — przesuń na właściwe miejsce, resztę okna poza nim odrzuć
+        if (got > count - lost) got = count - lost;
+        memmove(out + lost, out, got * sizeof(float));
+        memset(out, 0, lost * sizeof(float));
+    }
+    if (lost + got < count) {
+        memset(out + lost + got, 0, (count - lost - got) * sizeof(float));
+        lost = count - got;
+    }
+    return lost;
+}
+
+void AudioRecorder::drain() {
+    while (!m_error) {
+        // Kanały zapisywane po kolei — czytamy tylko ramki obecne już we wszystkich
+        uint64_t end = m_rings[0]->writePosition();
+        for (int ch = 1; ch < m_channels; ch++) {
+            uint64_t e = m_rings[ch]->writePosition();
+            if (e < end) end = e;
+        }
+        if (end <= m_position) break;
+        size_t n = end - m_position < RECORDER_CHUNK ? (size_t)(end - m_position) : RECORDER_CHUNK;
+
+        float* planes[AUDIO_MAX_CHANNELS];
+        size_t lost = 0;
+        for (int ch = 0; ch < m_channels; ch++) {
+            planes[ch] = &m_planar[(size_t)ch * RECORDER_CHUNK];
+            size_t l = readAligned(*m_rings[ch], m_position, n, planes[ch]);
+            if (l > lost) lost = l;
+        }
+        if (lost) {
+            m_droppedFrames += lost;
+            if (!m_inGap) m_dropEvents++;
+        }
+        m_inGap = lost != 0;
+
+        // Dokładna odwrotność konwersji wejścia — PCM zapisany bit w bit
+        AudioFormat::interleave(planes, m_channels, n, m_format, m_staging + m_stagingFill, true);
+        m_stagingFill += n * m_blockAlign;
+        m_position    += n;
+        m_frames      += n;
+
+        if (m_stagingFill >= AUDIO_RECORDER_BLOCK) {
+            if (!writeBlock(m_staging, AUDIO_RECORDER_BLOCK)) {
+                m_error = true;
+                break;
+            }
+            m_dataBytes += AUDIO_RECORDER_BLOCK;
+            m_stagingFill -= AUDIO_RECORDER_BLOCK;
+            memmove(m_staging, m_staging + AUDIO_RECORDER_BLOCK, m_stagingFill);
+
+            if (m_headerBytes && ++m_blocksSinceHeader >= AUDIO_RECORDER_HEADER_EVERY) {
+                m_blocksSinceHeader = 0;
+                buildHeader(m_dataBytes);
+                if (!writeHeader()) m_error = true;
+            }
+        }
+    }
+}
+
+bool AudioRecorder::writeBlock(const uint8_t* data, size_t bytes) {
+    DWORD written = 0;
+    return WriteFile(m_file, data, (DWORD)bytes, &written, NULL) && written == bytes;
+}
+
+// Odświeżenie nagłówka w trakcie nagrania — pierwszy sektor, potem powrót na koniec
+bool AudioRecorder::writeHeader() {
+    LARGE_INTEGER pos;
+    pos.QuadPart = 0;
+    if (!SetFilePointerEx(m_file, pos, NULL, FILE_BEGIN)) return false;
+    bool ok = writeBlock(m_header, m_headerBytes);
+    pos.QuadPart = (LONGLONG)(m_headerBytes + m_dataBytes);
+    return SetFilePointerEx(m_file, pos, NULL, FILE_BEGIN) && ok;
+}
+
+// ============================================================================
+// Nagłówek WAV / RF64 — zawsze AUDIO_RECORDER_SECTOR bajtów:
+// RIFF|RF64, JUNK|ds64 (miejsce na rozmiary 64-bit), fmt, JUNK (dopełnienie), data
+// ============================================================================
+static uint8_t* put16(uint8_t* p, uint32_t v) { p[0] = (uint8_t)v; p[1] = (uint8_t)(v >> 8); return p + 2; }
+static uint8_t* put32(uint8_t* p, uint32_t v) { return put16(put16(p, v & 0xFFFF), v >> 16); }
+static uint8_t* put64(uint8_t* p, uint64_t v) { return put32(put32(p, (uint32_t)v), (uint32_t)(v >> 32)); }
+static uint8_t* putTag(uint8_t* p, const char* tag) { memcpy(p, tag, 4); return p + 4; }
+
+void AudioRecorder::buildHeader(uint64_t dataBytes) {
+    memset(m_header, 0, AUDIO_RECORDER_SECTOR);
+    uint64_t riffSize = m_headerBytes + dataBytes + (dataBytes & 1) - 8;
+    bool rf64 = riffSize > 0xFFFFFFFFull;
+    bool extensible = !(m_format == AUDIO_FORMAT_PCM16 && m_channels <= 2);
+    uint32_t bits = (uint32_t)AudioFormat::bitsPerSample(m_format);
+
+    uint8_t* p = m_header;
+    p = putTag(p, rf64 ? "RF64" : "RIFF");
+    p = put32(p, rf64 ? 0xFFFFFFFFu : (uint32_t)riffSize);
+    p = putTag(p, "WAVE");
+
+    // ds64 po przekroczeniu 4 GB, wcześniej ten sam obszar jako JUNK
+    p = putTag(p, rf64 ? "ds64" : "JUNK");
+    p = put32(p, 28);
+    if (rf64) {
+        p = put64(p, riffSize);
+        p = put64(p, dataBytes);
+        p = put64(p, dataBytes / m_blockAlign);
+        p = put32(p, 0);                        // Brak tablicy innych rozmiarów
+    } else {
+        p += 28;
+    }
+
+    p = putTag(p, "fmt ");
+    p = put32(p, extensible ? 40 : 16);
+    p = put16(p, extensible ? 0xFFFE : 1);
+    p = put16(p, (uint32_t)m_channels);
+    p = put32(p, m_sampleRate);
+    p = put32(p, m_sampleRate * m_blockAlign);
+    p = put16(p, m_blockAlign);
+    p = put16(p, bits);
+    if (extensible) {
+        p = put16(p, 22);
+        p = put16(p, bits);
+        p = put32(p, m_channels == 1 ? 0x4 : (uint32_t)((1u << m_channels) - 1));    // Jak AudioEngine
+        // KSDATAFORMAT_SUBTYPE_PCM / _IEEE_FLOAT
+        static const uint8_t tail[14] = { 0x00, 0x00, 0x00, 0x00, 0x10, 0x00,
+                                          0x80, 0x00, 0x00, 0xaa, 0x00, 0x38, 0x9b, 0x71 };
+        p = put16(p, m_format == AUDIO_FORMAT_FLOAT32 ? 3 : 1);
+        memcpy(p, tail, sizeof(tail));
+        p += sizeof(tail);
+    }
+
+    // Dopełnienie — dane zaczynają się dokładnie na granicy sektora
+    uint8_t* data = m_header + AUDIO_RECORDER_SECTOR - 8;
+    p = putTag(p, "JUNK");
+    put32(p, (uint32_t)(data - (p + 4)));
+
+    p = putTag(data, "data");
+    put32(p, rf64 ? 0xFFFFFFFFu : (uint32_t)dataBytes);
+}
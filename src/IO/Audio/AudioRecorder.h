@@ -0,0 +1,127 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 JAQUBA (https://github.com/JAQUBA)
+// Part of JQB_WindowsLib — https://github.com/JAQUBA/JQB_WindowsLib
+
+/**
+ * AudioRecorder.h — Zapis pełnego strumienia wejścia AudioEngine do WAV / RAW
+ *
+ * Osobny wątek zapisu czyta pierścienie AudioCaptureRing (własne kursory),
+ * przeplata kanały i zapisuje bloki po AUDIO_RECORDER_BLOCK bajtów bez
+ * buforowania systemu (FILE_FLAG_NO_BUFFERING, wyrównane do 4096). Wątek
+ * audio nic o nagrywaniu nie wie — nigdy nie czeka na dysk.
+ *
+ * Jeśli dysk nie nadąża dłużej, niż mieści pierścień, utracone próbki są
+ * zastępowane ciszą (oś czasu pliku zgodna z zegarem), a ich liczba trafia
+ * do getDroppedFrames() / getDropEvents(). Plik > 4 GB zapisywany jest jako
+ * RF64 (EBU Tech 3306) — nagłówek WAV ma zarezerwowane miejsce na ds64.
+ * Nagłówek jest odświeżany co AUDIO_RECORDER_HEADER_EVERY bloków — po awarii
+ * plik jest czytelny do ostatniego odświeżenia. Tylko Windows (CreateFileW).
+ */
+
+#ifndef AUDIO_RECORDER_H
+#define AUDIO_RECORDER_H
+
+#include <windows.h>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "AudioEngine.h"
+
+#define AUDIO_RECORDER_BLOCK        (1 << 20)   // Bajtów na zapis (wielokrotność sektora)
+#define AUDIO_RECORDER_SECTOR       4096        // Wyrównanie zapisu bez buforowania
+#define AUDIO_RECORDER_HEADER_EVERY 16          // Odświeżanie nagłówka co 16 MB
+#define AUDIO_RECORDER_POLL_MS      50
+
+enum AudioFileType {
+    AUDIO_FILE_WAV = 0,         // WAV, RF64 above 4 GB
+    AUDIO_FILE_RAW              // Interleaved samples only, no header
+};
+
+class AudioRecorder {
+public:
+    /**
+     * @param filenamePrefix Prefiks nazwy auto-generowanego pliku (np. "sensor")
+     */
+    explicit AudioRecorder(const std::string& filenamePrefix = "audio");
+    ~AudioRecorder();
+
+    // Before start()
+    void setFileType(AudioFileType type) { m_fileType = type; }
+    // File sample format; default: the format the input stream was started with
+    void setSampleFormat(AudioSampleFormat format) { m_sampleFormat = format; m_formatSet = true; }
+
+    /**
+     * Rozpoczyna zapis wejścia (musi działać) od najnowszej próbki.
+     * @param filename Ścieżka UTF-8 (pusty → auto-generowana z timestampem)
+     * @return true jeśli plik utworzono i wątek zapisu wystartował
+     */
+    bool start(AudioEngine& engine, const std::string& filename = "");
+    /** Dopisuje resztę, finalizuje nagłówek (RIFF / RF64) i zamyka plik */
+    void stop();
+
+    bool isRecording() const { return m_recording; }
+    const std::string& getFilename() const { return m_filename; }
+
+    // Progress — safe from any thread while recording
+    uint64_t getFramesWritten() const { return m_frames.load(std::memory_order_relaxed); }
+    uint64_t getBytesWritten()  const { return m_frames.load(std::memory_order_relaxed) * m_blockAlign; }
+    double   getDurationSeconds() const;
+    // Capture sequence number of the first frame in the file — frame i of the
+    // file is AudioCaptureRing sample getStartPosition() + i (aligns CSV rows)
+    uint64_t getStartPosition() const { return m_startPosition; }
+    // Frames lost because the writer fell more than the ring capacity behind
+    // (replaced by silence), and the number of such gaps
+    uint64_t getDroppedFrames() const { return m_droppedFrames.load(std::memory_order_relaxed); }
+    uint32_t getDropEvents()    const { return m_dropEvents.load(std::memory_order_relaxed); }
+    // Write failed (e.g. disk full) — nothing more is written; stop() keeps what is on disk
+    bool     hasError() const { return m_error.load(std::memory_order_relaxed); }
+
+private:
+    std::string   m_filenamePrefix;
+    std::string   m_filename;
+    AudioFileType m_fileType;
+    AudioSampleFormat m_sampleFormat;
+    bool          m_formatSet;
+    bool          m_recording;
+
+    // Stały przez czas nagrania
+    AudioCaptureRing* m_rings[AUDIO_MAX_CHANNELS];
+    int           m_channels;
+    uint32_t      m_sampleRate;
+    AudioSampleFormat m_format;
+    uint32_t      m_blockAlign;
+    uint32_t      m_headerBytes;        // 0 (RAW) lub AUDIO_RECORDER_SECTOR
+    uint64_t      m_startPosition;
+
+    // Wątek zapisu
+    HANDLE        m_file;
+    HANDLE        m_thread;
+    HANDLE        m_stopEvent;
+    uint64_t      m_position;           // Następna ramka do odczytu z pierścieni
+    uint64_t      m_dataBytes;          // Zapisane na dysk (pełne bloki)
+    uint32_t      m_blocksSinceHeader;
+    uint8_t*      m_staging;            // Wyrównany do strony (VirtualAlloc)
+    size_t        m_stagingSize;
+    size_t        m_stagingFill;
+    uint8_t*      m_header;             // AUDIO_RECORDER_SECTOR bajtów, wyrównany
+    std::vector<float> m_planar;
+    bool          m_inGap;              // Poprzedni odczyt też stracił próbki — ta sama luka
+
+    std::atomic<uint64_t> m_frames;
+    std::atomic<uint64_t> m_droppedFrames;
+    std::atomic<uint32_t> m_dropEvents;
+    std::atomic<bool>     m_error;
+
+    std::string generateFilename() const;
+    void   buildHeader(uint64_t dataBytes);
+    bool   writeHeader();
+    bool   writeBlock(const uint8_t* data, size_t bytes);
+    void   drain();
+    size_t readAligned(AudioCaptureRing& ring, uint64_t position, size_t count, float* out);
+    void   finish();
+
+    static DWORD WINAPI writerThreadProc(LPVOID param);
+};
+
+#endif // AUDIO_RECORDER_H
@@ -0,0 +1,107 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 JAQUBA (https://github.com/JAQUBA)
+// Part of JQB_WindowsLib — https://github.com/JAQUBA/JQB_WindowsLib
+
+/**
+ * AudioSnapshot.h — wait-free triple buffer for publishing sample snapshots
+ *
+ * One writer (audio thread) and one reader (UI thread), three slots. The
+ * writer fills its private back slot and publishes it with a single atomic
+ * exchange against the shared middle slot; the reader takes the middle slot
+ * the same way. Neither side ever waits for the other — a slow UI only skips
+ * snapshots, it can never stall the audio thread.
+ *
+ * The reader owns its front slot until the next read()/borrow(), so
+ * borrow() hands out a pointer to the samples without copying. A slot may
+ * hold several planes of `capacity` values (e.g. value, min, max) published
+ * together.
+ *
+ * Nie korzysta z WinAPI, std::thread ani std::mutex — bezpieczne dla MinGW.org.
+ */
+
+#ifndef AUDIO_SNAPSHOT_H
+#define AUDIO_SNAPSHOT_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+class AudioSnapshot {
+public:
+    explicit AudioSnapshot(int capacity, int planes = 1)
+        : m_capacity(0), m_planes(0), m_middle(1), m_back(0), m_front(2)
+    {
+        resize(capacity, planes);
+    }
+
+    // Drops published data. Not thread-safe — only while nothing writes or
+    // reads; previously borrowed pointers are invalid if the size changed.
+    void resize(int capacity, int planes) {
+        if (capacity != m_capacity || planes != m_planes) {
+            for (Slot& s : m_slots) s.data.assign((size_t)capacity * (size_t)planes, 0.0);
+            m_capacity = capacity;
+            m_planes   = planes;
+        }
+        for (Slot& s : m_slots) s.count = 0;
+        m_middle.store(1, std::memory_order_relaxed);
+        m_back  = 0;
+        m_front = 2;
+    }
+
+    int capacity() const { return m_capacity; }
+    int planes()   const { return m_planes; }
+
+    // ---- Writer (one thread) ----
+    // Back slot — exclusively the writer's until publish()
+    double* beginWrite(int plane = 0) { return m_slots[m_back].data.data() + (size_t)plane * m_capacity; }
+    void publish(int count) {
+        m_slots[m_back].count = count;
+        // Wymiana z middle: nasz slot staje się najnowszym, poprzedni middle — nowym back
+        m_back = m_middle.exchange(m_back | FRESH, std::memory_order_acq_rel) & INDEX;
+    }
+
+    // ---- Reader (one thread) ----
+    // Latest published snapshot, zero-copy. Returns true if it is new since the
+    // previous read()/borrow(); data stays valid until the next read()/borrow().
+    bool borrow(const double*& data, int& count) {
+        bool fresh = (m_middle.load(std::memory_order_relaxed) & FRESH) != 0;
+        if (fresh) m_front = m_middle.exchange(m_front, std::memory_order_acq_rel) & INDEX;
+        data  = m_slots[m_front].data.data();
+        count = m_slots[m_front].count;
+        return fresh;
+    }
+
+    // Plane of the snapshot returned by the last borrow()/read()
+    const double* borrowed(int plane) const { return m_slots[m_front].data.data() + (size_t)plane * m_capacity; }
+
+    // Copy of the latest snapshot, only if it is new (returns false otherwise)
+    bool read(double* buffer, int maxSamples, int& outCount) {
+        const double* data;
+        int count;
+        if (!borrow(data, count)) return false;
+        if (count > maxSamples) count = maxSamples;
+        memcpy(buffer, data, (size_t)count * sizeof(double));
+        outCount = count;
+        return true;
+    }
+
+private:
+    static const uint32_t INDEX = 3;
+    static const uint32_t FRESH = 4;    // middle opublikowany, jeszcze nieodebrany
+
+    struct Slot {
+        std::vector<double> data;
+        int count;
+    };
+
+    Slot m_slots[3];
+    int  m_capacity;
+    int  m_planes;
+    // Oddzielne linie cache: indeks wspólny oraz prywatne indeksy obu stron
+    alignas(64) std::atomic<uint32_t> m_middle;
+    alignas(64) uint32_t m_back;        // Tylko pisarz
+    alignas(64) uint32_t m_front;       // Tylko czytelnik
+};
+
+#endif // AUDIO_SNAPSHOT_H
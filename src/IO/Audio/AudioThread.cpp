@@ -0,0 +1,156 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 JAQUBA (https://github.com/JAQUBA)
+// Part of JQB_WindowsLib — https://github.com/JAQUBA/JQB_WindowsLib
+
+#include "AudioThread.h"
+
+#ifdef _WIN32
+
+// ============================================================================
+// Win32
+// ============================================================================
+AudioThread::AudioThread() : m_handle(NULL), m_proc(nullptr), m_param(nullptr) {}
+
+AudioThread::~AudioThread() {
+    join();
+}
+
+DWORD WINAPI AudioThread::entry(LPVOID param) {
+    AudioThread* self = (AudioThread*)param;
+    self->m_proc(self->m_param);
+    return 0;
+}
+
+bool AudioThread::start(Proc proc, void* param) {
+    if (m_handle) return false;
+    m_proc  = proc;
+    m_param = param;
+    m_handle = CreateThread(NULL, 0, entry, this, 0, NULL);
+    return m_handle != NULL;
+}
+
+void AudioThread::join() {
+    if (!m_handle) return;
+    WaitForSingleObject(m_handle, INFINITE);
+    CloseHandle(m_handle);
+    m_handle = NULL;
+}
+
+bool AudioThread::started() const {
+    return m_handle != NULL;
+}
+
+AudioEvent::AudioEvent() : m_handle(CreateEvent(NULL, FALSE, FALSE, NULL)) {}
+
+AudioEvent::~AudioEvent() {
+    if (m_handle) CloseHandle(m_handle);
+}
+
+void AudioEvent::set() {
+    SetEvent(m_handle);
+}
+
+bool AudioEvent::wait(uint32_t timeoutMs) {
+    return WaitForSingleObject(m_handle, timeoutMs) == WAIT_OBJECT_0;
+}
+
+AudioLock::AudioLock() {
+    InitializeCriticalSection(&m_section);
+}
+
+AudioLock::~AudioLock() {
+    DeleteCriticalSection(&m_section);
+}
+
+void AudioLock::lock() {
+    EnterCriticalSection(&m_section);
+}
+
+void AudioLock::unlock() {
+    LeaveCriticalSection(&m_section);
+}
+
+int64_t AudioClock::now() {
+    LARGE_INTEGER t;
+    QueryPerformanceCounter(&t);
+    return (int64_t)t.QuadPart;
+}
+
+int64_t AudioClock::frequency() {
+    static const int64_t frequency = [] {
+        LARGE_INTEGER f;
+        QueryPerformanceFrequency(&f);
+        return (int64_t)f.QuadPart;
+    }();
+    return frequency;
+}
+
+#else
+
+// ============================================================================
+// std::thread / std::condition_variable (poza Windows)
+// ============================================================================
+#include <chrono>
+
+AudioThread::AudioThread() {}
+
+AudioThread::~AudioThread() {
+    join();
+}
+
+bool AudioThread::start(Proc proc, void* param) {
+    if (m_thread.joinable()) return false;
+    m_thread = std::thread(proc, param);
+    return true;
+}
+
+void AudioThread::join() {
+    if (m_thread.joinable()) m_thread.join();
+}
+
+bool AudioThread::started() const {
+    return m_thread.joinable();
+}
+
+AudioEvent::AudioEvent() : m_signalled(false) {}
+
+AudioEvent::~AudioEvent() {}
+
+void AudioEvent::set() {
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_signalled = true;
+    }
+    m_cond.notify_one();
+}
+
+bool AudioEvent::wait(uint32_t timeoutMs) {
+    std::unique_lock<std::mutex> guard(m_mutex);
+    bool signalled = m_cond.wait_for(guard, std::chrono::milliseconds(timeoutMs),
+                                     [this] { return m_signalled; });
+    m_signalled = false;
+    return signalled;
+}
+
+AudioLock::AudioLock() {}
+
+AudioLock::~AudioLock() {}
+
+void AudioLock::lock() {
+    m_mutex.lock();
+}
+
+void AudioLock::unlock() {
+    m_mutex.unlock();
+}
+
+int64_t AudioClock::now() {
+    return (int64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+int64_t AudioClock::frequency() {
+    return 1000000000;
+}
+
+#endif
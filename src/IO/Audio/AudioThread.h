@@ -0,0 +1,102 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 JAQUBA (https://github.com/JAQUBA)
+// Part of JQB_WindowsLib — https://github.com/JAQUBA/JQB_WindowsLib
+
+/**
+ * AudioThread.h — wątek, zdarzenie, blokada i zegar dla ścieżki audio
+ *
+ * Na Windows: CreateThread, zdarzenia Win32, CRITICAL_SECTION,
+ * QueryPerformanceCounter (MinGW.org nie ma std::thread / std::mutex).
+ * Gdzie indziej: std::thread, std::condition_variable, std::mutex,
+ * steady_clock. Dzięki temu AudioEngine z AudioNullBackend /
+ * AudioLoopbackBackend (i AudioMeter) kompiluje się i działa bez WinAPI —
+ * testy i benchmarki na Linuksie (tools/audio_backend_bench).
+ */
+
+#ifndef AUDIO_THREAD_H
+#define AUDIO_THREAD_H
+
+#include <cstdint>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
+// One worker thread; join() waits for proc to return
+class AudioThread {
+public:
+    typedef void (*Proc)(void* param);
+
+    AudioThread();
+    ~AudioThread();                 // join()
+
+    bool start(Proc proc, void* param);
+    void join();
+    bool started() const;
+
+private:
+    AudioThread(const AudioThread&) = delete;
+    AudioThread& operator=(const AudioThread&) = delete;
+
+#ifdef _WIN32
+    HANDLE m_handle;
+    Proc   m_proc;
+    void*  m_param;
+    static DWORD WINAPI entry(LPVOID param);
+#else
+    std::thread m_thread;
+#endif
+};
+
+// Auto-reset event: set() releases one wait() (now or the next one)
+class AudioEvent {
+public:
+    AudioEvent();
+    ~AudioEvent();
+
+    void set();
+    bool wait(uint32_t timeoutMs);  // true = signalled, false = timeout
+
+private:
+    AudioEvent(const AudioEvent&) = delete;
+    AudioEvent& operator=(const AudioEvent&) = delete;
+
+#ifdef _WIN32
+    HANDLE m_handle;
+#else
+    std::mutex m_mutex;
+    std::condition_variable m_cond;
+    bool m_signalled;
+#endif
+};
+
+class AudioLock {
+public:
+    AudioLock();
+    ~AudioLock();
+
+    void lock();
+    void unlock();
+
+private:
+    AudioLock(const AudioLock&) = delete;
+    AudioLock& operator=(const AudioLock&) = delete;
+
+#ifdef _WIN32
+    CRITICAL_SECTION m_section;
+#else
+    std::mutex m_mutex;
+#endif
+};
+
+// Monotonic clock in ticks (QueryPerformanceCounter / steady_clock)
+namespace AudioClock {
+int64_t now();
+int64_t frequency();                // ticks per second
+}
+
+#endif // AUDIO_THREAD_H
@@ -0,0 +1,299 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 JAQUBA (https://github.com/JAQUBA)
+// Part of JQB_WindowsLib — https://github.com/JAQUBA/JQB_WindowsLib
+
+#include "AudioWinMMBackend.h"
+
+#ifdef _WIN32
+
+// Po preferowanej częstotliwości — kolejno malejąco
+static const uint32_t FALLBACK_RATES[] = { 192000, 96000, 48000, 44100 };
+static const int      FALLBACK_COUNT   = 4;
+
+// KSDATAFORMAT_SUBTYPE_PCM / _IEEE_FLOAT — bez ksmedia.h i INITGUID
+static const GUID SUBTYPE_PCM        = { 0x00000001, 0x0000, 0x0010, { 0x80, 0x00, 0x00, 0xaa, 0x00, 0x38, 0x9b, 0x71 } };
+static const GUID SUBTYPE_IEEE_FLOAT = { 0x00000003, 0x0000, 0x0010, { 0x80, 0x00, 0x00, 0xaa, 0x00, 0x38, 0x9b, 0x71 } };
+
+AudioWinMMBackend::AudioWinMMBackend()
+    : m_hWaveOut(NULL)
+    , m_outputEvent(NULL)
+    , m_outNext(0)
+    , m_outPrimed(0)
+    , m_outBlockAlign(0)
+    , m_outUnderruns(0)
+    , m_hWaveIn(NULL)
+    , m_inputEvent(NULL)
+    , m_inNext(0)
+    , m_inBlockAlign(0)
+    , m_inOverruns(0)
+{
+    ZeroMemory(&m_wfx, sizeof(m_wfx));
+}
+
+AudioWinMMBackend::~AudioWinMMBackend() {
+    closeOutput();
+    closeInput();
+}
+
+void AudioWinMMBackend::initFormat(const AudioStreamConfig& config) {
+    ZeroMemory(&m_wfx, sizeof(m_wfx));
+    WAVEFORMATEX& wfx = m_wfx.Format;
+    wfx.nChannels        = (WORD)config.channels;
+    wfx.nSamplesPerSec   = config.sampleRate;
+    wfx.wBitsPerSample   = (WORD)AudioFormat::bitsPerSample(config.format);
+    wfx.nBlockAlign      = (WORD)config.blockAlign();
+    wfx.nAvgBytesPerSec  = config.sampleRate * wfx.nBlockAlign;
+
+    if (config.format == AUDIO_FORMAT_PCM16 && config.channels <= 2) {
+        wfx.wFormatTag = WAVE_FORMAT_PCM;
+        wfx.cbSize     = 0;
+        return;
+    }
+
+    // Więcej niż 2 kanały, 24 bity lub float — wymagany WAVE_FORMAT_EXTENSIBLE
+    wfx.wFormatTag = WAVE_FORMAT_EXTENSIBLE;
+    wfx.cbSize     = sizeof(WAVEFORMATEXTENSIBLE) - sizeof(WAVEFORMATEX);
+    m_wfx.Samples.wValidBitsPerSample = wfx.wBitsPerSample;
+    // Kolejność głośników Windows: FL, FR, FC, LFE, BL, BR, FLC, FRC — mono na środek
+    m_wfx.dwChannelMask = config.channels == 1 ? SPEAKER_FRONT_CENTER : (DWORD)((1u << config.channels) - 1);
+    m_wfx.SubFormat     = config.format == AUDIO_FORMAT_FLOAT32 ? SUBTYPE_IEEE_FLOAT : SUBTYPE_PCM;
+}
+
+// Pozycja urządzenia w ramkach (modulo 2^32); false gdy sterownik nie podaje
+// ani próbek, ani bajtów
+static bool positionToSamples(const MMTIME& mmt, uint32_t blockAlign, uint32_t& samples) {
+    if (mmt.wType == TIME_SAMPLES) { samples = mmt.u.sample; return true; }
+    if (mmt.wType == TIME_BYTES)   { samples = mmt.u.cb / blockAlign; return true; }
+    return false;
+}
+
+// ============================================================================
+// Device Enumeration
+// ============================================================================
+std::vector<std::string> AudioWinMMBackend::enumOutputDevices() {
+    std::vector<std::string> devices;
+    UINT count = waveOutGetNumDevs();
+    for (UINT i = 0; i < count; i++) {
+        WAVEOUTCAPSW caps;
+        if (waveOutGetDevCapsW(i, &caps, sizeof(caps)) == MMSYSERR_NOERROR) {
+            char name[128];
+            WideCharToMultiByte(CP_UTF8, 0, caps.szPname, -1, name, 128, NULL, NULL);
+            devices.push_back(name);
+        }
+    }
+    return devices;
+}
+
+std::vector<std::string> AudioWinMMBackend::enumInputDevices() {
+    std::vector<std::string> devices;
+    UINT count = waveInGetNumDevs();
+    for (UINT i = 0; i < count; i++) {
+        WAVEINCAPSW caps;
+        if (waveInGetDevCapsW(i, &caps, sizeof(caps)) == MMSYSERR_NOERROR) {
+            char name[128];
+            WideCharToMultiByte(CP_UTF8, 0, caps.szPname, -1, name, 128, NULL, NULL);
+            devices.push_back(name);
+        }
+    }
+    return devices;
+}
+
+// ============================================================================
+// Output — waveOut
+// ============================================================================
+bool AudioWinMMBackend::openOutput(int device, AudioStreamConfig& config) {
+    if (m_hWaveOut) return false;
+
+    m_outputEvent = CreateEvent(NULL, FALSE, FALSE, NULL);
+    if (!m_outputEvent) return false;
+
+    // Najpierw preferowana częstotliwość, potem kolejne z listy
+    uint32_t preferred = config.sampleRate;
+    bool opened = false;
+    for (int r = -1; r < FALLBACK_COUNT && !opened; r++) {
+        if (r >= 0 && FALLBACK_RATES[r] == preferred) continue;
+        config.sampleRate = r < 0 ? preferred : FALLBACK_RATES[r];
+        initFormat(config);
+        opened = waveOutOpen(&m_hWaveOut, (UINT)device, &m_wfx.Format,
+                             (DWORD_PTR)m_outputEvent, 0, CALLBACK_EVENT) == MMSYSERR_NOERROR;
+    }
+    if (!opened) {
+        m_hWaveOut = NULL;
+        config.sampleRate = preferred;
+        CloseHandle(m_outputEvent);
+        m_outputEvent = NULL;
+        return false;
+    }
+
+    size_t bufferBytes = config.bufferBytes();
+    m_outData.assign((size_t)config.numBuffers * bufferBytes, 0);
+    m_outHeaders.assign(config.numBuffers, WAVEHDR());
+    for (int i = 0; i < config.numBuffers; i++) {
+        ZeroMemory(&m_outHeaders[i], sizeof(WAVEHDR));
+        m_outHeaders[i].lpData         = &m_outData[i * bufferBytes];
+        m_outHeaders[i].dwBufferLength = (DWORD)bufferBytes;
+        waveOutPrepareHeader(m_hWaveOut, &m_outHeaders[i], sizeof(WAVEHDR));
+    }
+    m_outNext       = 0;
+    m_outPrimed     = config.numBuffers;
+    m_outBlockAlign = (uint32_t)config.blockAlign();
+    m_outUnderruns  = 0;
+    return true;
+}
+
+void AudioWinMMBackend::closeOutput() {
+    if (m_hWaveOut) {
+        waveOutReset(m_hWaveOut);
+        for (WAVEHDR& header : m_outHeaders) {
+            waveOutUnprepareHeader(m_hWaveOut, &header, sizeof(WAVEHDR));
+        }
+        m_outHeaders.clear();
+        waveOutClose(m_hWaveOut);
+        m_hWaveOut = NULL;
+    }
+
+    if (m_outputEvent) {
+        CloseHandle(m_outputEvent);
+        m_outputEvent = NULL;
+    }
+}
+
+char* AudioWinMMBackend::waitOutputBuffer(uint32_t timeoutMs) {
+    if (m_outHeaders.empty()) return nullptr;
+    WAVEHDR& header = m_outHeaders[m_outNext];
+    if (m_outPrimed > 0) return header.lpData;
+
+    // Kolejność kolejki: sterownik zwraca bufory po kolei, więc uzupełniamy
+    // od najstarszego — sygnał nie przeskakuje przy kilku gotowych naraz
+    if (!(header.dwFlags & WHDR_DONE)) {
+        WaitForSingleObject(m_outputEvent, timeoutMs);
+        if (!(header.dwFlags & WHDR_DONE)) return nullptr;
+    }
+
+    // Wszystkie bufory wróciły naraz — urządzenie nie miało czego grać
+    bool allDone = true;
+    for (const WAVEHDR& h : m_outHeaders) {
+        if (!(h.dwFlags & WHDR_DONE)) { allDone = false; break; }
+    }
+    if (allDone) m_outUnderruns++;
+    return header.lpData;
+}
+
+void AudioWinMMBackend::submitOutputBuffer(char*) {
+    waveOutWrite(m_hWaveOut, &m_outHeaders[m_outNext], sizeof(WAVEHDR));
+    m_outNext = (m_outNext + 1) % (int)m_outHeaders.size();
+    if (m_outPrimed > 0) m_outPrimed--;
+}
+
+void AudioWinMMBackend::wakeOutput() {
+    if (m_outputEvent) SetEvent(m_outputEvent);
+}
+
+bool AudioWinMMBackend::getOutputPosition(uint32_t& frames) const {
+    if (!m_hWaveOut) return false;
+    MMTIME mmt;
+    mmt.wType = TIME_SAMPLES;
+    return waveOutGetPosition(m_hWaveOut, &mmt, sizeof(mmt)) == MMSYSERR_NOERROR &&
+           positionToSamples(mmt, m_outBlockAlign, frames);
+}
+
+// ============================================================================
+// Input — waveIn
+// ============================================================================
+bool AudioWinMMBackend::openInput(int device, AudioStreamConfig& config) {
+    if (m_hWaveIn) return false;
+
+    m_inputEvent = CreateEvent(NULL, FALSE, FALSE, NULL);
+    if (!m_inputEvent) return false;
+
+    uint32_t preferred = config.sampleRate;
+    bool opened = false;
+    for (int r = -1; r < FALLBACK_COUNT && !opened; r++) {
+        if (r >= 0 && FALLBACK_RATES[r] == preferred) continue;
+        config.sampleRate = r < 0 ? preferred : FALLBACK_RATES[r];
+        initFormat(config);
+        opened = waveInOpen(&m_hWaveIn, (UINT)device, &m_wfx.Format,
+                            (DWORD_PTR)m_inputEvent, 0, CALLBACK_EVENT) == MMSYSERR_NOERROR;
+    }
+    if (!opened) {
+        m_hWaveIn = NULL;
+        config.sampleRate = preferred;
+        CloseHandle(m_inputEvent);
+        m_inputEvent = NULL;
+        return false;
+    }
+
+    size_t bufferBytes = config.bufferBytes();
+    m_inData.assign((size_t)config.numBuffers * bufferBytes, 0);
+    m_inHeaders.assign(config.numBuffers, WAVEHDR());
+    for (int i = 0; i < config.numBuffers; i++) {
+        ZeroMemory(&m_inHeaders[i], sizeof(WAVEHDR));
+        m_inHeaders[i].lpData         = &m_inData[i * bufferBytes];
+        m_inHeaders[i].dwBufferLength = (DWORD)bufferBytes;
+        waveInPrepareHeader(m_hWaveIn, &m_inHeaders[i], sizeof(WAVEHDR));
+        waveInAddBuffer(m_hWaveIn, &m_inHeaders[i], sizeof(WAVEHDR));
+    }
+    m_inNext       = 0;
+    m_inBlockAlign = (uint32_t)config.blockAlign();
+    m_inOverruns   = 0;
+
+    waveInStart(m_hWaveIn);
+    return true;
+}
+
+void AudioWinMMBackend::closeInput() {
+    if (m_hWaveIn) {
+        waveInStop(m_hWaveIn);
+        waveInReset(m_hWaveIn);
+        for (WAVEHDR& header : m_inHeaders) {
+            waveInUnprepareHeader(m_hWaveIn, &header, sizeof(WAVEHDR));
+        }
+        m_inHeaders.clear();
+        waveInClose(m_hWaveIn);
+        m_hWaveIn = NULL;
+    }
+
+    if (m_inputEvent) {
+        CloseHandle(m_inputEvent);
+        m_inputEvent = NULL;
+    }
+}
+
+const char* AudioWinMMBackend::waitInputBuffer(uint32_t timeoutMs, int& frames) {
+    if (m_inHeaders.empty()) return nullptr;
+    // W kolejności nagrania — strumień AudioCaptureRing musi być ciągły
+    WAVEHDR& header = m_inHeaders[m_inNext];
+    if (!(header.dwFlags & WHDR_DONE)) {
+        WaitForSingleObject(m_inputEvent, timeoutMs);
+        if (!(header.dwFlags & WHDR_DONE)) return nullptr;
+    }
+
+    // Wszystkie bufory pełne — sterownik nie miał gdzie nagrywać, próbki przepadły
+    bool allDone = true;
+    for (const WAVEHDR& h : m_inHeaders) {
+        if (!(h.dwFlags & WHDR_DONE)) { allDone = false; break; }
+    }
+    if (allDone) m_inOverruns++;
+
+    frames = (int)(header.dwBytesRecorded / m_inBlockAlign);
+    return header.lpData;
+}
+
+void AudioWinMMBackend::releaseInputBuffer() {
+    waveInAddBuffer(m_hWaveIn, &m_inHeaders[m_inNext], sizeof(WAVEHDR));
+    m_inNext = (m_inNext + 1) % (int)m_inHeaders.size();
+}
+
+void AudioWinMMBackend::wakeInput() {
+    if (m_inputEvent) SetEvent(m_inputEvent);
+}
+
+bool AudioWinMMBackend::getInputPosition(uint32_t& frames) const {
+    if (!m_hWaveIn) return false;
+    MMTIME mmt;
+    mmt.wType = TIME_SAMPLES;
+    return waveInGetPosition(m_hWaveIn, &mmt, sizeof(mmt)) == MMSYSERR_NOERROR &&
+           positionToSamples(mmt, m_inBlockAlign, frames);
+}
+
+#endif // _WIN32
@@ -0,0 +1,76 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 JAQUBA (https://github.com/JAQUBA)
+// Part of JQB_WindowsLib — https://github.com/JAQUBA/JQB_WindowsLib
+
+/**
+ * AudioWinMMBackend.h — waveOut / waveIn backend (domyślny dla AudioEngine)
+ *
+ * Bufory WAVEHDR w jednym bloku, powiadomienia CALLBACK_EVENT. Negocjacja
+ * częstotliwości: preferowana, potem 192k → 96k → 48k → 44.1k. Poza mono /
+ * stereo PCM16 format otwierany jako WAVE_FORMAT_EXTENSIBLE.
+ * Tylko Windows — gdzie indziej plik jest pusty (AudioEngine używa wtedy
+ * AudioNullBackend).
+ */
+
+#ifndef AUDIO_WINMM_BACKEND_H
+#define AUDIO_WINMM_BACKEND_H
+
+#ifdef _WIN32
+
+#include <windows.h>
+#include <mmsystem.h>
+#include <atomic>
+#include "AudioBackend.h"
+
+class AudioWinMMBackend : public AudioBackend {
+public:
+    AudioWinMMBackend();
+    ~AudioWinMMBackend() override;
+
+    std::vector<std::string> enumOutputDevices() override;
+    std::vector<std::string> enumInputDevices() override;
+
+    bool  openOutput(int device, AudioStreamConfig& config) override;
+    void  closeOutput() override;
+    char* waitOutputBuffer(uint32_t timeoutMs) override;
+    void  submitOutputBuffer(char* buffer) override;
+    void  wakeOutput() override;
+    bool  getOutputPosition(uint32_t& frames) const override;
+    uint32_t getOutputUnderruns() const override { return m_outUnderruns.load(std::memory_order_relaxed); }
+
+    bool  openInput(int device, AudioStreamConfig& config) override;
+    void  closeInput() override;
+    const char* waitInputBuffer(uint32_t timeoutMs, int& frames) override;
+    void  releaseInputBuffer() override;
+    void  wakeInput() override;
+    bool  getInputPosition(uint32_t& frames) const override;
+    uint32_t getInputOverruns() const override { return m_inOverruns.load(std::memory_order_relaxed); }
+
+private:
+    WAVEFORMATEXTENSIBLE m_wfx;         // Format bez rozszerzenia: tylko m_wfx.Format
+
+    // --- Output ---
+    HWAVEOUT m_hWaveOut;
+    HANDLE   m_outputEvent;
+    std::vector<WAVEHDR> m_outHeaders;  // Geometria z chwili otwarcia — nagłówki nie mogą się przenieść
+    std::vector<char>    m_outData;     // Wszystkie bufory w jednym bloku
+    int      m_outNext;                 // Najstarszy bufor w kolejce
+    int      m_outPrimed;               // Bufory jeszcze nie wysłane po otwarciu
+    uint32_t m_outBlockAlign;
+    std::atomic<uint32_t> m_outUnderruns;
+
+    // --- Input ---
+    HWAVEIN  m_hWaveIn;
+    HANDLE   m_inputEvent;
+    std::vector<WAVEHDR> m_inHeaders;
+    std::vector<char>    m_inData;
+    int      m_inNext;
+    uint32_t m_inBlockAlign;
+    std::atomic<uint32_t> m_inOverruns;
+
+    void initFormat(const AudioStreamConfig& config);
+};
+
+#endif // _WIN32
+
+#endif // AUDIO_WINMM_BACKEND_H
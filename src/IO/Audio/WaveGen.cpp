@@ -4,66 +4,358 @@
 
 #include "WaveGen.h"
 #include <cmath>
-#include <cstdlib>
+#include <cstring>
 #include <ctime>
 
-#ifndef M_PI
-#define M_PI 3.14159265358979323846
+#if defined(__SSE2__)
+#include <emmintrin.h>
 #endif
 
+// Próbki generowane blokami — bufor float na stosie, potem konwersja do int16
+static const uint32_t WAVE_BLOCK = 256;
+
+static const float TURN_SCALE = 1.0f / 4294967296.0f;      // faza int32 → [-0.5, 0.5) okresu
+static const float SAW_SCALE  = 1.0f / 2147483648.0f;
+static const float TRI_SCALE  = 1.0f / 1073741824.0f;
+
+// Szum kolorowy (gauss, różowy, brązowy) — RMS = amplituda / 4, szczyty ~4σ mieszczą się w skali
+static const float NOISE_RMS = 0.25f;
+static const float BROWN_CORNER_HZ = 10.0f;
+
+// sin(2πa) dla a ∈ [-0.25, 0.25] — szereg do a^11, błąd < 1e-7 (poniżej precyzji float)
+static const float SIN_C1  =  6.283185307f;
+static const float SIN_C3  = -41.34170224f;
+static const float SIN_C5  =  81.60524928f;
+static const float SIN_C7  = -76.70585975f;
+static const float SIN_C9  =  42.05869394f;
+static const float SIN_C11 = -15.09464258f;
+
 WaveGen::WaveGen()
     : m_type(WAVE_SINE)
     , m_frequency(440.0)
     , m_amplitude(0.5)
-    , m_phase(0.0)
+    , m_phase(0)
 {
-    static bool seeded = false;
-    if (!seeded) {
-        srand((unsigned int)time(NULL));
-        seeded = true;
+    // Bez globalnego stanu: czas + adres instancji
+    setSeed((uint64_t)time(NULL) * 0x9E3779B97F4A7C15ull ^ (uint64_t)(uintptr_t)this);
+}
+
+// splitmix64 — rozkłada ziarno na stan 4 strumieni xoshiro128+
+static uint64_t splitMix64(uint64_t& x) {
+    uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+void WaveGen::setSeed(uint64_t seed) {
+    for (int i = 0; i < 16; i += 2) {
+        uint64_t z = splitMix64(seed);
+        m_rng[i]     = (uint32_t)z;
+        m_rng[i + 1] = (uint32_t)(z >> 32);
     }
+    m_uniformCached = 0;
+    m_hasGaussSpare = false;
+    m_gaussSpare = 0.0f;
+    // Wiersze różowego od razu losowe — pełna wariancja od pierwszej próbki
+    uniform(m_pinkRows, 16);
+    m_pinkSum = 0.0f;
+    for (float row : m_pinkRows) m_pinkSum += row;
+    m_pinkCounter = 0;
+    m_brown = 0.0f;
 }
 
-void WaveGen::fillBuffer(int16_t* buffer, uint32_t numSamples, uint32_t sampleRate) {
-    double phaseInc = m_frequency / (double)sampleRate;
+// Przyrost fazy NCO: ułamek okresu na próbkę w jednostkach 2^-32
+static uint32_t phaseIncrement(double frequency, uint32_t sampleRate) {
+    if (sampleRate == 0) return 0;
+    double turns = frequency / (double)sampleRate;
+    turns -= floor(turns);
+    return (uint32_t)(uint64_t)(turns * 4294967296.0 + 0.5);
+}
+
+void WaveGen::setPhase(double degrees) {
+    double turns = degrees / 360.0;
+    turns -= floor(turns);
+    m_phase = (uint32_t)(uint64_t)(turns * 4294967296.0 + 0.5);
+}
+
+// ============================================================================
+// Przebiegi: at() — jedna próbka, at4() — cztery (SSE2)
+// ============================================================================
+struct SineWave {
+    static float at(uint32_t phase) {
+        float x = (float)(int32_t)phase * TURN_SCALE;
+        float a = fabsf(x);
+        a = fminf(a, 0.5f - a);                 // sin(π - φ) = sin φ
+        float a2 = a * a;
+        float s = ((((SIN_C11 * a2 + SIN_C9) * a2 + SIN_C7) * a2 + SIN_C5) * a2 + SIN_C3) * a2 + SIN_C1;
+        return copysignf(s * a, x);
+    }
+#if defined(__SSE2__)
+    static __m128 at4(__m128i phase) {
+        const __m128 signMask = _mm_set1_ps(-0.0f);
+        __m128 x = _mm_mul_ps(_mm_cvtepi32_ps(phase), _mm_set1_ps(TURN_SCALE));
+        __m128 sign = _mm_and_ps(x, signMask);
+        __m128 a = _mm_andnot_ps(signMask, x);
+        a = _mm_min_ps(a, _mm_sub_ps(_mm_set1_ps(0.5f), a));
+        __m128 a2 = _mm_mul_ps(a, a);
+        __m128 s = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(SIN_C11), a2), _mm_set1_ps(SIN_C9));
+        s = _mm_add_ps(_mm_mul_ps(s, a2), _mm_set1_ps(SIN_C7));
+        s = _mm_add_ps(_mm_mul_ps(s, a2), _mm_set1_ps(SIN_C5));
+        s = _mm_add_ps(_mm_mul_ps(s, a2), _mm_set1_ps(SIN_C3));
+        s = _mm_add_ps(_mm_mul_ps(s, a2), _mm_set1_ps(SIN_C1));
+        return _mm_xor_ps(_mm_mul_ps(s, a), sign);
+    }
+#endif
+};
+
+// Faza przesunięta o pół okresu jako int32: (p - 0.5) * 2^32
+struct SawtoothWave {
+    static float at(uint32_t phase) {
+        return (float)(int32_t)(phase ^ 0x80000000u) * SAW_SCALE;
+    }
+#if defined(__SSE2__)
+    static __m128 at4(__m128i phase) {
+        __m128i s = _mm_xor_si128(phase, _mm_set1_epi32((int)0x80000000u));
+        return _mm_mul_ps(_mm_cvtepi32_ps(s), _mm_set1_ps(SAW_SCALE));
+    }
+#endif
+};
+
+struct TriangleWave {
+    static float at(uint32_t phase) {
+        return 1.0f - fabsf((float)(int32_t)(phase ^ 0x80000000u)) * TRI_SCALE;
+    }
+#if defined(__SSE2__)
+    static __m128 at4(__m128i phase) {
+        __m128i s = _mm_xor_si128(phase, _mm_set1_epi32((int)0x80000000u));
+        __m128 a = _mm_andnot_ps(_mm_set1_ps(-0.0f), _mm_cvtepi32_ps(s));
+        return _mm_sub_ps(_mm_set1_ps(1.0f), _mm_mul_ps(a, _mm_set1_ps(TRI_SCALE)));
+    }
+#endif
+};
+
+// Najstarszy bit fazy: 0 → +1, 1 → -1
+struct SquareWave {
+    static float at(uint32_t phase) {
+        return (float)(((int32_t)phase >> 31) | 1);
+    }
+#if defined(__SSE2__)
+    static __m128 at4(__m128i phase) {
+        return _mm_cvtepi32_ps(_mm_or_si128(_mm_srai_epi32(phase, 31), _mm_set1_epi32(1)));
+    }
+#endif
+};
+
+// Jedna pętla na przebieg (bez switch na próbkę) — zwraca fazę po count próbkach
+template <class Wave>
+static uint32_t waveLoop(float* out, uint32_t count, uint32_t phase, uint32_t inc) {
+    uint32_t i = 0;
+#if defined(__SSE2__)
+    __m128i p = _mm_set_epi32((int)(phase + 3 * inc), (int)(phase + 2 * inc), (int)(phase + inc), (int)phase);
+    __m128i step = _mm_set1_epi32((int)(4 * inc));
+    for (; i + 4 <= count; i += 4) {
+        _mm_storeu_ps(out + i, Wave::at4(p));
+        p = _mm_add_epi32(p, step);
+    }
+    phase += i * inc;
+#endif
+    for (; i < count; i++, phase += inc) out[i] = Wave::at(phase);
+    return phase;
+}
 
-    for (uint32_t i = 0; i < numSamples; i++) {
-        double sample = 0.0;
+void WaveGen::generate(float* out, uint32_t count, uint32_t inc, uint32_t sampleRate) {
+    switch (m_type) {
+        case WAVE_SINE:     m_phase = waveLoop<SineWave>(out, count, m_phase, inc);     return;
+        case WAVE_SAWTOOTH: m_phase = waveLoop<SawtoothWave>(out, count, m_phase, inc); return;
+        case WAVE_TRIANGLE: m_phase = waveLoop<TriangleWave>(out, count, m_phase, inc); return;
+        case WAVE_SQUARE:   m_phase = waveLoop<SquareWave>(out, count, m_phase, inc);   return;
 
-        switch (m_type) {
-            case WAVE_SINE:
-                sample = sin(2.0 * M_PI * m_phase);
-                break;
+        case WAVE_WHITE_NOISE:    uniform(out, count);              break;
+        case WAVE_GAUSSIAN_NOISE: gaussian(out, count);             break;
+        case WAVE_PINK_NOISE:     pink(out, count);                 break;
+        case WAVE_BROWN_NOISE:    brown(out, count, sampleRate);    break;
 
-            case WAVE_SAWTOOTH:
-                sample = 2.0 * m_phase - 1.0;
-                break;
+        default:
+            for (uint32_t i = 0; i < count; i++) out[i] = 0.0f;
+            break;
+    }
+    m_phase += count * inc;
+}
+
+// ============================================================================
+// Szum: xoshiro128+, 4 niezależne strumienie — próbka n z pasa n % 4
+// ============================================================================
+static inline uint32_t rotl32(uint32_t x, int k) {
+    return (x << k) | (x >> (32 - k));
+}
+
+// 23 najstarsze bity → mantysa liczby z [1, 2) → [-1, 1)
+static inline float uniformFromBits(uint32_t bits) {
+    uint32_t u = (bits >> 9) | 0x3F800000u;
+    float f;
+    memcpy(&f, &u, sizeof(f));
+    return f * 2.0f - 3.0f;
+}
+
+static inline void xoshiro4(uint32_t* s, float* out) {
+    for (int lane = 0; lane < 4; lane++) {
+        uint32_t* s0 = s + lane;
+        uint32_t result = s0[0] + s0[12];
+        uint32_t t = s0[4] << 9;
+        s0[8]  ^= s0[0];
+        s0[12] ^= s0[4];
+        s0[4]  ^= s0[8];
+        s0[0]  ^= s0[12];
+        s0[8]  ^= t;
+        s0[12] = rotl32(s0[12], 11);
+        out[lane] = uniformFromBits(result);
+    }
+}
+
+void WaveGen::uniform(float* out, uint32_t count) {
+    uint32_t i = 0;
+    while (i < count && m_uniformCached > 0) out[i++] = m_uniformCache[4 - m_uniformCached--];
 
-            case WAVE_TRIANGLE:
-                sample = (m_phase < 0.5)
-                    ? (4.0 * m_phase - 1.0)
-                    : (3.0 - 4.0 * m_phase);
-                break;
+#if defined(__SSE2__)
+    __m128i s0 = _mm_loadu_si128((const __m128i*)(m_rng + 0));
+    __m128i s1 = _mm_loadu_si128((const __m128i*)(m_rng + 4));
+    __m128i s2 = _mm_loadu_si128((const __m128i*)(m_rng + 8));
+    __m128i s3 = _mm_loadu_si128((const __m128i*)(m_rng + 12));
+    const __m128i one = _mm_set1_epi32(0x3F800000);
+    const __m128 two = _mm_set1_ps(2.0f), three = _mm_set1_ps(3.0f);
+    for (; i + 4 <= count; i += 4) {
+        __m128i result = _mm_add_epi32(s0, s3);
+        __m128i t = _mm_slli_epi32(s1, 9);
+        s2 = _mm_xor_si128(s2, s0);
+        s3 = _mm_xor_si128(s3, s1);
+        s1 = _mm_xor_si128(s1, s2);
+        s0 = _mm_xor_si128(s0, s3);
+        s2 = _mm_xor_si128(s2, t);
+        s3 = _mm_or_si128(_mm_slli_epi32(s3, 11), _mm_srli_epi32(s3, 21));
+        __m128 f = _mm_castsi128_ps(_mm_or_si128(_mm_srli_epi32(result, 9), one));
+        _mm_storeu_ps(out + i, _mm_sub_ps(_mm_mul_ps(f, two), three));
+    }
+    _mm_storeu_si128((__m128i*)(m_rng + 0), s0);
+    _mm_storeu_si128((__m128i*)(m_rng + 4), s1);
+    _mm_storeu_si128((__m128i*)(m_rng + 8), s2);
+    _mm_storeu_si128((__m128i*)(m_rng + 12), s3);
+#else
+    for (; i + 4 <= count; i += 4) xoshiro4(m_rng, out + i);
+#endif
 
-            case WAVE_SQUARE:
-                sample = (m_phase < 0.5) ? 1.0 : -1.0;
-                break;
+    // Niepełna czwórka: reszta czeka na następne wywołanie
+    if (i < count) {
+        xoshiro4(m_rng, m_uniformCache);
+        m_uniformCached = 4;
+        while (i < count) out[i++] = m_uniformCache[4 - m_uniformCached--];
+    }
+}
 
-            case WAVE_WHITE_NOISE:
-                sample = ((double)rand() / RAND_MAX) * 2.0 - 1.0;
-                break;
+// Box-Muller: para równomiernych → para gaussowskich (kąt przez wielomian sinusa)
+void WaveGen::gaussian(float* out, uint32_t count) {
+    float u[WAVE_BLOCK * 2];
+    uint32_t i = 0;
+    if (count > 0 && m_hasGaussSpare) {
+        out[i++] = m_gaussSpare;
+        m_hasGaussSpare = false;
+    }
+    while (i < count) {
+        uint32_t pairs = (count - i + 1) / 2;
+        if (pairs > WAVE_BLOCK) pairs = WAVE_BLOCK;
+        uniform(u, pairs * 2);
+        for (uint32_t k = 0; k < pairs; k++) {
+            float r = NOISE_RMS * sqrtf(-2.0f * logf(0.5f - 0.5f * u[2 * k]));    // (0, 1]
+            uint32_t angle = (uint32_t)(int32_t)(u[2 * k + 1] * 2147483648.0f);
+            float a = r * SineWave::at(angle);
+            float b = r * SineWave::at(angle + 0x40000000u);
+            out[i++] = a;
+            if (i < count) {
+                out[i++] = b;
+            } else {
+                m_gaussSpare = b;
+                m_hasGaussSpare = true;
+            }
+        }
+    }
+}
 
-            default:
-                sample = 0.0;
-                break;
+// Voss-McCartney: wiersz k odświeżany co 2^(k+1) próbek (wg najmłodszego
+// ustawionego bitu licznika) + biały składnik — widmo -3 dB/okt. w 16 oktawach
+void WaveGen::pink(float* out, uint32_t count) {
+    static const float scale = NOISE_RMS / 2.3805f;     // σ sumy 17 równomiernych: √(17/3)
+    float u[WAVE_BLOCK * 2];
+    for (uint32_t i = 0; i < count; ) {
+        uint32_t n = count - i;
+        if (n > WAVE_BLOCK) n = WAVE_BLOCK;
+        uniform(u, n * 2);
+        for (uint32_t k = 0; k < n; k++) {
+            uint32_t row = (uint32_t)__builtin_ctz(++m_pinkCounter | 0x10000u);
+            if (row < 16) {
+                m_pinkSum += u[2 * k] - m_pinkRows[row];
+                m_pinkRows[row] = u[2 * k];
+            }
+            out[i + k] = (m_pinkSum + u[2 * k + 1]) * scale;
         }
+        i += n;
+    }
+}
+
+// Całkowanie białego szumu z upływem (biegun BROWN_CORNER_HZ) — bez dryfu DC
+void WaveGen::brown(float* out, uint32_t count, uint32_t sampleRate) {
+    float leak = sampleRate ? expf(-2.0f * 3.14159265f * BROWN_CORNER_HZ / (float)sampleRate) : 0.0f;
+    float gain = NOISE_RMS * sqrtf(3.0f * (1.0f - leak * leak));    // σ wyjścia = NOISE_RMS
+    uniform(out, count);
+    float b = m_brown;
+    for (uint32_t i = 0; i < count; i++) {
+        b = b * leak + out[i] * gain;
+        out[i] = b;
+    }
+    m_brown = b;
+}
+
+// ============================================================================
+// Bufory wyjściowe
+// ============================================================================
+void WaveGen::fillBuffer(float* buffer, uint32_t numSamples, uint32_t sampleRate) {
+    uint32_t inc = phaseIncrement(m_frequency, sampleRate);
+    float gain = (float)m_amplitude;
 
-        double val = sample * m_amplitude * 32767.0;
-        if (val > 32767.0)  val = 32767.0;
-        if (val < -32768.0) val = -32768.0;
-        buffer[i] = (int16_t)val;
+    generate(buffer, numSamples, inc, sampleRate);
+    for (uint32_t i = 0; i < numSamples; i++) buffer[i] *= gain;
+}
+
+void WaveGen::fillBuffer(int16_t* buffer, uint32_t numSamples, uint32_t sampleRate) {
+    uint32_t inc = phaseIncrement(m_frequency, sampleRate);
+    float gain = (float)(m_amplitude * 32767.0);
+#if defined(__SSE2__)
+    alignas(16) float block[WAVE_BLOCK];
+#else
+    float block[WAVE_BLOCK];
+#endif
 
-        m_phase += phaseInc;
-        if (m_phase >= 1.0) m_phase -= 1.0;
+    for (uint32_t done = 0; done < numSamples; ) {
+        uint32_t n = numSamples - done;
+        if (n > WAVE_BLOCK) n = WAVE_BLOCK;
+        generate(block, n, inc, sampleRate);
+
+        // Skalowanie, nasycenie i zaokrąglenie całego bloku
+        int16_t* out = buffer + done;
+        uint32_t i = 0;
+#if defined(__SSE2__)
+        __m128 g = _mm_set1_ps(gain);
+        __m128 lo = _mm_set1_ps(-32768.0f), hi = _mm_set1_ps(32767.0f);
+        for (; i + 8 <= n; i += 8) {
+            __m128 a = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_load_ps(block + i), g), lo), hi);
+            __m128 b = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_load_ps(block + i + 4), g), lo), hi);
+            __m128i packed = _mm_packs_epi32(_mm_cvtps_epi32(a), _mm_cvtps_epi32(b));
+            _mm_storeu_si128((__m128i*)(out + i), packed);
+        }
+#endif
+        for (; i < n; i++) {
+            float v = fminf(fmaxf(block[i] * gain, -32768.0f), 32767.0f);
+            out[i] = (int16_t)lrintf(v);
+        }
+        done += n;
     }
 }
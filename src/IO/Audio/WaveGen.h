@@ -2,6 +2,22 @@
 // Copyright (C) 2026 JAQUBA (https://github.com/JAQUBA)
 // Part of JQB_WindowsLib — https://github.com/JAQUBA/JQB_WindowsLib
 
+/**
+ * WaveGen.h — Generator przebiegów audio (sinus, piła, trójkąt, prostokąt, szum)
+ *
+ * Faza to 32-bitowy akumulator NCO (przepełnienie = zawinięcie okresu,
+ * rozdzielczość fs / 2^32). Każdy przebieg ma własną pętlę bez rozgałęzień
+ * na próbkę; sinus — wielomian nieparzysty na ćwiartce okresu (float).
+ * Przy __SSE2__ pętle liczą 4 próbki naraz. Wersja int16 generuje bloki
+ * float, a skalowanie, nasycenie i konwersja idą na końcu, też wektorowo.
+ *
+ * Szum: własny generator xoshiro128+ każdej instancji (4 strumienie w
+ * pasach SSE2, ziarno ustawiane — powtarzalne testy), bez rand()/srand().
+ * Biały równomierny, gaussowski, różowy (Voss-McCartney) i brązowy.
+ *
+ * Nie korzysta z WinAPI — może działać poza AudioEngine.
+ */
+
 #ifndef WAVEGEN_H
 #define WAVEGEN_H
 
@@ -12,7 +28,10 @@ enum WaveformType {
     WAVE_SAWTOOTH,
     WAVE_TRIANGLE,
     WAVE_SQUARE,
-    WAVE_WHITE_NOISE,
+    WAVE_WHITE_NOISE,           // uniform, peak = amplitude
+    WAVE_GAUSSIAN_NOISE,        // RMS = amplitude / 4 (pink and brown too)
+    WAVE_PINK_NOISE,            // -3 dB/octave (Voss-McCartney, 16 rows)
+    WAVE_BROWN_NOISE,           // -6 dB/octave (leaky integrator, corner 10 Hz)
     WAVE_COUNT
 };
 
@@ -30,15 +49,42 @@ public:
 
     // Fill a PCM 16-bit mono buffer with the selected waveform
     void fillBuffer(int16_t* buffer, uint32_t numSamples, uint32_t sampleRate);
+    // Float samples (amplitude applied, full scale = ±1.0, not clamped)
+    void fillBuffer(float* buffer, uint32_t numSamples, uint32_t sampleRate);
 
     // Reset phase accumulator to zero
-    void resetPhase() { m_phase = 0.0; }
+    void resetPhase() { m_phase = 0; }
+    // Set phase in degrees — e.g. two generators with the same frequency,
+    // reset together and set 90° apart, stay in quadrature (I/Q stimulus)
+    void setPhase(double degrees);
+    // Noise generator seed — the same seed gives the same noise sequence.
+    // Also resets pink/brown filter state. Default: seeded from time and address.
+    void setSeed(uint64_t seed);
 
 private:
     WaveformType m_type;
-    double m_frequency;
-    double m_amplitude;
-    double m_phase;
+    double   m_frequency;
+    double   m_amplitude;
+    uint32_t m_phase;           // 2^32 = jeden okres
+
+    // Stan szumu — wszystko per instancja
+    uint32_t m_rng[16];         // xoshiro128+: słowo w * 4 + pas (4 strumienie)
+    float    m_uniformCache[4]; // Niewykorzystana reszta ostatniej czwórki
+    uint32_t m_uniformCached;
+    float    m_gaussSpare;      // Box-Muller daje pary
+    bool     m_hasGaussSpare;
+    float    m_pinkRows[16];
+    float    m_pinkSum;
+    uint32_t m_pinkCounter;
+    float    m_brown;
+
+    // Przebieg bez amplitudy (±1.0) — przesuwa fazę o count * phaseInc
+    void generate(float* out, uint32_t count, uint32_t phaseInc, uint32_t sampleRate);
+    // Równomierny [-1, 1) — kolejność niezależna od podziału na wywołania
+    void uniform(float* out, uint32_t count);
+    void gaussian(float* out, uint32_t count);
+    void pink(float* out, uint32_t count);
+    void brown(float* out, uint32_t count, uint32_t sampleRate);
 };
 
 #endif // WAVEGEN_H
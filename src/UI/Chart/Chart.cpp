@@ -4,13 +4,20 @@
 
 #include "Chart.h"
 #include "../../Util/StringUtils.h"
+#include "ChartRaster.h"
 #include <algorithm>
-#include <numeric>
-#include <cmath> // Dodaję nagłówek cmath dla funkcji fabs
 
 // Inicjalizacja statycznej zmiennej
 int Chart::s_nextId = 5000;
 
+// Timer opróżniający kolejkę producentów wielowątkowych
+static const UINT_PTR CHART_INGEST_TIMER_ID = 1;
+
+// Tło warstwy danych (strip chart) — kolor praktycznie nieużywany przez serie
+static const COLORREF DATA_LAYER_KEY = RGB(1, 0, 1);
+// Raster op "zostaw cel" (brak stałej DSTCOPY w starszych nagłówkach MinGW)
+static const DWORD ROP_DSTCOPY = 0x00AA0029;
+
 // Procedura obsługi okna wykresu
 LRESULT CALLBACK ChartProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) {
     Chart* chart = reinterpret_cast<Chart*>(GetWindowLongPtr(hwnd, GWLP_USERDATA));
@@ -30,6 +37,31 @@ LRESULT CALLBACK ChartProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) {
         }
         case WM_ERASEBKGND:
             return 1;
+        case WM_LBUTTONDOWN:
+            if (chart) {
+                chart->mouseDown((short)LOWORD(lParam), (short)HIWORD(lParam));
+                return 0;
+            }
+            break;
+        case WM_MOUSEMOVE:
+            if (chart) {
+                chart->mouseMove((short)LOWORD(lParam), (short)HIWORD(lParam));
+                return 0;
+            }
+            break;
+        case WM_LBUTTONUP:
+        case WM_CAPTURECHANGED:
+            if (chart) {
+                chart->mouseUp();
+                return 0;
+            }
+            break;
+        case WM_TIMER:
+            if (chart && wParam == CHART_INGEST_TIMER_ID) {
+                chart->drainIngest();
+                return 0;
+            }
+            break;
     }
     
     return DefWindowProc(hwnd, msg, wParam, lParam);
@@ -38,10 +70,13 @@ LRESULT CALLBACK ChartProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) {
 Chart::Chart(int x, int y, int width, int height, const char* title)
     : m_x(x), m_y(y), m_width(width), m_height(height), m_title(title), m_hwnd(NULL) {
     m_id = s_nextId++;
+    m_plot.setTitle(StringUtils::utf8ToWide(m_title));
 }
 
 Chart::~Chart() {
+    releaseGdiResources();
     if (m_hwnd) {
+        KillTimer(m_hwnd, CHART_INGEST_TIMER_ID);
         DestroyWindow(m_hwnd);
         m_hwnd = NULL;
     }
@@ -86,19 +121,50 @@ void Chart::create(HWND parent) {
     
     // Ustawienie wskaźnika do instancji klasy
     SetWindowLongPtr(m_hwnd, GWLP_USERDATA, reinterpret_cast<LONG_PTR>(this));
+    
+    if (m_ingest) {
+        startIngestTimer();
+    }
+}
+
+int64_t Chart::nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
 }
 
+void Chart::invalidate() {
+    if (m_hwnd) {
+        InvalidateRect(m_hwnd, NULL, FALSE);
+    }
+}
+
+// ============================================================================
+// Dodawanie danych
+// ============================================================================
 void Chart::addDataPoint(double value, const std::wstring& unit) {
-    DataPoint point;
-    point.value = value;
-    point.timestamp = std::chrono::steady_clock::now();
-    point.unit = unit;
-    
-    m_dataPoints.push_back(point);
-    
-    // Usunięcie starych punktów danych
-    cleanOldDataPoints();
-    
+    // Jednostka przechowywana raz dla serii, nie przy każdej próbce
+    m_plot.setSeriesUnit(0, unit);
+    m_plot.addPoint(0, value, nowNs());
+    requestRefresh();
+}
+
+void Chart::addDataPoints(const double* values, int count, double totalDurationMs) {
+    addSeriesPoints(0, values, count, totalDurationMs);
+}
+
+void Chart::addSeriesPoint(int series, double value) {
+    if (series < 0 || series >= m_plot.getSeriesCount()) return;
+    m_plot.addPoint(series, value, nowNs());
+    requestRefresh();
+}
+
+void Chart::addSeriesPoints(int series, const double* values, int count, double totalDurationMs) {
+    if (count <= 0 || series < 0 || series >= m_plot.getSeriesCount()) return;
+    m_plot.addBatch(series, values, count, totalDurationMs, nowNs());
+    requestRefresh();
+}
+
+void Chart::requestRefresh() {
     // Oznacz, że dane się zmieniły
     m_dataChanged = true;
     
@@ -109,408 +175,350 @@ void Chart::addDataPoint(double value, const std::wstring& unit) {
     if (elapsed >= m_refreshInterval) {
         m_lastRefreshTime = now;
         m_dataChanged = false;
-        
-        if (m_hwnd) {
-            InvalidateRect(m_hwnd, NULL, FALSE);
-        }
+        invalidate();
     }
 }
 
-void Chart::addDataPoints(const double* values, int count, double totalDurationMs) {
-    if (count <= 0) return;
-    
-    auto now = std::chrono::steady_clock::now();
-    auto batchDuration = std::chrono::microseconds(static_cast<long long>(totalDurationMs * 1000.0));
-    
-    // Virtual time base: batches are spaced at exactly totalDurationMs
-    // regardless of poll jitter. Like an oscilloscope — time derived from
-    // sample rate, not from when the UI thread happened to read the data.
-    auto startTime = now - batchDuration;
-    auto endTime = now;
-    bool gapDetected = false;
-    
-    if (m_hasBatchHistory) {
-        auto gap = std::chrono::duration_cast<std::chrono::microseconds>(now - m_lastBatchEnd);
-        if (gap < batchDuration * 3) {
-            // Chain: start where previous batch ended, advance by exact duration
-            startTime = m_lastBatchEnd;
-            endTime = startTime + batchDuration;
-        } else {
-            gapDetected = true;
-        }
+void Chart::setRefreshRate(int millisecondsInterval) {
+    m_refreshInterval = millisecondsInterval;
+    if (m_ingest && m_hwnd) {
+        startIngestTimer();
     }
-    
-    auto totalSpan = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
-        endTime - startTime);
-    
-    for (int i = 0; i < count; i++) {
-        DataPoint point;
-        point.value = values[i];
-        auto offset = totalSpan * i / (count > 1 ? count - 1 : 1);
-        point.timestamp = startTime + offset;
-        point.isNewSegment = (i == 0 && gapDetected);
-        m_dataPoints.push_back(point);
+}
+
+void Chart::clear() {
+    m_plot.clear();
+    invalidate();
+}
+
+// ============================================================================
+// Wielowątkowe zasilanie (lock-free ingest)
+// ============================================================================
+void Chart::enableThreadedIngest(size_t capacity) {
+    if (m_ingest) return;
+    m_ingest.reset(new ChartIngestQueue(capacity));
+    if (m_hwnd) {
+        startIngestTimer();
     }
+}
+
+void Chart::startIngestTimer() {
+    int interval = m_refreshInterval > 0 ? m_refreshInterval : 16;
+    SetTimer(m_hwnd, CHART_INGEST_TIMER_ID, (UINT)interval, NULL);
+}
+
+bool Chart::postDataPoint(int series, double value) {
+    if (!m_ingest) return false;
+    return m_ingest->pushPoint(series, value, nowNs());
+}
+
+bool Chart::postDataPoints(int series, const double* values, int count, double totalDurationMs) {
+    if (!m_ingest) return false;
+    return m_ingest->pushBatch(series, values, count, totalDurationMs, nowNs());
+}
+
+bool Chart::postSpectrum(const double* magnitudes, int bins, double binHz) {
+    if (!m_ingest) return false;
+    return m_ingest->pushBatch(0, magnitudes, bins, binHz, nowNs(), ChartIngestQueue::RECORD_SPECTRUM);
+}
+
+void Chart::drainIngest() {
+    if (!m_ingest) return;
     
-    m_lastBatchEnd = endTime;
-    m_hasBatchHistory = true;
-    
-    cleanOldDataPoints();
-    m_dataChanged = true;
+    bool any = false;
     
-    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - m_lastRefreshTime).count();
-    if (elapsed >= m_refreshInterval) {
-        m_lastRefreshTime = now;
-        m_dataChanged = false;
-        if (m_hwnd) {
-            InvalidateRect(m_hwnd, NULL, FALSE);
+    const ChartIngestQueue::Record* rec;
+    while ((rec = m_ingest->peek()) != nullptr) {
+        size_t consumed = 1;
+        int index = rec->series;
+        bool valid = index < m_plot.getSeriesCount();
+        
+        if (rec->kind == ChartIngestQueue::RECORD_BATCH || rec->kind == ChartIngestQueue::RECORD_SPECTRUM) {
+            consumed += rec->count;
+            if (valid) {
+                m_ingestScratch.resize(rec->count);
+                for (uint32_t i = 0; i < rec->count; i++) {
+                    m_ingestScratch[i] = m_ingest->sampleAt(1 + i).value;
+                }
+                if (rec->kind == ChartIngestQueue::RECORD_SPECTRUM) {
+                    m_plot.setSpectrum(m_ingestScratch.data(), rec->count, rec->value);
+                } else {
+                    // Czas nadania przez producenta, nie czas opróżnienia kolejki
+                    m_plot.addBatch(index, m_ingestScratch.data(), (int)rec->count, rec->value, rec->timeNs);
+                }
+            }
+        } else if (valid) {
+            m_plot.addPoint(index, rec->value, rec->timeNs);
         }
-    }
-}
-
-void Chart::cleanOldDataPoints() {
-    if (m_dataPoints.empty()) {
-        return;
+        
+        any = any || valid;
+        m_ingest->release(consumed);
     }
     
-    // Use latest data timestamp as reference (not wall-clock)
-    // so virtual time base doesn't cause premature cleanup
-    auto refTime = m_dataPoints.back().timestamp;
-    // Keep extra data when trigger is enabled (need history to search for crossings)
-    double retainSec = m_triggerEnabled ? m_timeWindowSec * 3.0 : m_timeWindowSec;
-    auto cutoffUs = std::chrono::microseconds(static_cast<long long>(retainSec * 1000000.0));
-    auto cutoff = refTime - cutoffUs;
+    if (!any) return;
     
-    // Usuń punkty starsze niż okno czasowe
-    while (!m_dataPoints.empty() && m_dataPoints.front().timestamp < cutoff) {
-        m_dataPoints.pop_front();
-    }
+    // Timer nadaje tempo — jedno odświeżenie na klatkę
+    m_dataChanged = false;
+    invalidate();
 }
 
-void Chart::clear() {
-    m_dataPoints.clear();
-    m_hasBatchHistory = false;
-    
-    if (m_hwnd) {
-        InvalidateRect(m_hwnd, NULL, FALSE);
-    }
+// ============================================================================
+// Serie i ustawienia
+// ============================================================================
+int Chart::addSeries(const std::wstring& name, COLORREF color, const std::wstring& unit, bool secondaryAxis) {
+    int index = m_plot.addSeries(name, (ChartColor)color, unit, secondaryAxis);
+    invalidate();
+    return index;
+}
+
+void Chart::setSeriesVisible(int series, bool visible) {
+    m_plot.setSeriesVisible(series, visible);
+    invalidate();
+}
+
+void Chart::setSeriesColor(int series, COLORREF color) {
+    m_plot.setSeriesColor(series, (ChartColor)color);
+    invalidate();
+}
+
+void Chart::setSeriesUnit(int series, const std::wstring& unit) {
+    m_plot.setSeriesUnit(series, unit);
+}
+
+void Chart::setSeriesAxis(int series, bool secondaryAxis) {
+    m_plot.setSeriesAxis(series, secondaryAxis);
 }
 
 void Chart::setColors(COLORREF gridColor, COLORREF axisColor, COLORREF dataColor) {
-    m_gridColor = gridColor;
-    m_axisColor = axisColor;
-    m_dataColor = dataColor;
+    m_plot.setColors((ChartColor)gridColor, (ChartColor)axisColor, (ChartColor)dataColor);
     
     if (m_hwnd) {
         InvalidateRect(m_hwnd, NULL, TRUE);
     }
 }
 
-double Chart::getMinValue() const {
-    if (m_dataPoints.empty()) {
-        return m_manualMinY;
-    }
-    
-    if (!m_autoScale) {
-        return m_manualMinY;
-    }
-    
-    double minVal = m_dataPoints.front().value;
-    for (const auto& point : m_dataPoints) {
-        minVal = std::min(minVal, point.value);
+void Chart::setHistoryTiers(double rawSeconds, size_t bucketsPerLevel) {
+    m_plot.setHistoryTiers(rawSeconds, bucketsPerLevel);
+    invalidate();
+}
+
+void Chart::setMemoryBudget(size_t maxBytes) {
+    m_plot.setMemoryBudget(maxBytes);
+    invalidate();
+}
+
+void Chart::setPointBudget(size_t maxPoints) {
+    m_plot.setPointBudget(maxPoints);
+    invalidate();
+}
+
+void Chart::setTriggerMode(ChartTriggerMode mode) {
+    m_plot.setTriggerMode(mode);
+    invalidate();
+}
+
+void Chart::armTrigger() {
+    m_plot.armTrigger();
+    invalidate();
+}
+
+void Chart::setDisplayMode(ChartDisplayMode mode) {
+    m_plot.setDisplayMode(mode);
+    invalidate();
+}
+
+void Chart::configureSpectrum(size_t fftSize, FFTWindow window) {
+    m_plot.configureSpectrum(fftSize, window);
+    invalidate();
+}
+
+void Chart::addSpectrumSamples(const double* samples, int count, double sampleRate) {
+    m_plot.addSpectrumSamples(samples, count, sampleRate);
+    requestRefresh();
+}
+
+void Chart::setSpectrum(const double* magnitudes, size_t bins, double binHz) {
+    m_plot.setSpectrum(magnitudes, bins, binHz);
+    requestRefresh();
+}
+
+// ============================================================================
+// Kursory pomiarowe
+// ============================================================================
+void Chart::setTimeCursors(bool enabled, double t1Sec, double t2Sec) {
+    m_plot.setTimeCursors(enabled, t1Sec, t2Sec);
+    invalidate();
+}
+
+void Chart::setValueCursors(bool enabled, double v1, double v2) {
+    m_plot.setValueCursors(enabled, v1, v2);
+    invalidate();
+}
+
+void Chart::mouseDown(int x, int y) {
+    m_dragCursor = m_plot.cursorAt(x, y);
+    if (m_dragCursor != CHART_CURSOR_NONE) {
+        SetCapture(m_hwnd);
     }
-    
-    // Dodaj trochę marginesu
-    return minVal - std::abs(minVal * 0.1);
 }
 
-double Chart::getMaxValue() const {
-    if (m_dataPoints.empty()) {
-        return m_manualMaxY;
+void Chart::mouseMove(int x, int y) {
+    if (m_dragCursor == CHART_CURSOR_NONE) return;
+    m_plot.moveCursor(m_dragCursor, x, y);
+    // Odczyty liczone przy renderowaniu — bez czekania na nowe dane
+    invalidate();
+}
+
+void Chart::mouseUp() {
+    if (m_dragCursor == CHART_CURSOR_NONE) return;
+    m_dragCursor = CHART_CURSOR_NONE;
+    if (GetCapture() == m_hwnd) ReleaseCapture();
+}
+
+// ============================================================================
+// Zasoby GDI
+// ============================================================================
+void Chart::ensureBuffers(HDC hdc, int w, int h) {
+    if (m_backDC && w == m_bufferWidth && h == m_bufferHeight) return;
+
+    if (m_backDC) {
+        SelectObject(m_backDC, m_backOldBitmap);
+        DeleteObject(m_backBitmap);
+        DeleteDC(m_backDC);
+        SelectObject(m_staticDC, m_staticOldBitmap);
+        DeleteObject(m_staticBitmap);
+        DeleteDC(m_staticDC);
     }
-    
-    if (!m_autoScale) {
-        return m_manualMaxY;
+
+    m_backDC = CreateCompatibleDC(hdc);
+    m_backBitmap = CreateCompatibleBitmap(hdc, w, h);
+    m_backOldBitmap = (HBITMAP)SelectObject(m_backDC, m_backBitmap);
+
+    m_staticDC = CreateCompatibleDC(hdc);
+    m_staticBitmap = CreateCompatibleBitmap(hdc, w, h);
+    m_staticOldBitmap = (HBITMAP)SelectObject(m_staticDC, m_staticBitmap);
+
+    m_bufferWidth = w;
+    m_bufferHeight = h;
+}
+
+void Chart::releaseGdiResources() {
+    if (m_backDC) {
+        SelectObject(m_backDC, m_backOldBitmap);
+        DeleteObject(m_backBitmap);
+        DeleteDC(m_backDC);
+        m_backDC = NULL;
     }
-    
-    double maxVal = m_dataPoints.front().value;
-    for (const auto& point : m_dataPoints) {
-        maxVal = std::max(maxVal, point.value);
+    if (m_staticDC) {
+        SelectObject(m_staticDC, m_staticOldBitmap);
+        DeleteObject(m_staticBitmap);
+        DeleteDC(m_staticDC);
+        m_staticDC = NULL;
     }
-    
-    // Dodaj trochę marginesu
-    return maxVal + std::abs(maxVal * 0.1);
+    releaseDataLayer();
+    m_canvas.release();
+    m_bufferWidth = 0;
+    m_bufferHeight = 0;
 }
 
-void Chart::render(HDC hdc) {
-    RECT clientRect;
-    GetClientRect(m_hwnd, &clientRect);
-    int w = clientRect.right - clientRect.left;
-    int h = clientRect.bottom - clientRect.top;
-    
-    // Double buffering
-    HDC memDC = CreateCompatibleDC(hdc);
-    HBITMAP memBitmap = CreateCompatibleBitmap(hdc, w, h);
-    HBITMAP oldBitmap = (HBITMAP)SelectObject(memDC, memBitmap);
-    
-    // Wypełnij tło
-    HBRUSH bgBrush = CreateSolidBrush(RGB(0, 0, 0));
-    FillRect(memDC, &clientRect, bgBrush);
-    DeleteObject(bgBrush);
-    
-    // Rysuj komponenty wykresu
-    drawGrid(memDC, clientRect);
-    drawAxes(memDC, clientRect);
-    drawData(memDC, clientRect);
-    
-    // Rysuj tytuł
-    std::wstring wideTitle = StringUtils::utf8ToWide(m_title);
-    HFONT font = CreateFontW(16, 0, 0, 0, FW_NORMAL, FALSE, FALSE, FALSE, 
-                            DEFAULT_CHARSET, OUT_OUTLINE_PRECIS, CLIP_DEFAULT_PRECIS, 
-                            CLEARTYPE_QUALITY, DEFAULT_PITCH, L"Arial");
-    
-    HFONT oldFont = (HFONT)SelectObject(memDC, font);
-    SetTextColor(memDC, RGB(255, 255, 255));
-    SetBkMode(memDC, TRANSPARENT);
-    
-    RECT titleRect = clientRect;
-    titleRect.bottom = 20;
-    DrawTextW(memDC, wideTitle.c_str(), -1, &titleRect, DT_CENTER | DT_SINGLELINE | DT_VCENTER);
-    
-    SelectObject(memDC, oldFont);
-    DeleteObject(font);
-    
-    // Blit to screen
-    BitBlt(hdc, 0, 0, w, h, memDC, 0, 0, SRCCOPY);
-    
-    SelectObject(memDC, oldBitmap);
-    DeleteObject(memBitmap);
-    DeleteDC(memDC);
+void Chart::ensureDataLayer(HDC hdc, int w, int h) {
+    if (m_dataDC && w == m_dataWidth && h == m_dataHeight) return;
+    releaseDataLayer();
+
+    m_dataDC = CreateCompatibleDC(hdc);
+    m_dataBitmap = CreateCompatibleBitmap(hdc, w, h);
+    m_dataOldBitmap = (HBITMAP)SelectObject(m_dataDC, m_dataBitmap);
+    m_maskDC = CreateCompatibleDC(hdc);
+    m_maskBitmap = CreateBitmap(w, h, 1, 1, NULL);
+    m_dataWidth = w;
+    m_dataHeight = h;
+
+    // Nowa bitmapa — zawartość warstwy nieznana
+    m_plot.invalidateLayer();
 }
 
-void Chart::drawGrid(HDC hdc, const RECT& rect) {
-    // Utwórz pióro dla siatki
-    HPEN gridPen = CreatePen(PS_DOT, 1, m_gridColor);
-    HPEN oldPen = (HPEN)SelectObject(hdc, gridPen);
-    
-    // Rysuj poziome linie siatki
-    const int horizontalLines = 4;
-    int stepY = (rect.bottom - rect.top - 40) / horizontalLines;
-    
-    for (int i = 1; i <= horizontalLines; i++) {
-        int y = rect.bottom - 20 - i * stepY;
-        MoveToEx(hdc, rect.left + 50, y, NULL);
-        LineTo(hdc, rect.right - 10, y);
+void Chart::releaseDataLayer() {
+    if (m_dataDC) {
+        SelectObject(m_dataDC, m_dataOldBitmap);
+        DeleteObject(m_dataBitmap);
+        DeleteDC(m_dataDC);
+        m_dataDC = NULL;
     }
-    
-    // Rysuj pionowe linie siatki
-    const int verticalLines = 6;
-    int stepX = (rect.right - rect.left - 60) / verticalLines;
-    
-    for (int i = 1; i <= verticalLines; i++) {
-        int x = rect.left + 50 + i * stepX;
-        MoveToEx(hdc, x, rect.top + 20, NULL);
-        LineTo(hdc, x, rect.bottom - 20);
+    if (m_maskDC) {
+        DeleteObject(m_maskBitmap);
+        DeleteDC(m_maskDC);
+        m_maskDC = NULL;
     }
-    
-    // Przywróć oryginalne pióro i usuń utworzone
-    SelectObject(hdc, oldPen);
-    DeleteObject(gridPen);
+    m_dataWidth = 0;
+    m_dataHeight = 0;
 }
 
-void Chart::drawAxes(HDC hdc, const RECT& rect) {
-    // Utwórz pióro dla osi
-    HPEN axisPen = CreatePen(PS_SOLID, 2, m_axisColor);
-    HPEN oldPen = (HPEN)SelectObject(hdc, axisPen);
-    
-    // Oś Y
-    MoveToEx(hdc, rect.left + 50, rect.top + 20, NULL);
-    LineTo(hdc, rect.left + 50, rect.bottom - 20);
-    
-    // Oś X
-    MoveToEx(hdc, rect.left + 50, rect.bottom - 20, NULL);
-    LineTo(hdc, rect.right - 10, rect.bottom - 20);
-    
-    // Etykiety osi Y
-    HFONT font = CreateFontW(12, 0, 0, 0, FW_NORMAL, FALSE, FALSE, FALSE, 
-                            DEFAULT_CHARSET, OUT_OUTLINE_PRECIS, CLIP_DEFAULT_PRECIS, 
-                            CLEARTYPE_QUALITY, DEFAULT_PITCH, L"Arial");
-    
-    HFONT oldFont = (HFONT)SelectObject(hdc, font);
-    SetTextColor(hdc, m_axisColor);
-    SetBkMode(hdc, TRANSPARENT);
+void Chart::composeDataLayer(int w, int h) {
+    // Maska: piksele w kolorze klucza → 1. Bitmapa maski jest wybrana w DC
+    // tylko na czas tworzenia — MaskBlt przyjmuje ją jako HBITMAP
+    HBITMAP oldMask = (HBITMAP)SelectObject(m_maskDC, m_maskBitmap);
+    SetBkColor(m_dataDC, DATA_LAYER_KEY);
+    BitBlt(m_maskDC, 0, 0, w, h, m_dataDC, 0, 0, SRCCOPY);
+    SelectObject(m_maskDC, oldMask);
+
+    // 1 → zostaje warstwa statyczna, 0 → piksel danych
+    MaskBlt(m_backDC, 0, 0, w, h, m_dataDC, 0, 0, m_maskBitmap, 0, 0, MAKEROP4(ROP_DSTCOPY, SRCCOPY));
+}
+
+// ============================================================================
+// Renderowanie
+// ============================================================================
+void Chart::render(HDC hdc) {
+    RECT clientRect;
+    GetClientRect(m_hwnd, &clientRect);
+    int w = clientRect.right - clientRect.left;
+    int h = clientRect.bottom - clientRect.top;
+    if (w <= 0 || h <= 0) return;
     
-    // Pozyskaj zakres wartości Y
-    double minY = getMinValue();
-    double maxY = getMaxValue();
+    // Double buffering — bufory i zasoby GDI żyją między klatkami
+    bool resized = !m_backDC || w != m_bufferWidth || h != m_bufferHeight;
+    ensureBuffers(hdc, w, h);
     
-    const int horizontalLines = 4;
-    int stepY = (rect.bottom - rect.top - 40) / horizontalLines;
+    // Oś czasu, źródła próbek i skala Y — raz na klatkę (ChartPlot)
+    m_plot.beginFrame(w, h);
     
-    // Etykiety osi Y
-    for (int i = 0; i <= horizontalLines; i++) {
-        int y = rect.bottom - 20 - i * stepY;
-        double value = minY + (maxY - minY) * i / horizontalLines;
-        
-        // Formatowanie etykiety
-        wchar_t label[32];
-        _snwprintf(label, 32, L"%.2f", value);
-        
-        RECT labelRect = {rect.left, y - 8, rect.left + 48, y + 8};
-        DrawTextW(hdc, label, -1, &labelRect, DT_RIGHT | DT_VCENTER | DT_SINGLELINE);
+    // Siatka, osie i tytuł przerysowywane tylko po zmianie skali lub rozmiaru
+    if (resized || !m_plot.staticLayerValid()) {
+        m_canvas.attach(m_staticDC, w, h);
+        m_plot.drawStatic(m_canvas);
     }
     
-    // Etykiety osi X (czas w sekundach)
-    const int verticalLines = 6;
-    int stepX = (rect.right - rect.left - 60) / verticalLines;
-    
-    for (int i = 0; i <= verticalLines; i++) {
-        int x = rect.left + 50 + i * stepX;
-        double timeSec = m_timeWindowSec * (1.0 - (double)i / verticalLines);
-        
-        // Formatowanie etykiety czasu
-        wchar_t label[32];
-        if (timeSec < 0.0005)
-            _snwprintf(label, 32, L"0");
-        else if (m_timeWindowSec < 0.01)
-            _snwprintf(label, 32, L"-%.1fms", timeSec * 1000.0);
-        else if (m_timeWindowSec < 0.1)
-            _snwprintf(label, 32, L"-%.0fms", timeSec * 1000.0);
-        else if (m_timeWindowSec <= 5.0)
-            _snwprintf(label, 32, L"-%.2fs", timeSec);
-        else
-            _snwprintf(label, 32, L"-%ds", (int)timeSec);
-        
-        RECT labelRect = {x - 20, rect.bottom - 20, x + 20, rect.bottom};
-        DrawTextW(hdc, label, -1, &labelRect, DT_CENTER | DT_TOP | DT_SINGLELINE);
+    // Klatka = warstwa statyczna + dane
+    BitBlt(m_backDC, 0, 0, w, h, m_staticDC, 0, 0, SRCCOPY);
+    if (m_plot.scrollingActive()) {
+        // Strip chart: warstwa danych przesunięta o upływ czasu, rysowane tylko nowe kolumny
+        ensureDataLayer(hdc, w, h);
+        m_canvas.attach(m_dataDC, w, h);
+        m_plot.drawDataLayer(m_canvas, (ChartColor)DATA_LAYER_KEY);
+        composeDataLayer(w, h);
+    } else {
+        m_canvas.attach(m_backDC, w, h);
+        m_plot.drawData(m_canvas);
     }
     
-    // Jednostka miary (z ostatniego punktu danych)
-    if (!m_dataPoints.empty()) {
-        const std::wstring& unit = m_dataPoints.back().unit;
-        RECT unitRect = {rect.left, rect.top, rect.left + 50, rect.top + 20};
-        DrawTextW(hdc, unit.c_str(), -1, &unitRect, DT_LEFT | DT_TOP);
-    }
-    
-    // Przywróć oryginalne obiekty i usuń utworzone
-    SelectObject(hdc, oldFont);
-    DeleteObject(font);
+    // Kursory i odczyty — poza warstwami, zawsze na wierzchu
+    m_canvas.attach(m_backDC, w, h);
+    m_plot.drawOverlay(m_canvas);
     
-    SelectObject(hdc, oldPen);
-    DeleteObject(axisPen);
+    // Blit to screen
+    BitBlt(hdc, 0, 0, w, h, m_backDC, 0, 0, SRCCOPY);
 }
 
-void Chart::drawData(HDC hdc, const RECT& rect) {
-    if (m_dataPoints.empty()) {
-        return;
+bool Chart::saveImage(const std::string& path, int width, int height) {
+    if (width <= 0 || height <= 0) {
+        RECT clientRect = { 0, 0, m_width, m_height };
+        if (m_hwnd) GetClientRect(m_hwnd, &clientRect);
+        width = clientRect.right - clientRect.left;
+        height = clientRect.bottom - clientRect.top;
     }
     
-    // Utwórz pióro dla danych
-    HPEN dataPen = CreatePen(PS_SOLID, m_lineWidth, m_dataColor);
-    HPEN oldPen = (HPEN)SelectObject(hdc, dataPen);
-    
-    // Zakres wartości Y
-    double minY = getMinValue();
-    double maxY = getMaxValue();
-    
-    // Jeśli min i max są takie same (płaska linia), dodaj margines
-    if (std::fabs(maxY - minY) < 0.001) {
-        minY = minY * 0.9;
-        maxY = maxY * 1.1;
-        
-        // Specjalny przypadek dla zera
-        if (std::fabs(minY) < 0.001 && std::fabs(maxY) < 0.001) {
-            minY = -1.0;
-            maxY = 1.0;
-        }
-    }
-    
-    // Szerokość i wysokość obszaru wykresu
-    int chartWidth = rect.right - rect.left - 60;
-    int chartHeight = rect.bottom - rect.top - 40;
-    
-    // Czas referencyjny: najnowszy punkt danych (nie wall-clock now)
-    // Dzięki temu dane są zawsze widoczne — prawy brzeg = najnowsza próbka
-    auto refTime = m_dataPoints.back().timestamp;
-
-    // Trigger mode: rising zero-crossing sync (oscilloscope-style)
-    // Search backward from newest data — find the most recent crossing
-    // that has at least one full time window of data after it.
-    // This gives a stable display: the trigger only advances by one cycle
-    // per waveform period, and stays locked between transitions.
-    if (m_triggerEnabled && m_dataPoints.size() > 1) {
-        auto windowUs = std::chrono::microseconds(
-            static_cast<long long>(m_timeWindowSec * 1000000.0));
-        auto latestTime = m_dataPoints.back().timestamp;
-
-        for (size_t i = m_dataPoints.size() - 1; i > 0; i--) {
-            if (m_dataPoints[i - 1].value <= 0.0 && m_dataPoints[i].value > 0.0) {
-                auto timeAfter = std::chrono::duration_cast<std::chrono::microseconds>(
-                    latestTime - m_dataPoints[i].timestamp);
-                if (timeAfter >= windowUs) {
-                    // Most recent eligible trigger — set left edge here
-                    refTime = m_dataPoints[i].timestamp + windowUs;
-                    break;
-                }
-            }
-        }
-    }
-    
-    // Rysowanie linii łączącej punkty danych
-    bool first = true;
-    for (const auto& point : m_dataPoints) {
-        // Oblicz pozycję X na podstawie czasu
-        auto timeDiff = std::chrono::duration_cast<std::chrono::microseconds>(refTime - point.timestamp).count();
-        double xRatio = 1.0 - (double)timeDiff / (m_timeWindowSec * 1000000.0);
-        
-        if (xRatio < 0) continue;  // Punkt poza zakresem czasu
-        
-        // Oblicz pozycję Y na podstawie wartości
-        double yRatio = (point.value - minY) / (maxY - minY);
-        if (yRatio < 0) yRatio = 0;
-        if (yRatio > 1) yRatio = 1;
-        
-        int x = rect.left + 50 + static_cast<int>(xRatio * chartWidth);
-        int y = rect.bottom - 20 - static_cast<int>(yRatio * chartHeight);
-        
-        if (first || point.isNewSegment) {
-            MoveToEx(hdc, x, y, NULL);
-            first = false;
-        } else {
-            LineTo(hdc, x, y);
-        }
-    }
-    
-    // Przywróć oryginalne pióro i usuń utworzone
-    SelectObject(hdc, oldPen);
-    DeleteObject(dataPen);
-    
-    // Pomijaj kropki dla gęstych danych
-    if (m_dataPoints.size() > 200) return;
-    
-    // Narysuj punkty danych
-    for (const auto& point : m_dataPoints) {
-        // Oblicz pozycję X na podstawie czasu
-        auto timeDiff = std::chrono::duration_cast<std::chrono::microseconds>(refTime - point.timestamp).count();
-        double xRatio = 1.0 - (double)timeDiff / (m_timeWindowSec * 1000000.0);
-        
-        if (xRatio < 0) continue;  // Punkt poza zakresem czasu
-        
-        // Oblicz pozycję Y na podstawie wartości
-        double yRatio = (point.value - minY) / (maxY - minY);
-        if (yRatio < 0) yRatio = 0;
-        if (yRatio > 1) yRatio = 1;
-        
-        int x = rect.left + 50 + static_cast<int>(xRatio * chartWidth);
-        int y = rect.bottom - 20 - static_cast<int>(yRatio * chartHeight);
-        
-        // Narysuj punkt
-        HBRUSH pointBrush = CreateSolidBrush(m_dataColor);
-        HBRUSH oldBrush = (HBRUSH)SelectObject(hdc, pointBrush);
-        
-        Ellipse(hdc, x - 3, y - 3, x + 3, y + 3);
-        
-        SelectObject(hdc, oldBrush);
-        DeleteObject(pointBrush);
-    }
-}
\ No newline at end of file
+    ChartRaster raster(width, height);
+    m_plot.renderExport(raster);
+    invalidate();
+    return raster.save(path);
+}
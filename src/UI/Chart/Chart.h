@@ -7,22 +7,18 @@
 
 #include "Core.h"
 #include "../UIComponent.h"
+#include "ChartPlot.h"
+#include "ChartGdiCanvas.h"
+#include "ChartIngestQueue.h"
 #include <string>
 #include <vector>
-#include <deque>
 #include <chrono>
 #include <functional>
 #include <map>
+#include <memory>
 
 class Chart : public UIComponent {
 public:
-    struct DataPoint {
-        double value;
-        std::chrono::steady_clock::time_point timestamp;
-        std::wstring unit;
-        bool isNewSegment = false;
-    };
-
     Chart(int x, int y, int width, int height, const char* title = "Wykres pomiarów");
     ~Chart() override;
 
@@ -31,6 +27,31 @@ public:
     void addDataPoints(const double* values, int count, double totalDurationMs);
     void render(HDC hdc);
     void clear();
+
+    // Serie danych — wspólna oś czasu, jedno przejście renderowania.
+    // Seria 0 istnieje zawsze i jest zasilana przez addDataPoint(s).
+    int  addSeries(const std::wstring& name, COLORREF color,
+                   const std::wstring& unit = L"", bool secondaryAxis = false);
+    void addSeriesPoint(int series, double value);
+    void addSeriesPoints(int series, const double* values, int count, double totalDurationMs);
+    void setSeriesVisible(int series, bool visible);
+    void setSeriesColor(int series, COLORREF color);
+    void setSeriesUnit(int series, const std::wstring& unit);
+    void setSeriesAxis(int series, bool secondaryAxis);
+    int  getSeriesCount() const { return m_plot.getSeriesCount(); }
+    bool isSeriesVisible(int series) const { return m_plot.isSeriesVisible(series); }
+
+    // Wielowątkowe zasilanie: post*() można wołać z dowolnego wątku (bez blokad).
+    // Dane trafiają do kolejki lock-free, którą wykres opróżnia na timerze UI
+    // (co setRefreshRate ms) — jedno odświeżenie na klatkę.
+    // enableThreadedIngest() wywołaj z wątku UI przed startem producentów.
+    void enableThreadedIngest(size_t capacity = 65536);
+    bool postDataPoint(int series, double value);
+    bool postDataPoints(int series, const double* values, int count, double totalDurationMs);
+    // Widmo policzone przez producenta (np. własny ChartSpectrum / FFT w wątku pomiarowym)
+    bool postSpectrum(const double* magnitudes, int bins, double binHz);
+    uint64_t getDroppedSampleCount() const { return m_ingest ? m_ingest->droppedCount() : 0; }
+    void drainIngest();     // Wywoływane z WM_TIMER
     
     // Gettery
     int getX() const { return m_x; }
@@ -42,23 +63,101 @@ public:
     int getId() const override { return m_id; }
 
     // Ustawienia wykresu
-    void setTimeWindow(double seconds) { m_timeWindowSec = seconds; }
+    void setTimeWindow(double seconds) { m_plot.setTimeWindow(seconds); }
     void setColors(COLORREF gridColor, COLORREF axisColor, COLORREF dataColor);
-    void setAutoScale(bool autoScale) { m_autoScale = autoScale; }
-    void setYRange(double minY, double maxY) {
-        m_manualMinY = minY;
-        m_manualMaxY = maxY;
-        m_autoScale = false;
-    }
+    void setAutoScale(bool autoScale) { m_plot.setAutoScale(0, autoScale); }
+    void setYRange(double minY, double maxY) { m_plot.setYRange(0, minY, maxY); }
+    // Zakres drugiej (prawej) osi Y — domyślnie autoskalowanie
+    void setSecondaryYRange(double minY, double maxY) { m_plot.setYRange(1, minY, maxY); }
+    // Histereza autoskalowania (0 = wyłączona). Oś Y rozszerza się od razu,
+    // a zwęża dopiero gdy zakres danych spadnie poniżej (1 - fraction) zakresu osi.
+    void setAutoScaleHysteresis(double fraction) { m_plot.setAutoScaleHysteresis(fraction); }
     
     // Ustawienie limitu odświeżania
-    void setRefreshRate(int millisecondsInterval) { m_refreshInterval = millisecondsInterval; }
+    void setRefreshRate(int millisecondsInterval);
 
-    // Trigger mode — oscilloscope-style rising zero-crossing sync
-    void setTriggerEnabled(bool enabled) { m_triggerEnabled = enabled; }
+    // Trigger mode — oscilloscope-style sync on series 0 (domyślnie: zbocze
+    // narastające przez 0, tryb AUTO)
+    void setTriggerEnabled(bool enabled) { m_plot.setTriggerEnabled(enabled); }
+    void setTriggerLevel(double level, ChartTriggerEdge edge = CHART_TRIGGER_RISING, double hysteresis = 0.0) {
+        m_plot.setTriggerLevel(level, edge, hysteresis);
+    }
+    void setTriggerHoldoff(double seconds) { m_plot.setTriggerHoldoff(seconds); }
+    void setTriggerMode(ChartTriggerMode mode);
+    ChartTriggerMode getTriggerMode() const { return m_plot.getTriggerMode(); }
+    void armTrigger();                  // SINGLE: czekaj na następne wyzwolenie
+    bool isTriggered() const { return m_plot.isTriggered(); }
 
     // Line width for data rendering (default: 2)
-    void setLineWidth(int width) { m_lineWidth = width; }
+    void setLineWidth(int width) { m_plot.setLineWidth(width); }
+
+    // Redukcja próbek przed rysowaniem (domyślnie obwiednia min/max na piksel)
+    void setDecimation(ChartDecimation mode) { m_plot.setDecimation(mode); }
+    ChartDecimation getDecimation() const    { return m_plot.getDecimation(); }
+
+    // Strip chart: warstwa danych przesuwana między klatkami (ScrollDC), rysowane
+    // tylko nowo odsłonięte kolumny. Pełne przerysowanie po zmianie skali lub
+    // rozmiaru. Działa w trybie czasu bez triggera.
+    void setScrolling(bool enabled) { m_plot.setScrolling(enabled); invalidate(); }
+    bool isScrolling() const { return m_plot.isScrolling(); }
+
+    // Warstwy historii dla długich okien czasowych: surowe próbki tylko przez
+    // rawSeconds, starsze dane jako kubełki 16^L próbek (first/last/min/max).
+    // rawSeconds = 0 wyłącza warstwy (domyślnie — wszystko w surowych próbkach).
+    void setHistoryTiers(double rawSeconds, size_t bucketsPerLevel = 16384);
+
+    // Budżet pamięci: wszystkie bufory alokowane raz, potem stała pojemność —
+    // najstarsze surowe próbki nadpisywane, starsza część okna z warstw historii.
+    // Dzielony równo między serie. 0 = bez limitu (domyślnie).
+    void setMemoryBudget(size_t maxBytes);
+    void setPointBudget(size_t maxPoints);
+    size_t getMemoryBudget() const { return m_plot.getMemoryBudget(); }
+
+    // Tryb widma — amplituda serii 0 w dB na osi częstotliwości (log lub lin).
+    // addDataPoints() liczy FFT z każdej paczki (fs = count / totalDurationMs);
+    // addSpectrumSamples() dla znanej fs, setSpectrum() dla gotowego widma.
+    void setDisplayMode(ChartDisplayMode mode);
+    ChartDisplayMode getDisplayMode() const { return m_plot.getDisplayMode(); }
+    void configureSpectrum(size_t fftSize, FFTWindow window = FFT_WINDOW_HANN);
+    void setSpectrumAveraging(int frames) { m_plot.setSpectrumAveraging(frames); }
+    void setSpectrumPeakHold(bool enabled) { m_plot.setSpectrumPeakHold(enabled); }
+    void resetSpectrumPeaks() { m_plot.resetSpectrumPeaks(); }
+    void setSpectrumLogFrequency(bool logFrequency) { m_plot.setSpectrumLogFrequency(logFrequency); }
+    void setSpectrumRange(double minDb = -120.0, double maxDb = 0.0) { m_plot.setSpectrumRange(minDb, maxDb); }
+    void setSpectrumFrequencyRange(double minHz, double maxHz) { m_plot.setSpectrumFrequencyRange(minHz, maxHz); }
+    void addSpectrumSamples(const double* samples, int count, double sampleRate);
+    void setSpectrum(const double* magnitudes, size_t bins, double binHz);
+
+    // Tryb poświaty (CHART_MODE_PERSISTENCE) — seria 0 rysowana jako gęstość
+    // trafień na piksel z zanikiem; próbki nie są przechowywane.
+    void setPersistenceDecay(double seconds) { m_plot.setPersistenceDecay(seconds); }
+    void setPersistencePalette(ChartPersistencePalette palette) { m_plot.setPersistencePalette(palette); invalidate(); }
+    void clearPersistence() { m_plot.clearPersistence(); invalidate(); }
+
+    // Kursory pomiarowe (tryb czasu): czasu — sekundy od lewej krawędzi okna,
+    // wartości — jednostki lewej osi. Przeciągane myszą. Odczyty Δt, 1/Δt, ΔV
+    // oraz min/max/średnia/RMS serii między kursorami czasu, liczone raz na klatkę.
+    void setTimeCursors(bool enabled, double t1Sec = 0.0, double t2Sec = 0.0);
+    void setValueCursors(bool enabled, double v1 = 0.0, double v2 = 0.0);
+    void setCursorSeries(int series) { m_plot.setCursorSeries(series); invalidate(); }
+    const ChartMeasurement& getMeasurement() const { return m_plot.getMeasurement(); }
+
+    // Obsługa myszy (przeciąganie kursorów) — wywoływane z procedury okna
+    void mouseDown(int x, int y);
+    void mouseMove(int x, int y);
+    void mouseUp();
+
+    // Sample storage (sum over all series)
+    size_t getPointCount() const { return m_plot.getPointCount(); }
+    size_t getMemoryUsage() const { return m_plot.getMemoryUsage(); }
+    const std::wstring& getUnit() const { return m_plot.getSeriesUnit(0); }
+
+    // Zapis bieżącej klatki do pliku (PNG lub PPM wg rozszerzenia) przez
+    // rasteryzer programowy — działa także bez okna. 0 = rozmiar kontrolki.
+    bool saveImage(const std::string& path, int width = 0, int height = 0);
+
+    // Model i geometria wykresu (bez GDI) — np. do renderowania offscreen
+    ChartPlot& getPlot() { return m_plot; }
 
 private:
     int m_x;
@@ -70,41 +169,48 @@ private:
     int m_id;
     static int s_nextId;
 
-    std::deque<DataPoint> m_dataPoints;
-    double m_timeWindowSec = 30.0; // Domyślnie pokazuje 30 sekund
-    
-    COLORREF m_gridColor = RGB(80, 80, 80);
-    COLORREF m_axisColor = RGB(200, 200, 200);
-    COLORREF m_dataColor = RGB(0, 255, 0);
-    
-    bool m_autoScale = true;
-    double m_manualMinY = 0.0;
-    double m_manualMaxY = 10.0;
+    // Dane, skala, trigger i geometria klatki — niezależne od GDI
+    ChartPlot m_plot;
     
     // Zmienne do ograniczania częstotliwości odświeżania
     int m_refreshInterval = 100; // Domyślnie 100ms (10 FPS)
     std::chrono::steady_clock::time_point m_lastRefreshTime;
     bool m_dataChanged = false; // Flaga wskazująca, że dane się zmieniły od ostatniego odświeżenia
     
-    // Pomocnicze funkcje do rysowania
-    void drawGrid(HDC hdc, const RECT& rect);
-    void drawAxes(HDC hdc, const RECT& rect);
-    void drawData(HDC hdc, const RECT& rect);
-    
-    // Funkcja do usuwania starych punktów danych
-    void cleanOldDataPoints();
-    
-    // Trigger mode (oscilloscope-style zero-crossing sync)
-    bool m_triggerEnabled = false;
-    int m_lineWidth = 2;
+    // Zasoby GDI utrzymywane między klatkami
+    HDC m_backDC = NULL;                // Bufor tylny — realokowany tylko przy zmianie rozmiaru
+    HBITMAP m_backBitmap = NULL;
+    HBITMAP m_backOldBitmap = NULL;
+    HDC m_staticDC = NULL;              // Warstwa statyczna: tło, siatka, osie, tytuł
+    HBITMAP m_staticBitmap = NULL;
+    HBITMAP m_staticOldBitmap = NULL;
+    int m_bufferWidth = 0;
+    int m_bufferHeight = 0;
+    ChartGdiCanvas m_canvas;            // Pióra, pędzle i czcionki z pamięci podręcznej
+    HDC m_dataDC = NULL;                // Warstwa danych w trybie przewijania (tło = kolor klucza)
+    HBITMAP m_dataBitmap = NULL;
+    HBITMAP m_dataOldBitmap = NULL;
+    HDC m_maskDC = NULL;                // Maska 1 bpp warstwy danych: 1 = tło
+    HBITMAP m_maskBitmap = NULL;
+    int m_dataWidth = 0;
+    int m_dataHeight = 0;
 
-    // Tracking batch continuity
-    std::chrono::steady_clock::time_point m_lastBatchEnd;
-    bool m_hasBatchHistory = false;
-    
-    // Funkcje pomocnicze do skalowania danych
-    double getMinValue() const;
-    double getMaxValue() const;
+    void ensureBuffers(HDC hdc, int w, int h);
+    void ensureDataLayer(HDC hdc, int w, int h);
+    void releaseDataLayer();
+    void composeDataLayer(int w, int h);
+    void releaseGdiResources();
+    void invalidate();
+    void requestRefresh();
+
+    ChartCursor m_dragCursor = CHART_CURSOR_NONE;
+
+    // Kolejka producentów wielowątkowych (opcjonalna)
+    std::unique_ptr<ChartIngestQueue> m_ingest;
+    std::vector<double> m_ingestScratch;
+    void startIngestTimer();
+
+    static int64_t nowNs();
 };
 
-#endif // CHART_H
\ No newline at end of file
+#endif // CHART_H
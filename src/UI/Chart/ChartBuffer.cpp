@@ -0,0 +1,271 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 JAQUBA (https://github.com/JAQUBA)
+// Part of JQB_WindowsLib — https://github.com/JAQUBA/JQB_WindowsLib
+
+#include "ChartBuffer.h"
+
+static size_t roundUpPow2(size_t n) {
+    size_t p = 64;
+    while (p < n) p <<= 1;
+    return p;
+}
+
+ChartBuffer::ChartBuffer(size_t initialCapacity)
+    : m_runHead(0)
+    , m_capacity(roundUpPow2(initialCapacity))
+    , m_mask(m_capacity - 1)
+    , m_head(0)
+    , m_count(0)
+    , m_firstSeq(0)
+    , m_fixed(false)
+{
+    m_value.resize(m_capacity);
+    m_segBits.assign(m_capacity / 64, 0);
+}
+
+void ChartBuffer::push(int64_t timeNs, double value, bool newSegment) {
+    if (m_count == m_capacity) {
+        if (m_fixed) popFront(1);
+        else         grow();
+    }
+    if (m_time.empty()) m_time.resize(m_capacity);
+
+    // Kolejne nieregularne próbki dzielą jeden wpis — czas jest w m_time
+    if (m_runs.size() == m_runHead || m_runs.back().uniform) {
+        addRun({ endSeq(), timeNs, 0.0, false });
+    }
+
+    size_t slot = (m_head + m_count) & m_mask;
+    m_time[slot]  = timeNs;
+    m_value[slot] = value;
+
+    uint64_t bit = (uint64_t)1 << (slot & 63);
+    if (newSegment) m_segBits[slot >> 6] |= bit;
+    else            m_segBits[slot >> 6] &= ~bit;
+
+    m_count++;
+}
+
+void ChartBuffer::pushUniform(int64_t startNs, double periodNs, const double* values, size_t count,
+                              bool newSegment) {
+    if (count == 0) return;
+
+    // Stała pojemność: zrób miejsce kosztem najstarszych próbek; z paczki
+    // większej niż cały bufor zostaje tylko jej koniec
+    size_t skip = 0;
+    if (m_fixed) {
+        if (count > m_capacity) skip = count - m_capacity;
+        if (m_count + count - skip > m_capacity) popFront(m_count + count - skip - m_capacity);
+    } else {
+        while (m_count + count > m_capacity) grow();
+    }
+
+    // Paczka w łańcuchu (ten sam okres, start tam, gdzie kończy się poprzednia)
+    // nie dodaje wpisu — cały strumień audio to jeden przebieg
+    bool chained = false;
+    if (m_runs.size() > m_runHead && m_runs.back().uniform && m_runs.back().periodNs == periodNs) {
+        const RunEntry& last = m_runs.back();
+        int64_t expected = last.startNs + (int64_t)((double)(endSeq() - last.firstSeq) * periodNs);
+        int64_t drift = startNs - expected;
+        chained = drift >= -1 && drift <= 1;
+    }
+    if (!chained) addRun({ endSeq(), startNs, periodNs, true });
+
+    // Pominięte próbki liczą się jak usunięte (bufor jest wtedy pusty)
+    m_firstSeq += skip;
+    for (size_t k = skip; k < count; k++) {
+        size_t slot = (m_head + m_count + k - skip) & m_mask;
+        m_value[slot] = values[k];
+        uint64_t bit = (uint64_t)1 << (slot & 63);
+        if (k == skip && newSegment) m_segBits[slot >> 6] |= bit;
+        else                         m_segBits[slot >> 6] &= ~bit;
+    }
+    m_count += count - skip;
+}
+
+void ChartBuffer::addRun(const RunEntry& run) {
+    if (m_fixed && m_runs.size() == m_runs.capacity()) {
+        // Stała pojemność bez realokacji: zwolnij martwy prefiks, a gdy go nie ma —
+        // najstarszy żywy przebieg (zdarza się tylko przy bardzo częstym przeplataniu
+        // paczek i pojedynczych próbek)
+        if (m_runHead == 0 && m_runs.size() > 1) popFront((size_t)(m_runs[1].firstSeq - m_firstSeq));
+        m_runs.erase(m_runs.begin(), m_runs.begin() + (ptrdiff_t)m_runHead);
+        m_runHead = 0;
+    }
+    m_runs.push_back(run);
+}
+
+void ChartBuffer::clear() {
+    m_firstSeq += m_count;
+    m_head  = 0;
+    m_count = 0;
+    m_runs.clear();
+    m_runHead = 0;
+}
+
+static size_t fixedRunReserve(size_t capacity) {
+    return capacity / 64 + 64;
+}
+
+void ChartBuffer::setFixedCapacity(size_t capacity) {
+    if (capacity == 0) {
+        m_fixed = false;
+        return;
+    }
+    capacity = roundUpPow2(capacity);
+    if (m_count > capacity) popFront(m_count - capacity);
+    relayout(capacity, true);
+    m_runs.erase(m_runs.begin(), m_runs.begin() + (ptrdiff_t)m_runHead);
+    m_runHead = 0;
+    std::vector<RunEntry> runs;
+    runs.reserve(fixedRunReserve(capacity));
+    runs.assign(m_runs.begin(), m_runs.end());
+    m_runs.swap(runs);
+    m_fixed = true;
+}
+
+size_t ChartBuffer::fixedBytes(size_t capacity) {
+    capacity = roundUpPow2(capacity);
+    return capacity * (sizeof(double) + sizeof(int64_t)) + capacity / 64 * sizeof(uint64_t) +
+           fixedRunReserve(capacity) * sizeof(RunEntry);
+}
+
+void ChartBuffer::popFront(size_t count) {
+    if (count > m_count) count = m_count;
+    m_head = (m_head + count) & m_mask;
+    m_count -= count;
+    m_firstSeq += count;
+
+    // Wpisy, których wszystkie próbki wypadły
+    while (m_runs.size() - m_runHead > 1 && m_runs[m_runHead + 1].firstSeq <= m_firstSeq) m_runHead++;
+    if (m_count == 0) {
+        m_runs.clear();
+        m_runHead = 0;
+    }
+    // Compact once the dead prefix dominates — amortized O(1) per run
+    if (m_runHead > 64 && m_runHead * 2 > m_runs.size()) {
+        m_runs.erase(m_runs.begin(), m_runs.begin() + (ptrdiff_t)m_runHead);
+        m_runHead = 0;
+    }
+}
+
+void ChartBuffer::dropOlderThan(int64_t cutoffNs) {
+    if (m_count == 0 || timeAt(0) >= cutoffNs) return;
+    popFront(lowerBound(cutoffNs));
+}
+
+size_t ChartBuffer::findRun(uint64_t seq) const {
+    // Ostatni wpis z firstSeq <= seq
+    size_t lo = m_runHead, hi = m_runs.size();
+    while (hi - lo > 1) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (m_runs[mid].firstSeq <= seq) lo = mid;
+        else                             hi = mid;
+    }
+    return lo;
+}
+
+ChartBuffer::Run ChartBuffer::makeRun(size_t index) const {
+    const RunEntry& e = m_runs[index];
+    Run r;
+    r.firstSeq = e.firstSeq;
+    r.endSeq   = index + 1 < m_runs.size() ? m_runs[index + 1].firstSeq : endSeq();
+    r.startNs  = e.startNs;
+    r.periodNs = e.periodNs;
+    r.uniform  = e.uniform;
+    return r;
+}
+
+ChartBuffer::Run ChartBuffer::runAt(size_t i) const {
+    return makeRun(findRun(m_firstSeq + i));
+}
+
+int64_t ChartBuffer::timeAt(size_t i) const {
+    uint64_t seq = m_firstSeq + i;
+    const RunEntry& e = m_runs[findRun(seq)];
+    if (!e.uniform) return m_time[(m_head + i) & m_mask];
+    return e.startNs + (int64_t)((double)(seq - e.firstSeq) * e.periodNs);
+}
+
+size_t ChartBuffer::lowerBound(int64_t timeNs) const {
+    if (m_count == 0) return 0;
+
+    // Najpierw przebieg (po czasie pierwszej próbki), potem indeks w jego obrębie
+    size_t lo = m_runHead, hi = m_runs.size();
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        uint64_t seq = m_runs[mid].firstSeq > m_firstSeq ? m_runs[mid].firstSeq : m_firstSeq;
+        if (timeAt((size_t)(seq - m_firstSeq)) < timeNs) lo = mid + 1;
+        else                                              hi = mid;
+    }
+    if (lo == m_runHead) return 0;
+    Run r = makeRun(lo - 1);
+
+    // Szukana próbka jest w przebiegu lo - 1 (albo to pierwsza próbka następnego)
+    size_t from = (size_t)((r.firstSeq > m_firstSeq ? r.firstSeq : m_firstSeq) - m_firstSeq);
+    size_t to   = (size_t)(r.endSeq - m_firstSeq);
+    if (r.uniform && r.periodNs > 0.0) {
+        // Pozycja z okresu, poprawiana o zaokrąglenie
+        double k = (double)(timeNs - r.startNs) / r.periodNs;
+        double maxK = (double)(r.endSeq - r.firstSeq);
+        if (k > maxK) k = maxK;
+        size_t guess = (size_t)(r.firstSeq - m_firstSeq) + (k > 0.0 ? (size_t)k : 0);
+        if (guess < from) guess = from;
+        if (guess > to) guess = to;
+        while (guess > from && uniformTime(r, m_firstSeq + guess - 1) >= timeNs) guess--;
+        while (guess < to && uniformTime(r, m_firstSeq + guess) < timeNs) guess++;
+        return guess;
+    }
+    while (from < to) {
+        size_t mid = from + (to - from) / 2;
+        if (timeAt(mid) < timeNs) from = mid + 1;
+        else                      to = mid;
+    }
+    return from;
+}
+
+int ChartBuffer::chunks(size_t first, size_t count, Chunk out[2]) const {
+    if (first >= m_count || count == 0) return 0;
+    if (count > m_count - first) count = m_count - first;
+
+    const int64_t* time = m_time.empty() ? nullptr : m_time.data();
+    size_t slot = (m_head + first) & m_mask;
+    size_t run  = m_capacity - slot;
+    if (run >= count) {
+        out[0] = { time ? time + slot : nullptr, &m_value[slot], first, count };
+        return 1;
+    }
+    out[0] = { time ? time + slot : nullptr, &m_value[slot], first, run };
+    out[1] = { time, &m_value[0], first + run, count - run };
+    return 2;
+}
+
+size_t ChartBuffer::memoryBytes() const {
+    return m_value.size() * sizeof(double) + m_time.size() * sizeof(int64_t) +
+           m_segBits.size() * sizeof(uint64_t) + m_runs.capacity() * sizeof(RunEntry);
+}
+
+void ChartBuffer::grow() {
+    relayout(m_capacity * 2, !m_time.empty());
+}
+
+void ChartBuffer::relayout(size_t newCap, bool withTime) {
+    std::vector<double>   value(newCap);
+    std::vector<int64_t>  time(withTime ? newCap : 0);
+    std::vector<uint64_t> segBits(newCap / 64, 0);
+
+    // Linearize: oldest sample lands at slot 0
+    for (size_t i = 0; i < m_count; i++) {
+        size_t slot = (m_head + i) & m_mask;
+        value[i] = m_value[slot];
+        if (withTime && !m_time.empty()) time[i] = m_time[slot];
+        if (isSegmentStart(i)) segBits[i >> 6] |= (uint64_t)1 << (i & 63);
+    }
+
+    m_value.swap(value);
+    m_time.swap(time);
+    m_segBits.swap(segBits);
+    m_capacity = newCap;
+    m_mask     = newCap - 1;
+    m_head     = 0;
+}
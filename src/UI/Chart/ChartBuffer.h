@@ -0,0 +1,139 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 JAQUBA (https://github.com/JAQUBA)
+// Part of JQB_WindowsLib — https://github.com/JAQUBA/JQB_WindowsLib
+
+/**
+ * ChartBuffer.h — columnar (structure-of-arrays) ring buffer for Chart samples
+ *
+ * Values (double) and segment markers (bitset) are kept in separate
+ * preallocated arrays. Capacity is a power of two and grows by doubling only
+ * when the ring is full. Removing old samples only advances the head index,
+ * so trimming the time window never copies data.
+ *
+ * Fixed-capacity mode (memory budget): both columns are allocated once and a
+ * full ring overwrites its oldest samples instead of growing.
+ *
+ * Time is stored per run, not per sample. A uniform run (one or more chained
+ * batches at the same sample rate) is just start time + period — sample k is
+ * at startNs + k * periodNs. Only irregular samples (push()) keep an explicit
+ * int64 timestamp; that column is allocated on first use.
+ *
+ * Nie zależy od WinAPI — może być używany poza oknem wykresu.
+ */
+
+#ifndef CHART_BUFFER_H
+#define CHART_BUFFER_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+class ChartBuffer {
+public:
+    // Contiguous run of samples inside the ring (at most two per range).
+    // time[] is valid only for samples of explicit (non-uniform) runs.
+    struct Chunk {
+        const int64_t* time;
+        const double*  value;
+        size_t         first;   // logical index of value[0]
+        size_t         count;
+    };
+
+    // Samples sharing one time base. Sample with sequence number q is at
+    // time(q) — startNs + (q - firstSeq) * periodNs for uniform runs.
+    struct Run {
+        uint64_t firstSeq;
+        uint64_t endSeq;
+        int64_t  startNs;
+        double   periodNs;
+        bool     uniform;
+    };
+
+    explicit ChartBuffer(size_t initialCapacity = 4096);
+
+    // Irregular sample with an explicit timestamp
+    void push(int64_t timeNs, double value, bool newSegment = false);
+    // Evenly spaced samples: values[k] at startNs + k * periodNs. Continues the
+    // previous run when it is uniform, has the same period and ends at startNs.
+    void pushUniform(int64_t startNs, double periodNs, const double* values, size_t count,
+                     bool newSegment = false);
+    void clear();
+
+    // Stała pojemność (budżet pamięci): kolumny wartości i czasu alokowane raz,
+    // pełny bufor nadpisuje najstarsze próbki. Zachowuje najnowsze próbki.
+    // 0 = powrót do bufora rosnącego.
+    void setFixedCapacity(size_t capacity);
+    bool isFixed() const { return m_fixed; }
+    // Bytes used by setFixedCapacity(capacity)
+    static size_t fixedBytes(size_t capacity);
+
+    // Drop samples from the front (oldest first)
+    void popFront(size_t count);
+    // Drop every sample with timestamp < cutoffNs (binary search, no per-sample work)
+    void dropOlderThan(int64_t cutoffNs);
+
+    size_t size()     const { return m_count; }
+    bool   empty()    const { return m_count == 0; }
+    size_t capacity() const { return m_capacity; }
+
+    // Logical index: 0 = oldest retained sample, size()-1 = newest
+    int64_t timeAt(size_t i) const;
+    double  valueAt(size_t i) const { return m_value[(m_head + i) & m_mask]; }
+    bool    isSegmentStart(size_t i) const {
+        size_t slot = (m_head + i) & m_mask;
+        return (m_segBits[slot >> 6] >> (slot & 63)) & 1u;
+    }
+
+    int64_t oldestTime() const { return timeAt(0); }
+    int64_t newestTime() const { return timeAt(m_count - 1); }
+    double  newestValue() const { return valueAt(m_count - 1); }
+
+    // Monotonic sample sequence numbers (never reused, survive wrap-around)
+    uint64_t firstSeq() const { return m_firstSeq; }
+    uint64_t endSeq()   const { return m_firstSeq + m_count; }
+
+    // Time base of the run holding logical index i (i < size())
+    Run runAt(size_t i) const;
+    // Timestamp of sample q inside uniform run r — the one multiply-add used everywhere
+    static int64_t uniformTime(const Run& r, uint64_t seq) {
+        return r.startNs + (int64_t)((double)(seq - r.firstSeq) * r.periodNs);
+    }
+
+    // First logical index whose timestamp is >= timeNs (size() if none)
+    size_t lowerBound(int64_t timeNs) const;
+
+    // Split logical range [first, first+count) into contiguous chunks.
+    // Returns number of chunks written to out (0, 1 or 2).
+    int chunks(size_t first, size_t count, Chunk out[2]) const;
+
+    // Bytes held by the preallocated arrays and the run table
+    size_t memoryBytes() const;
+
+private:
+    struct RunEntry {
+        uint64_t firstSeq;
+        int64_t  startNs;
+        double   periodNs;
+        bool     uniform;
+    };
+
+    std::vector<double>   m_value;
+    std::vector<int64_t>  m_time;       // Tylko próbki push() — pusty, dopóki nie ma żadnej
+    std::vector<uint64_t> m_segBits;
+    std::vector<RunEntry> m_runs;       // Rosnąco po firstSeq, martwy prefiks do m_runHead
+    size_t   m_runHead;
+    size_t   m_capacity;
+    size_t   m_mask;
+    size_t   m_head;
+    size_t   m_count;
+    uint64_t m_firstSeq;
+    bool     m_fixed;
+
+    void addRun(const RunEntry& run);
+    size_t findRun(uint64_t seq) const;
+    Run makeRun(size_t index) const;
+    void grow();
+    void relayout(size_t newCap, bool withTime);
+};
+
+#endif // CHART_BUFFER_H
@@ -0,0 +1,85 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 JAQUBA (https://github.com/JAQUBA)
+// Part of JQB_WindowsLib — https://github.com/JAQUBA/JQB_WindowsLib
+
+/**
+ * ChartCanvas.h — drawing backend interface used by ChartPlot
+ *
+ * ChartPlot computes the whole frame geometry (scale, decimation, trigger,
+ * ticks) and issues a short list of primitives through this interface.
+ * Backends: ChartGdiCanvas (window, WinAPI GDI) and ChartRaster (memory RGBA
+ * buffer with PNG/PPM export, no WinAPI).
+ *
+ * Nie zależy od WinAPI.
+ */
+
+#ifndef CHART_CANVAS_H
+#define CHART_CANVAS_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+// Colour in COLORREF layout (0x00BBGGRR) — RGB() values can be passed directly
+typedef uint32_t ChartColor;
+
+inline ChartColor chartRgb(uint8_t r, uint8_t g, uint8_t b) {
+    return (ChartColor)r | ((ChartColor)g << 8) | ((ChartColor)b << 16);
+}
+inline uint8_t chartRed(ChartColor c)   { return (uint8_t)(c & 0xFF); }
+inline uint8_t chartGreen(ChartColor c) { return (uint8_t)((c >> 8) & 0xFF); }
+inline uint8_t chartBlue(ChartColor c)  { return (uint8_t)((c >> 16) & 0xFF); }
+
+// Pixel left untouched by ChartCanvas::image() (not a valid COLORREF)
+const ChartColor CHART_COLOR_NONE = 0xFF000000;
+
+// Same memory layout as WinAPI POINT (two 32-bit ints)
+struct ChartPoint {
+    int32_t x;
+    int32_t y;
+};
+
+struct ChartRect {
+    int left;
+    int top;
+    int right;
+    int bottom;
+};
+
+enum ChartTextAlign {
+    CHART_TEXT_LEFT    = 0x00,
+    CHART_TEXT_CENTER  = 0x01,
+    CHART_TEXT_RIGHT   = 0x02,
+    CHART_TEXT_TOP     = 0x00,
+    CHART_TEXT_VCENTER = 0x10
+};
+
+enum ChartFont {
+    CHART_FONT_LABEL = 0,       // axis labels, units, legend
+    CHART_FONT_TITLE
+};
+
+class ChartCanvas {
+public:
+    virtual ~ChartCanvas() {}
+
+    virtual int width() const = 0;
+    virtual int height() const = 0;
+
+    virtual void fillRect(const ChartRect& rect, ChartColor color) = 0;
+    virtual void line(int x0, int y0, int x1, int y1, ChartColor color, int width, bool dotted) = 0;
+    // Runs of connected points — same data as GDI PolyPolyline()
+    virtual void polyPolyline(const ChartPoint* points, const uint32_t* runs, size_t runCount,
+                              ChartColor color, int width) = 0;
+    // Filled circles (data point markers)
+    virtual void dots(const ChartPoint* points, size_t count, int radius, ChartColor color) = 0;
+    // Shift pixels inside rect by dx (negative = left), fill the exposed columns
+    virtual void scroll(const ChartRect& rect, int dx, ChartColor fill) = 0;
+    // Pixel block of box size (rows top-down), CHART_COLOR_NONE keeps the background
+    virtual void image(const ChartRect& box, const ChartColor* pixels) = 0;
+    // Single-line text inside box, flags = ChartTextAlign combination
+    virtual void text(const ChartRect& box, const std::wstring& str, ChartColor color,
+                      ChartFont font, int flags) = 0;
+};
+
+#endif // CHART_CANVAS_H
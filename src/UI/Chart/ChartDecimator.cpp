@@ -0,0 +1,286 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 JAQUBA (https://github.com/JAQUBA)
+// Part of JQB_WindowsLib — https://github.com/JAQUBA/JQB_WindowsLib
+
+#include "ChartDecimator.h"
+#include <cmath>
+
+void ChartDecimator::build(const ChartBuffer& buffer, size_t first, size_t count, const ChartViewport& vp) {
+    m_points.clear();
+    m_runs.clear();
+    if (count == 0 || vp.width <= 0 || vp.windowNs <= 0) return;
+
+    mapSamples(buffer, first, count, vp);
+
+    switch (m_mode) {
+        case CHART_DECIMATE_NONE:   buildRaw(count); break;
+        case CHART_DECIMATE_LTTB:   buildLttb(count, vp.width); break;
+        case CHART_DECIMATE_MINMAX:
+        default:                    buildMinMax(count); break;
+    }
+}
+
+// ============================================================================
+// Sample → pixel mapping (tight loops over contiguous ring chunks)
+// ============================================================================
+void ChartDecimator::mapSamples(const ChartBuffer& buffer, size_t first, size_t count, const ChartViewport& vp) {
+    if (m_scratchX.size() < count) {
+        m_scratchX.resize(count);
+        m_scratchY.resize(count);
+        m_scratchBreak.resize(count);
+    }
+
+    double range  = vp.maxY - vp.minY;
+    double xScale = vp.width / (double)vp.windowNs;
+    double yScale = range != 0.0 ? vp.height / range : 0.0;
+    double xRight = vp.left + vp.width;
+    double yMax   = vp.height;
+
+    ChartBuffer::Chunk chunks[2];
+    int n = buffer.chunks(first, count, chunks);
+    size_t k = 0;
+    for (int c = 0; c < n; c++) {
+        const int64_t* t = chunks[c].time;
+        const double*  v = chunks[c].value;
+        double* xs = &m_scratchX[k];
+        double* ys = &m_scratchY[k];
+        size_t  len = chunks[c].count;
+        for (size_t i = 0; i < len; i++) {
+            // NaN (brak próbki, nieskończony zakres) → dół wykresu, nie rzutowanie NaN na int
+            double y = (v[i] - vp.minY) * yScale;
+            y = y > 0.0 ? (y < yMax ? y : yMax) : 0.0;
+            ys[i] = vp.bottom - y;
+        }
+
+        // Czas: przebiegi jednorodne — x = x0 + k·dx, nieregularne — z tablicy czasów
+        size_t i = 0;
+        while (i < len) {
+            ChartBuffer::Run run = buffer.runAt(chunks[c].first + i);
+            uint64_t seq = buffer.firstSeq() + chunks[c].first + i;
+            size_t stop = i + (size_t)(run.endSeq - seq);
+            if (stop > len) stop = len;
+            if (run.uniform) {
+                double dx = run.periodNs * xScale;
+                double x0 = xRight - (double)(vp.refTimeNs - run.startNs) * xScale +
+                            (double)(seq - run.firstSeq) * dx;
+                for (size_t j = i; j < stop; j++) xs[j] = x0 + (double)(j - i) * dx;
+            } else {
+                for (size_t j = i; j < stop; j++) xs[j] = xRight - (double)(vp.refTimeNs - t[j]) * xScale;
+            }
+            i = stop;
+        }
+        k += len;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        m_scratchBreak[i] = buffer.isSegmentStart(first + i) ? 1 : 0;
+    }
+}
+
+void ChartDecimator::endRun(size_t runStart) {
+    size_t len = m_points.size() - runStart;
+    if (len == 0) return;
+    // PolyPolyline needs at least two vertices per run
+    if (len == 1) {
+        m_points.push_back(m_points.back());
+        len = 2;
+    }
+    m_runs.push_back((uint32_t)len);
+}
+
+// ============================================================================
+// CHART_DECIMATE_NONE
+// ============================================================================
+void ChartDecimator::buildRaw(size_t count) {
+    m_points.reserve(count + 1);
+    size_t runStart = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (i > 0 && m_scratchBreak[i]) {
+            endRun(runStart);
+            runStart = m_points.size();
+        }
+        m_points.push_back({ (int32_t)m_scratchX[i], (int32_t)m_scratchY[i] });
+    }
+    endRun(runStart);
+}
+
+// ============================================================================
+// CHART_DECIMATE_MINMAX — first/min/max/last per pixel column
+// ============================================================================
+void ChartDecimator::emit(int32_t x, double y) {
+    ChartPoint p = { x, (int32_t)y };
+    if (m_points.size() > m_runStart) {
+        const ChartPoint& prev = m_points.back();
+        if (prev.x == p.x && prev.y == p.y) return;
+    }
+    m_points.push_back(p);
+}
+
+void ChartDecimator::columnFlush(Column& c) {
+    if (!c.open) return;
+    emit(c.col, c.first);
+    if (c.loIdx < c.hiIdx) { emit(c.col, c.lo); emit(c.col, c.hi); }
+    else                   { emit(c.col, c.hi); emit(c.col, c.lo); }
+    emit(c.col, c.last);
+    c.open = false;
+}
+
+void ChartDecimator::columnAdd(Column& c, int32_t col, double y, size_t order) {
+    if (!c.open || col != c.col) {
+        columnFlush(c);
+        c.open  = true;
+        c.col   = col;
+        c.first = c.last = c.lo = c.hi = y;
+        c.loIdx = c.hiIdx = order;
+        return;
+    }
+    c.last = y;
+    if (y < c.lo) { c.lo = y; c.loIdx = order; }
+    if (y > c.hi) { c.hi = y; c.hiIdx = order; }
+}
+
+void ChartDecimator::buildMinMax(size_t count) {
+    Column column;
+    m_runStart = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        if (i > 0 && m_scratchBreak[i]) {
+            columnFlush(column);
+            endRun(m_runStart);
+            m_runStart = m_points.size();
+        }
+        columnAdd(column, (int32_t)m_scratchX[i], m_scratchY[i], i);
+    }
+    columnFlush(column);
+    endRun(m_runStart);
+}
+
+// ============================================================================
+// History buckets — envelope of pre-aggregated first/min/max/last
+// ============================================================================
+void ChartDecimator::buildBuckets(const ChartHistory& history, int level, size_t first, size_t count, const ChartViewport& vp) {
+    m_points.clear();
+    m_runs.clear();
+    if (count == 0 || vp.width <= 0 || vp.windowNs <= 0) return;
+
+    double range  = vp.maxY - vp.minY;
+    double xScale = vp.width / (double)vp.windowNs;
+    double yScale = range != 0.0 ? vp.height / range : 0.0;
+    double xRight = vp.left + vp.width;
+    double yMax   = vp.height;
+
+    auto mapY = [&](double v) {
+        double y = (v - vp.minY) * yScale;
+        y = y > 0.0 ? (y < yMax ? y : yMax) : 0.0;
+        return vp.bottom - y;
+    };
+    auto mapX = [&](int64_t t) {
+        return (int32_t)(xRight - (double)(vp.refTimeNs - t) * xScale);
+    };
+
+    Column column;
+    m_runStart = 0;
+    size_t order = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        const ChartBucket& b = history.at(level, first + i);
+        if (i > 0 && b.segmentStart) {
+            columnFlush(column);
+            endRun(m_runStart);
+            m_runStart = m_points.size();
+        }
+
+        int32_t c0 = mapX(b.tStart);
+        int32_t c1 = mapX(b.tEnd);
+        int32_t cm = c0 + (c1 - c0) / 2;
+        double  yFirst = mapY(b.first);
+        double  yMin   = mapY(b.min);
+        double  yMax2  = mapY(b.max);
+
+        // Order of min/max inside a bucket is unknown — take the one nearer to `first` first
+        columnAdd(column, c0, yFirst, order++);
+        if (std::fabs(b.first - b.min) <= std::fabs(b.first - b.max)) {
+            columnAdd(column, cm, yMin, order++);
+            columnAdd(column, cm, yMax2, order++);
+        } else {
+            columnAdd(column, cm, yMax2, order++);
+            columnAdd(column, cm, yMin, order++);
+        }
+        columnAdd(column, c1, mapY(b.last), order++);
+    }
+    columnFlush(column);
+    endRun(m_runStart);
+}
+
+// ============================================================================
+// CHART_DECIMATE_LTTB — Largest-Triangle-Three-Buckets per run
+// ============================================================================
+void ChartDecimator::buildLttb(size_t count, int width) {
+    size_t runBegin = 0;
+    for (size_t i = 1; i <= count; i++) {
+        if (i == count || m_scratchBreak[i]) {
+            size_t n = i - runBegin;
+            // Share the plot width between runs proportionally to their length
+            size_t target = (size_t)width * n / count + 2;
+            size_t runStart = m_points.size();
+            lttbRun(runBegin, n, target);
+            endRun(runStart);
+            runBegin = i;
+        }
+    }
+}
+
+void ChartDecimator::lttbRun(size_t start, size_t n, size_t target) {
+    const double* xs = &m_scratchX[start];
+    const double* ys = &m_scratchY[start];
+
+    if (n <= target || target < 3) {
+        for (size_t i = 0; i < n; i++) {
+            m_points.push_back({ (int32_t)xs[i], (int32_t)ys[i] });
+        }
+        return;
+    }
+
+    double every = (double)(n - 2) / (double)(target - 2);
+    size_t a = 0;
+    m_points.push_back({ (int32_t)xs[0], (int32_t)ys[0] });
+
+    for (size_t b = 0; b < target - 2; b++) {
+        // Average of the next bucket
+        size_t avgStart = (size_t)std::floor((b + 1) * every) + 1;
+        size_t avgEnd   = (size_t)std::floor((b + 2) * every) + 1;
+        if (avgEnd > n) avgEnd = n;
+        double avgX = 0.0, avgY = 0.0;
+        for (size_t j = avgStart; j < avgEnd; j++) {
+            avgX += xs[j];
+            avgY += ys[j];
+        }
+        size_t avgLen = avgEnd - avgStart;
+        if (avgLen > 0) {
+            avgX /= avgLen;
+            avgY /= avgLen;
+        } else {
+            avgX = xs[n - 1];
+            avgY = ys[n - 1];
+        }
+
+        // Point of the current bucket forming the largest triangle with a and avg
+        size_t rangeStart = (size_t)std::floor(b * every) + 1;
+        size_t rangeEnd   = (size_t)std::floor((b + 1) * every) + 1;
+        double ax = xs[a], ay = ys[a];
+        double maxArea = -1.0;
+        size_t next = rangeStart;
+        for (size_t j = rangeStart; j < rangeEnd; j++) {
+            double area = std::fabs((ax - avgX) * (ys[j] - ay) - (ax - xs[j]) * (avgY - ay));
+            if (area > maxArea) {
+                maxArea = area;
+                next = j;
+            }
+        }
+
+        m_points.push_back({ (int32_t)xs[next], (int32_t)ys[next] });
+        a = next;
+    }
+
+    m_points.push_back({ (int32_t)xs[n - 1], (int32_t)ys[n - 1] });
+}
@@ -0,0 +1,89 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 JAQUBA (https://github.com/JAQUBA)
+// Part of JQB_WindowsLib — https://github.com/JAQUBA/JQB_WindowsLib
+
+/**
+ * ChartDecimator.h — reduces visible Chart samples to drawable polylines
+ *
+ * CHART_DECIMATE_MINMAX keeps first/min/max/last per pixel column, which is
+ * pixel-identical to drawing every sample but bounded by 4 × plot width.
+ * CHART_DECIMATE_LTTB (Largest-Triangle-Three-Buckets) keeps ~one point per
+ * column and suits sparse, slowly changing data.
+ *
+ * Output is a flat point array plus run lengths — ready for PolyPolyline().
+ */
+
+#ifndef CHART_DECIMATOR_H
+#define CHART_DECIMATOR_H
+
+#include "ChartBuffer.h"
+#include "ChartHistory.h"
+#include "ChartCanvas.h"
+#include <cstdint>
+#include <vector>
+
+enum ChartDecimation {
+    CHART_DECIMATE_NONE = 0,    // every sample becomes a vertex
+    CHART_DECIMATE_MINMAX,      // per-pixel first/min/max/last envelope (default)
+    CHART_DECIMATE_LTTB         // Largest-Triangle-Three-Buckets, ~1 vertex per column
+};
+
+// Mapping of (time, value) onto the plot area in pixels
+struct ChartViewport {
+    int64_t refTimeNs;      // time at the right edge
+    int64_t windowNs;       // time span of the plot width
+    int     left;           // x of the left edge
+    int     width;          // plot width in pixels
+    int     bottom;         // y of the value minY
+    int     height;         // plot height in pixels
+    double  minY;
+    double  maxY;
+};
+
+class ChartDecimator {
+public:
+    void setMode(ChartDecimation mode) { m_mode = mode; }
+    ChartDecimation getMode() const    { return m_mode; }
+
+    // Build polylines from logical range [first, first + count) of the buffer.
+    // Runs are split at segment markers.
+    void build(const ChartBuffer& buffer, size_t first, size_t count, const ChartViewport& vp);
+
+    // Build polylines from history buckets [first, first + count) of a level.
+    // Each bucket contributes its first/min/max/last to the per-column envelope.
+    void buildBuckets(const ChartHistory& history, int level, size_t first, size_t count, const ChartViewport& vp);
+
+    const std::vector<ChartPoint>& points() const { return m_points; }
+    const std::vector<uint32_t>&   runs()   const { return m_runs; }
+
+private:
+    ChartDecimation m_mode = CHART_DECIMATE_MINMAX;
+
+    // Reused between frames — no per-frame allocation once warmed up
+    std::vector<ChartPoint> m_points;
+    std::vector<uint32_t>   m_runs;
+    std::vector<double>     m_scratchX;
+    std::vector<double>     m_scratchY;
+    std::vector<uint8_t>    m_scratchBreak;
+
+    void mapSamples(const ChartBuffer& buffer, size_t first, size_t count, const ChartViewport& vp);
+    void buildRaw(size_t count);
+    void buildMinMax(size_t count);
+    void buildLttb(size_t count, int width);
+    void lttbRun(size_t start, size_t n, size_t target);
+    void endRun(size_t runStart);
+
+    // Per-column first/min/max/last accumulator (shared by samples and buckets)
+    struct Column {
+        bool    open = false;
+        int32_t col = 0;
+        double  first = 0, last = 0, lo = 0, hi = 0;
+        size_t  loIdx = 0, hiIdx = 0;
+    };
+    size_t m_runStart = 0;
+    void columnAdd(Column& c, int32_t col, double y, size_t order);
+    void columnFlush(Column& c);
+    void emit(int32_t x, double y);
+};
+
+#endif // CHART_DECIMATOR_H
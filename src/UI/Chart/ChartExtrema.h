@@ -0,0 +1,91 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 JAQUBA (https://github.com/JAQUBA)
+// Part of JQB_WindowsLib — https://github.com/JAQUBA/JQB_WindowsLib
+
+/**
+ * ChartExtrema.h — sliding-window MIN / MAX in O(1) amortized per sample
+ *
+ * Two monotonic queues of (sequence number, value): the front of each queue is
+ * the current extreme of the retained window. Samples are pushed as they are
+ * appended to ChartBuffer and evicted by sequence number when the buffer drops
+ * its oldest samples.
+ *
+ * Header-only. Nie zależy od WinAPI.
+ */
+
+#ifndef CHART_EXTREMA_H
+#define CHART_EXTREMA_H
+
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+class ChartExtrema {
+public:
+    void push(uint64_t seq, double value) {
+        if (!std::isfinite(value)) return;  // NaN / ±inf nie wpływają na skalę
+        while (!m_max.empty() && m_max.back().value <= value) m_max.popBack();
+        m_max.pushBack({ seq, value });
+        while (!m_min.empty() && m_min.back().value >= value) m_min.popBack();
+        m_min.pushBack({ seq, value });
+    }
+
+    // Forget every sample with sequence number < firstSeq
+    void evictBefore(uint64_t firstSeq) {
+        while (!m_max.empty() && m_max.front().seq < firstSeq) m_max.popFront();
+        while (!m_min.empty() && m_min.front().seq < firstSeq) m_min.popFront();
+    }
+
+    void clear() {
+        m_min.clear();
+        m_max.clear();
+    }
+
+    bool   empty() const { return m_max.empty(); }
+    double min()   const { return m_min.front().value; }
+    double max()   const { return m_max.front().value; }
+
+private:
+    struct Entry {
+        uint64_t seq;
+        double   value;
+    };
+
+    // Growable ring used as a double-ended queue
+    class Queue {
+    public:
+        bool empty() const { return m_count == 0; }
+        const Entry& front() const { return m_items[m_head]; }
+        const Entry& back()  const { return m_items[(m_head + m_count - 1) & (m_items.size() - 1)]; }
+
+        void pushBack(const Entry& e) {
+            if (m_count == m_items.size()) grow();
+            m_items[(m_head + m_count) & (m_items.size() - 1)] = e;
+            m_count++;
+        }
+        void popBack()  { m_count--; }
+        void popFront() { m_head = (m_head + 1) & (m_items.size() - 1); m_count--; }
+        void clear()    { m_head = 0; m_count = 0; }
+
+    private:
+        std::vector<Entry> m_items;
+        size_t m_head  = 0;
+        size_t m_count = 0;
+
+        void grow() {
+            size_t cap = m_items.empty() ? 64 : m_items.size() * 2;
+            std::vector<Entry> items(cap);
+            for (size_t i = 0; i < m_count; i++) {
+                items[i] = m_items[(m_head + i) & (m_items.size() - 1)];
+            }
+            m_items.swap(items);
+            m_head = 0;
+        }
+    };
+
+    Queue m_min;
+    Queue m_max;
+};
+
+#endif // CHART_EXTREMA_H
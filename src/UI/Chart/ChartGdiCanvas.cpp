@@ -0,0 +1,180 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 JAQUBA (https://github.com/JAQUBA)
+// Part of JQB_WindowsLib — https://github.com/JAQUBA/JQB_WindowsLib
+
+#include "ChartGdiCanvas.h"
+
+static_assert(sizeof(ChartPoint) == sizeof(POINT), "ChartPoint must match POINT layout");
+static_assert(sizeof(uint32_t) == sizeof(DWORD), "run lengths are passed as DWORD");
+
+// Nieużywane wpisy pamięci podręcznej — kolory zmieniają się rzadko
+static const size_t MAX_CACHED_OBJECTS = 32;
+
+ChartGdiCanvas::ChartGdiCanvas()
+    : m_hdc(NULL), m_width(0), m_height(0), m_titleFont(NULL), m_labelFont(NULL)
+    , m_imageDC(NULL), m_imageBitmap(NULL), m_imageOldBitmap(NULL), m_imageBits(NULL)
+    , m_imageWidth(0), m_imageHeight(0)
+{
+}
+
+ChartGdiCanvas::~ChartGdiCanvas() {
+    release();
+}
+
+void ChartGdiCanvas::attach(HDC hdc, int width, int height) {
+    m_hdc = hdc;
+    m_width = width;
+    m_height = height;
+}
+
+void ChartGdiCanvas::release() {
+    for (PenEntry& p : m_pens) DeleteObject(p.pen);
+    for (BrushEntry& b : m_brushes) DeleteObject(b.brush);
+    m_pens.clear();
+    m_brushes.clear();
+    if (m_titleFont) { DeleteObject(m_titleFont); m_titleFont = NULL; }
+    if (m_labelFont) { DeleteObject(m_labelFont); m_labelFont = NULL; }
+    if (m_imageDC) {
+        SelectObject(m_imageDC, m_imageOldBitmap);
+        DeleteObject(m_imageBitmap);
+        DeleteDC(m_imageDC);
+        m_imageDC = NULL;
+        m_imageBitmap = NULL;
+        m_imageBits = NULL;
+        m_imageWidth = 0;
+        m_imageHeight = 0;
+    }
+}
+
+HPEN ChartGdiCanvas::pen(ChartColor color, int width, bool dotted) {
+    for (const PenEntry& p : m_pens) {
+        if (p.color == color && p.width == width && p.dotted == dotted) return p.pen;
+    }
+    if (m_pens.size() >= MAX_CACHED_OBJECTS) {
+        // Pióra nie są już wybrane w żadnym DC (każdy prymityw przywraca stare)
+        for (PenEntry& p : m_pens) DeleteObject(p.pen);
+        m_pens.clear();
+    }
+    PenEntry e = { CreatePen(dotted ? PS_DOT : PS_SOLID, width, (COLORREF)color), color, width, dotted };
+    m_pens.push_back(e);
+    return e.pen;
+}
+
+HBRUSH ChartGdiCanvas::brush(ChartColor color) {
+    for (const BrushEntry& b : m_brushes) {
+        if (b.color == color) return b.brush;
+    }
+    if (m_brushes.size() >= MAX_CACHED_OBJECTS) {
+        for (BrushEntry& b : m_brushes) DeleteObject(b.brush);
+        m_brushes.clear();
+    }
+    BrushEntry e = { CreateSolidBrush((COLORREF)color), color };
+    m_brushes.push_back(e);
+    return e.brush;
+}
+
+void ChartGdiCanvas::fillRect(const ChartRect& rect, ChartColor color) {
+    RECT r = { rect.left, rect.top, rect.right, rect.bottom };
+    FillRect(m_hdc, &r, brush(color));
+}
+
+void ChartGdiCanvas::line(int x0, int y0, int x1, int y1, ChartColor color, int width, bool dotted) {
+    HPEN oldPen = (HPEN)SelectObject(m_hdc, pen(color, width, dotted));
+    MoveToEx(m_hdc, x0, y0, NULL);
+    LineTo(m_hdc, x1, y1);
+    SelectObject(m_hdc, oldPen);
+}
+
+void ChartGdiCanvas::polyPolyline(const ChartPoint* points, const uint32_t* runs, size_t runCount,
+                                  ChartColor color, int width) {
+    HPEN oldPen = (HPEN)SelectObject(m_hdc, pen(color, width, false));
+    PolyPolyline(m_hdc, reinterpret_cast<const POINT*>(points),
+                 reinterpret_cast<const DWORD*>(runs), (DWORD)runCount);
+    SelectObject(m_hdc, oldPen);
+}
+
+void ChartGdiCanvas::dots(const ChartPoint* points, size_t count, int radius, ChartColor color) {
+    // Jeden pędzel i pióro dla wszystkich kropek
+    HPEN oldPen = (HPEN)SelectObject(m_hdc, pen(color, 1, false));
+    HBRUSH oldBrush = (HBRUSH)SelectObject(m_hdc, brush(color));
+    for (size_t i = 0; i < count; i++) {
+        const ChartPoint& p = points[i];
+        Ellipse(m_hdc, p.x - radius, p.y - radius, p.x + radius, p.y + radius);
+    }
+    SelectObject(m_hdc, oldBrush);
+    SelectObject(m_hdc, oldPen);
+}
+
+void ChartGdiCanvas::scroll(const ChartRect& rect, int dx, ChartColor fill) {
+    if (dx == 0) return;
+    RECT r = { rect.left, rect.top, rect.right, rect.bottom };
+    ScrollDC(m_hdc, dx, 0, &r, &r, NULL, NULL);
+    ChartRect exposed = rect;
+    if (dx < 0) exposed.left = rect.right + dx > rect.left ? rect.right + dx : rect.left;
+    else        exposed.right = rect.left + dx < rect.right ? rect.left + dx : rect.right;
+    fillRect(exposed, fill);
+}
+
+void ChartGdiCanvas::image(const ChartRect& box, const ChartColor* pixels) {
+    int w = box.right - box.left;
+    int h = box.bottom - box.top;
+    if (w <= 0 || h <= 0) return;
+
+    if (!m_imageDC || w != m_imageWidth || h != m_imageHeight) {
+        if (m_imageDC) {
+            SelectObject(m_imageDC, m_imageOldBitmap);
+            DeleteObject(m_imageBitmap);
+            DeleteDC(m_imageDC);
+        }
+        BITMAPINFO bmi;
+        ZeroMemory(&bmi, sizeof(bmi));
+        bmi.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+        bmi.bmiHeader.biWidth = w;
+        bmi.bmiHeader.biHeight = -h;        // top-down
+        bmi.bmiHeader.biPlanes = 1;
+        bmi.bmiHeader.biBitCount = 32;
+        bmi.bmiHeader.biCompression = BI_RGB;
+        void* bits = NULL;
+        m_imageDC = CreateCompatibleDC(m_hdc);
+        m_imageBitmap = CreateDIBSection(m_hdc, &bmi, DIB_RGB_COLORS, &bits, NULL, 0);
+        m_imageOldBitmap = (HBITMAP)SelectObject(m_imageDC, m_imageBitmap);
+        m_imageBits = (uint32_t*)bits;
+        m_imageWidth = w;
+        m_imageHeight = h;
+    }
+    if (!m_imageBits) return;
+
+    // Tło spod obrazu → podmiana nieprzezroczystych pikseli (COLORREF → BGRX) → z powrotem
+    BitBlt(m_imageDC, 0, 0, w, h, m_hdc, box.left, box.top, SRCCOPY);
+    GdiFlush();
+    size_t count = (size_t)w * h;
+    for (size_t i = 0; i < count; i++) {
+        ChartColor c = pixels[i];
+        if (c == CHART_COLOR_NONE) continue;
+        m_imageBits[i] = ((c & 0xFF) << 16) | (c & 0xFF00) | ((c >> 16) & 0xFF);
+    }
+    BitBlt(m_hdc, box.left, box.top, w, h, m_imageDC, 0, 0, SRCCOPY);
+}
+
+void ChartGdiCanvas::text(const ChartRect& box, const std::wstring& str, ChartColor color,
+                          ChartFont font, int flags) {
+    HFONT& cached = font == CHART_FONT_TITLE ? m_titleFont : m_labelFont;
+    if (!cached) {
+        cached = CreateFontW(font == CHART_FONT_TITLE ? 16 : 12, 0, 0, 0, FW_NORMAL, FALSE, FALSE, FALSE,
+                             DEFAULT_CHARSET, OUT_OUTLINE_PRECIS, CLIP_DEFAULT_PRECIS,
+                             CLEARTYPE_QUALITY, DEFAULT_PITCH, L"Arial");
+    }
+
+    UINT format = DT_SINGLELINE;
+    if (flags & CHART_TEXT_RIGHT)        format |= DT_RIGHT;
+    else if (flags & CHART_TEXT_CENTER)  format |= DT_CENTER;
+    else                                 format |= DT_LEFT;
+    format |= (flags & CHART_TEXT_VCENTER) ? DT_VCENTER : DT_TOP;
+
+    HFONT oldFont = (HFONT)SelectObject(m_hdc, cached);
+    SetTextColor(m_hdc, (COLORREF)color);
+    SetBkMode(m_hdc, TRANSPARENT);
+    RECT r = { box.left, box.top, box.right, box.bottom };
+    DrawTextW(m_hdc, str.c_str(), -1, &r, format);
+    SelectObject(m_hdc, oldFont);
+}
@@ -0,0 +1,76 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 JAQUBA (https://github.com/JAQUBA)
+// Part of JQB_WindowsLib — https://github.com/JAQUBA/JQB_WindowsLib
+
+/**
+ * ChartGdiCanvas.h — WinAPI GDI backend for ChartPlot
+ *
+ * Draws into any HDC (Chart uses its back buffer and static-layer DCs).
+ * Pens, brushes and fonts are cached across frames and rebuilt only when a
+ * new colour / width is requested. image() composites through a cached DIB
+ * section (copy target → replace opaque pixels → copy back).
+ */
+
+#ifndef CHART_GDI_CANVAS_H
+#define CHART_GDI_CANVAS_H
+
+#include <windows.h>
+#include "ChartCanvas.h"
+#include <vector>
+
+class ChartGdiCanvas : public ChartCanvas {
+public:
+    ChartGdiCanvas();
+    ~ChartGdiCanvas() override;
+
+    // Target for the following primitives
+    void attach(HDC hdc, int width, int height);
+    // Delete cached GDI objects
+    void release();
+
+    int width() const override  { return m_width; }
+    int height() const override { return m_height; }
+
+    void fillRect(const ChartRect& rect, ChartColor color) override;
+    void line(int x0, int y0, int x1, int y1, ChartColor color, int width, bool dotted) override;
+    void polyPolyline(const ChartPoint* points, const uint32_t* runs, size_t runCount,
+                      ChartColor color, int width) override;
+    void dots(const ChartPoint* points, size_t count, int radius, ChartColor color) override;
+    void scroll(const ChartRect& rect, int dx, ChartColor fill) override;
+    void image(const ChartRect& box, const ChartColor* pixels) override;
+    void text(const ChartRect& box, const std::wstring& str, ChartColor color,
+              ChartFont font, int flags) override;
+
+private:
+    struct PenEntry {
+        HPEN pen;
+        ChartColor color;
+        int width;
+        bool dotted;
+    };
+    struct BrushEntry {
+        HBRUSH brush;
+        ChartColor color;
+    };
+
+    HDC m_hdc;
+    int m_width;
+    int m_height;
+    std::vector<PenEntry> m_pens;
+    std::vector<BrushEntry> m_brushes;
+    HFONT m_titleFont;
+    HFONT m_labelFont;
+
+    // 32-bit DIB section do składania obrazów (image) — realokowana przy zmianie rozmiaru
+    HDC m_imageDC;
+    HBITMAP m_imageBitmap;
+    HBITMAP m_imageOldBitmap;
+    uint32_t* m_imageBits;
+    int m_imageWidth;
+    int m_imageHeight;
+
+    HPEN pen(ChartColor color, int width, bool dotted);
+    HBRUSH brush(ChartColor color);
+};
+
+#endif // CHART_GDI_CANVAS_H
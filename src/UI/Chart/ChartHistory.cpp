@@ -0,0 +1,143 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 JAQUBA (https://github.com/JAQUBA)
+// Part of JQB_WindowsLib — https://github.com/JAQUBA/JQB_WindowsLib
+
+#include "ChartHistory.h"
+#include <climits>
+
+ChartHistory::ChartHistory()
+    : m_bucketsPerLevel(0)
+{
+}
+
+void ChartHistory::configure(size_t bucketsPerLevel, bool preallocate) {
+    m_bucketsPerLevel = bucketsPerLevel;
+    for (Level& lv : m_levels) {
+        lv.ring.clear();
+        lv.ring.shrink_to_fit();
+        if (preallocate) lv.ring.resize(bucketsPerLevel);
+        lv.head = 0;
+        lv.count = 0;
+        lv.hasOpen = false;
+        lv.truncated = false;
+    }
+}
+
+void ChartHistory::clear() {
+    for (Level& lv : m_levels) {
+        lv.head = 0;
+        lv.count = 0;
+        lv.hasOpen = false;
+        lv.truncated = false;
+    }
+}
+
+void ChartHistory::push(uint64_t seq, int64_t timeNs, double value, bool segmentStart) {
+    if (!enabled()) return;
+
+    ChartBucket unit;
+    unit.tStart = timeNs;
+    unit.tEnd = timeNs;
+    unit.seq = seq;
+    unit.first = value;
+    unit.last = value;
+    unit.min = value;
+    unit.max = value;
+    unit.sum = value;
+    unit.sumSq = value * value;
+    unit.count = 1;
+    unit.segmentStart = segmentStart ? 1 : 0;
+
+    // Every level's open bucket already includes the newest sample, so the
+    // partial tail of a coarse level is never behind the raw data.
+    uint64_t span = 1;
+    for (int i = 0; i < MAX_LEVELS; i++) {
+        span *= FANOUT;
+        accumulate(m_levels[i], unit);
+        // Bucket closes when the next sequence number is aligned to its span
+        if ((seq + 1) % span == 0) {
+            commit(m_levels[i]);
+        }
+    }
+}
+
+void ChartHistory::accumulate(Level& lv, const ChartBucket& src) {
+    if (!lv.hasOpen) {
+        lv.open = src;
+        lv.hasOpen = true;
+        return;
+    }
+    ChartBucket& b = lv.open;
+    b.tEnd = src.tEnd;
+    b.last = src.last;
+    if (src.min < b.min) b.min = src.min;
+    if (src.max > b.max) b.max = src.max;
+    b.sum += src.sum;
+    b.sumSq += src.sumSq;
+    b.count += src.count;
+    b.segmentStart |= src.segmentStart;
+}
+
+void ChartHistory::commit(Level& lv) {
+    if (lv.count == lv.ring.size()) {
+        if (lv.ring.size() < m_bucketsPerLevel) {
+            // Grow (linearize) up to the configured maximum
+            size_t newSize = lv.ring.empty() ? 256 : lv.ring.size() * 2;
+            if (newSize > m_bucketsPerLevel) newSize = m_bucketsPerLevel;
+            std::vector<ChartBucket> ring(newSize);
+            for (size_t i = 0; i < lv.count; i++) ring[i] = closedAt(lv, i);
+            lv.ring.swap(ring);
+            lv.head = 0;
+        } else {
+            // Full — discard the oldest bucket, coarser levels still hold it
+            lv.head = (lv.head + 1) % lv.ring.size();
+            lv.count--;
+            lv.truncated = true;
+        }
+    }
+
+    lv.ring[(lv.head + lv.count) % lv.ring.size()] = lv.open;
+    lv.count++;
+    lv.hasOpen = false;
+}
+
+void ChartHistory::dropOlderThan(int64_t cutoffNs) {
+    for (Level& lv : m_levels) {
+        while (lv.count > 0 && closedAt(lv, 0).tEnd < cutoffNs) {
+            lv.head = (lv.head + 1) % lv.ring.size();
+            lv.count--;
+        }
+    }
+}
+
+size_t ChartHistory::size(int level) const {
+    const Level& lv = m_levels[level - 1];
+    return lv.count + (lv.hasOpen ? 1 : 0);
+}
+
+const ChartBucket& ChartHistory::at(int level, size_t i) const {
+    const Level& lv = m_levels[level - 1];
+    if (i < lv.count) return closedAt(lv, i);
+    return lv.open;
+}
+
+int64_t ChartHistory::oldestTime(int level) const {
+    if (empty(level)) return INT64_MAX;
+    return at(level, 0).tStart;
+}
+
+size_t ChartHistory::lowerBound(int level, int64_t timeNs) const {
+    size_t lo = 0, hi = size(level);
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (at(level, mid).tEnd < timeNs) lo = mid + 1;
+        else                              hi = mid;
+    }
+    return lo;
+}
+
+size_t ChartHistory::memoryBytes() const {
+    size_t total = 0;
+    for (const Level& lv : m_levels) total += lv.ring.capacity() * sizeof(ChartBucket);
+    return total;
+}
@@ -0,0 +1,91 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 JAQUBA (https://github.com/JAQUBA)
+// Part of JQB_WindowsLib — https://github.com/JAQUBA/JQB_WindowsLib
+
+/**
+ * ChartHistory.h — multi-resolution (mipmap) history of a Chart series
+ *
+ * Level 1 bucket = 16 raw samples, level 2 = 256, level L = 16^L samples.
+ * Buckets are aligned on sample sequence numbers and keep first/last/min/max,
+ * sum, sum of squares and count, so a bucket envelope draws exactly like its
+ * raw samples at that zoom level (and cursor statistics need no raw data). Each level is a ring with a fixed maximum number of
+ * buckets: coarser levels reach further back in time, total memory stays
+ * bounded no matter how long the time window is.
+ *
+ * Nie zależy od WinAPI.
+ */
+
+#ifndef CHART_HISTORY_H
+#define CHART_HISTORY_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+struct ChartBucket {
+    int64_t  tStart;        // timestamp of the first sample [ns]
+    int64_t  tEnd;          // timestamp of the last sample [ns]
+    uint64_t seq;           // sequence number of the first sample
+    double   first;
+    double   last;
+    double   min;
+    double   max;
+    double   sum;
+    double   sumSq;
+    uint32_t count;         // raw samples aggregated
+    uint32_t segmentStart;  // 1 = a segment marker falls inside this bucket
+};
+
+class ChartHistory {
+public:
+    static const int FANOUT     = 16;
+    static const int MAX_LEVELS = 6;
+
+    ChartHistory();
+
+    // bucketsPerLevel = 0 disables the history. preallocate = all rings
+    // allocated now at full size (memory budget mode, no growth later).
+    void configure(size_t bucketsPerLevel, bool preallocate = false);
+    bool enabled() const { return m_bucketsPerLevel > 0; }
+
+    void push(uint64_t seq, int64_t timeNs, double value, bool segmentStart);
+    void dropOlderThan(int64_t cutoffNs);
+    void clear();
+
+    // Level 1..MAX_LEVELS. Index 0 = oldest; the last index is the
+    // still-open (partial) bucket when it holds samples.
+    size_t size(int level) const;
+    const ChartBucket& at(int level, size_t i) const;
+    bool empty(int level) const { return size(level) == 0; }
+
+    // Oldest timestamp retained at a level (INT64_MAX when empty)
+    int64_t oldestTime(int level) const;
+    // True once the level had to discard buckets (it no longer reaches the first sample)
+    bool truncated(int level) const { return m_levels[level - 1].truncated; }
+
+    // First index whose bucket ends at or after timeNs
+    size_t lowerBound(int level, int64_t timeNs) const;
+
+    size_t memoryBytes() const;
+
+private:
+    struct Level {
+        std::vector<ChartBucket> ring;
+        size_t head = 0;
+        size_t count = 0;
+        ChartBucket open;
+        bool hasOpen = false;
+        bool truncated = false;
+    };
+
+    Level  m_levels[MAX_LEVELS];
+    size_t m_bucketsPerLevel;
+
+    void accumulate(Level& lv, const ChartBucket& src);
+    void commit(Level& lv);
+    const ChartBucket& closedAt(const Level& lv, size_t i) const {
+        return lv.ring[(lv.head + i) % lv.ring.size()];
+    }
+};
+
+#endif // CHART_HISTORY_H
@@ -0,0 +1,100 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 JAQUBA (https://github.com/JAQUBA)
+// Part of JQB_WindowsLib — https://github.com/JAQUBA/JQB_WindowsLib
+
+#include "ChartIngestQueue.h"
+
+ChartIngestQueue::ChartIngestQueue(size_t capacity)
+    : m_tail(0)
+    , m_head(0)
+    , m_dropped(0)
+{
+    size_t cap = 64;
+    while (cap < capacity) cap <<= 1;
+    m_slots = std::vector<Slot>(cap);
+    m_mask = cap - 1;
+    for (size_t i = 0; i < cap; i++) {
+        m_slots[i].seq.store(0, std::memory_order_relaxed);
+    }
+}
+
+bool ChartIngestQueue::reserve(size_t n, uint64_t& pos) {
+    pos = m_tail.load(std::memory_order_relaxed);
+    do {
+        uint64_t head = m_head.load(std::memory_order_acquire);
+        if (pos + n - head > m_slots.size()) {
+            return false;
+        }
+    } while (!m_tail.compare_exchange_weak(pos, pos + n,
+                                           std::memory_order_acq_rel,
+                                           std::memory_order_relaxed));
+    return true;
+}
+
+bool ChartIngestQueue::pushPoint(int series, double value, int64_t timeNs) {
+    uint64_t pos;
+    if (!reserve(1, pos)) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    Slot& slot = m_slots[pos & m_mask];
+    slot.rec.value  = value;
+    slot.rec.timeNs = timeNs;
+    slot.rec.count  = 1;
+    slot.rec.series = (uint16_t)series;
+    slot.rec.kind   = RECORD_POINT;
+    slot.seq.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+bool ChartIngestQueue::pushBatch(int series, const double* values, int count, double durationMs, int64_t timeNs,
+                                 RecordKind kind) {
+    if (count <= 0) return true;
+
+    uint64_t pos;
+    if ((size_t)count + 1 > m_slots.size() || !reserve((size_t)count + 1, pos)) {
+        m_dropped.fetch_add((uint64_t)count, std::memory_order_relaxed);
+        return false;
+    }
+
+    // Samples are committed first, the header last — once the consumer sees
+    // the header, the whole batch is visible.
+    for (int i = 0; i < count; i++) {
+        uint64_t p = pos + 1 + (uint64_t)i;
+        Slot& slot = m_slots[p & m_mask];
+        slot.rec.value  = values[i];
+        slot.rec.timeNs = 0;
+        slot.rec.count  = 0;
+        slot.rec.series = (uint16_t)series;
+        slot.rec.kind   = RECORD_SAMPLE;
+        slot.seq.store(p + 1, std::memory_order_release);
+    }
+
+    Slot& header = m_slots[pos & m_mask];
+    header.rec.value  = durationMs;
+    header.rec.timeNs = timeNs;
+    header.rec.count  = (uint32_t)count;
+    header.rec.series = (uint16_t)series;
+    header.rec.kind   = kind;
+    header.seq.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+const ChartIngestQueue::Record* ChartIngestQueue::peek() const {
+    uint64_t head = m_head.load(std::memory_order_relaxed);
+    const Slot& slot = m_slots[head & m_mask];
+    if (slot.seq.load(std::memory_order_acquire) != head + 1) {
+        return nullptr;
+    }
+    return &slot.rec;
+}
+
+const ChartIngestQueue::Record& ChartIngestQueue::sampleAt(size_t offset) const {
+    uint64_t head = m_head.load(std::memory_order_relaxed);
+    return m_slots[(head + offset) & m_mask].rec;
+}
+
+void ChartIngestQueue::release(size_t records) {
+    m_head.store(m_head.load(std::memory_order_relaxed) + records, std::memory_order_release);
+}
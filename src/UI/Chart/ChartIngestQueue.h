@@ -0,0 +1,74 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 JAQUBA (https://github.com/JAQUBA)
+// Part of JQB_WindowsLib — https://github.com/JAQUBA/JQB_WindowsLib
+
+/**
+ * ChartIngestQueue.h — lock-free multi-producer / single-consumer sample queue
+ *
+ * Any thread (audio, Serial callback, Modbus poller) can push points or whole
+ * batches without taking a lock; a batch reserves a contiguous block of slots
+ * with one CAS. When the queue is full the push is dropped and counted —
+ * producers never wait. The Chart (UI thread) drains the queue on a timer.
+ *
+ * Nie korzysta z std::thread ani std::mutex — bezpieczne dla MinGW.org.
+ */
+
+#ifndef CHART_INGEST_QUEUE_H
+#define CHART_INGEST_QUEUE_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+class ChartIngestQueue {
+public:
+    enum RecordKind : uint16_t {
+        RECORD_POINT = 0,   // single sample: value, timeNs
+        RECORD_BATCH,       // batch header: count samples follow, value = duration [ms], timeNs = push time
+        RECORD_SAMPLE,      // batch sample: value
+        RECORD_SPECTRUM     // spectrum header: count magnitudes follow (RECORD_SAMPLE), value = bin width [Hz]
+    };
+
+    struct Record {
+        double   value;
+        int64_t  timeNs;
+        uint32_t count;
+        uint16_t series;
+        uint16_t kind;
+    };
+
+    explicit ChartIngestQueue(size_t capacity = 65536);
+
+    // Producer side — callable from any thread, never blocks
+    bool pushPoint(int series, double value, int64_t timeNs);
+    bool pushBatch(int series, const double* values, int count, double durationMs, int64_t timeNs,
+                   RecordKind kind = RECORD_BATCH);
+
+    // Consumer side — single thread only.
+    // Returns the next committed record or nullptr. For RECORD_BATCH / RECORD_SPECTRUM the
+    // following `count` samples are already committed and can be read with
+    // sampleAt(1..count) before calling release(count + 1).
+    const Record* peek() const;
+    const Record& sampleAt(size_t offset) const;
+    void release(size_t records);
+
+    size_t   capacity()     const { return m_slots.size(); }
+    uint64_t droppedCount() const { return m_dropped.load(std::memory_order_relaxed); }
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> seq;      // position + 1 once committed
+        Record rec;
+    };
+
+    std::vector<Slot> m_slots;
+    size_t m_mask;
+    std::atomic<uint64_t> m_tail;       // next position to reserve (producers)
+    std::atomic<uint64_t> m_head;       // next position to read (consumer)
+    std::atomic<uint64_t> m_dropped;    // samples rejected because the queue was full
+
+    bool reserve(size_t n, uint64_t& pos);
+};
+
+#endif // CHART_INGEST_QUEUE_H
@@ -0,0 +1,259 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 JAQUBA (https://github.com/JAQUBA)
+// Part of JQB_WindowsLib — https://github.com/JAQUBA/JQB_WindowsLib
+
+#include "ChartPersistence.h"
+#include <algorithm>
+#include <cmath>
+
+// Trafienia poniżej progu po zaniku są zerowane (piksel znów przezroczysty)
+static const float HIT_FLOOR = 1e-3f;
+
+ChartPersistence::ChartPersistence()
+    : m_width(0), m_height(0), m_sweepNs(0)
+    , m_minY(0.0), m_maxY(0.0), m_rangeValid(false), m_autoRange(true)
+    , m_decaySec(1.0), m_decayNs(0), m_hasDecayTime(false)
+    , m_triggered(false), m_autoFreeRun(true)
+    , m_sweeping(false), m_sweepStart(0), m_sweepEnd(0), m_hasSweep(false)
+    , m_hasPrev(false), m_prevX(0.0), m_prevY(0.0)
+    , m_lutPalette(CHART_PALETTE_MONO), m_lutColor(CHART_COLOR_NONE)
+{
+}
+
+void ChartPersistence::configure(int width, int height, int64_t sweepNs) {
+    if (width == m_width && height == m_height && sweepNs == m_sweepNs) return;
+    m_width = width > 0 ? width : 0;
+    m_height = height > 0 ? height : 0;
+    m_sweepNs = sweepNs;
+    m_hits.assign((size_t)m_width * m_height, 0.0f);
+    clear();
+}
+
+void ChartPersistence::setRange(double minY, double maxY) {
+    if (!m_autoRange && m_rangeValid && minY == m_minY && maxY == m_maxY) return;
+    if (!std::isfinite(maxY - minY) || !(maxY > minY)) return;
+    m_autoRange = false;
+    m_minY = minY;
+    m_maxY = maxY;
+    m_rangeValid = true;
+    clear();
+}
+
+void ChartPersistence::setAutoRange() {
+    if (m_autoRange) return;
+    m_autoRange = true;
+    m_rangeValid = false;
+    clear();
+}
+
+void ChartPersistence::setTriggered(bool triggered, bool autoFreeRun) {
+    if (triggered == m_triggered && autoFreeRun == m_autoFreeRun) return;
+    m_triggered = triggered;
+    m_autoFreeRun = autoFreeRun;
+    m_sweeping = false;
+}
+
+void ChartPersistence::clear() {
+    std::fill(m_hits.begin(), m_hits.end(), 0.0f);
+    m_sweeping = false;
+    m_hasSweep = false;
+    m_hasPrev = false;
+    m_hasDecayTime = false;
+}
+
+// ============================================================================
+// Ingest — jeden wektor na próbkę, bez przechowywania próbek
+// ============================================================================
+void ChartPersistence::fitRange(double value) {
+    if (m_rangeValid && value >= m_minY && value <= m_maxY) return;
+
+    // Zakres tylko rośnie (jak obwiednia) — zmiana skali zeruje bufor
+    double lo = m_rangeValid ? std::min(m_minY, value) : value;
+    double hi = m_rangeValid ? std::max(m_maxY, value) : value;
+    double margin = (hi - lo) * 0.1;
+    if (margin <= 0.0) margin = std::max(std::fabs(value) * 0.1, 1e-3);
+    // Przepełnienie (|wartość| bliska DBL_MAX) albo zerowa szerokość — zakres bez zmian
+    double minY = lo - margin, maxY = hi + margin;
+    if (!std::isfinite(maxY - minY) || !(maxY > minY)) return;
+    m_minY = minY;
+    m_maxY = maxY;
+    m_rangeValid = true;
+    std::fill(m_hits.begin(), m_hits.end(), 0.0f);
+    m_hasPrev = false;
+}
+
+bool ChartPersistence::startSweep(int64_t timeNs, bool hasCrossing, int64_t crossingNs) {
+    int64_t start;
+    if (m_triggered) {
+        if (hasCrossing && crossingNs <= timeNs && (!m_hasSweep || crossingNs >= m_sweepEnd)) {
+            start = crossingNs;
+        } else if (m_autoFreeRun && (!m_hasSweep || timeNs - m_sweepEnd >= m_sweepNs)) {
+            start = timeNs;
+        } else {
+            return false;
+        }
+    } else {
+        // Free-run: kolejny przebieg zaczyna się tam, gdzie skończył się poprzedni
+        bool chain = m_hasSweep && timeNs >= m_sweepEnd && timeNs - m_sweepEnd < m_sweepNs;
+        start = chain ? m_sweepEnd : timeNs;
+    }
+    m_sweepStart = start;
+    m_sweeping = true;
+    m_hasPrev = false;
+    return true;
+}
+
+void ChartPersistence::push(int64_t timeNs, double value, bool newSegment, bool hasCrossing, int64_t crossingNs) {
+    if (!ready() || !std::isfinite(value)) return;
+    if (m_autoRange) fitRange(value);
+    if (!m_rangeValid) return;
+
+    if (m_sweeping && timeNs >= m_sweepStart + m_sweepNs) {
+        m_sweeping = false;
+        m_sweepEnd = m_sweepStart + m_sweepNs;
+        m_hasSweep = true;
+    }
+    if (!m_sweeping && !startSweep(timeNs, hasCrossing, crossingNs)) return;
+
+    double x = (double)(timeNs - m_sweepStart) * m_width / (double)m_sweepNs;
+    double y = (m_maxY - value) * (m_height - 1) / (m_maxY - m_minY);
+    x = x < 0.0 ? 0.0 : (x > m_width - 1 ? m_width - 1 : x);
+    y = y < 0.0 ? 0.0 : (y > m_height - 1 ? m_height - 1 : y);
+
+    if (m_hasPrev && !newSegment) {
+        vector(m_prevX, m_prevY, x, y);
+    } else {
+        m_hits[(size_t)(y + 0.5) * m_width + (size_t)(x + 0.5)] += 1.0f;
+    }
+    m_prevX = x;
+    m_prevY = y;
+    m_hasPrev = true;
+}
+
+void ChartPersistence::vector(double x0, double y0, double x1, double y1) {
+    // DDA bez pierwszego piksela (należy do poprzedniego wektora); próbki
+    // w tym samym pikselu też liczą się jako trafienie — jasność = czas przebywania
+    double dx = x1 - x0, dy = y1 - y0;
+    int steps = (int)std::max(std::fabs(dx), std::fabs(dy));
+    if (steps < 1) steps = 1;
+    double sx = dx / steps, sy = dy / steps;
+    double x = x0, y = y0;
+    for (int i = 0; i < steps; i++) {
+        x += sx;
+        y += sy;
+        m_hits[(size_t)(y + 0.5) * m_width + (size_t)(x + 0.5)] += 1.0f;
+    }
+}
+
+// ============================================================================
+// Render — zanik i mapowanie gęstości na kolor, O(pikseli)
+// ============================================================================
+void ChartPersistence::buildLut(ChartPersistencePalette palette, ChartColor color) {
+    if (m_lut.size() == 256 && palette == m_lutPalette && color == m_lutColor) return;
+    m_lut.resize(256);
+    m_lut[0] = CHART_COLOR_NONE;
+
+    // Termiczna: punkty kontrolne (t, r, g, b)
+    static const double stops[6][4] = {
+        { 0.00,   0,   0, 160 },
+        { 0.25,   0, 160, 255 },
+        { 0.50,   0, 255,   0 },
+        { 0.70, 255, 255,   0 },
+        { 0.85, 255,   0,   0 },
+        { 1.00, 255, 255, 255 }
+    };
+
+    for (int i = 1; i < 256; i++) {
+        double t = (i - 1) / 254.0;
+        if (palette == CHART_PALETTE_THERMAL) {
+            int s = 0;
+            while (s < 4 && t > stops[s + 1][0]) s++;
+            double f = (t - stops[s][0]) / (stops[s + 1][0] - stops[s][0]);
+            uint8_t rgb[3];
+            for (int c = 0; c < 3; c++) {
+                rgb[c] = (uint8_t)(stops[s][c + 1] + (stops[s + 1][c + 1] - stops[s][c + 1]) * f + 0.5);
+            }
+            m_lut[i] = chartRgb(rgb[0], rgb[1], rgb[2]);
+        } else {
+            // Najsłabsze trafienie nadal widoczne (20% jasności)
+            double k = 0.2 + 0.8 * t;
+            m_lut[i] = chartRgb((uint8_t)(chartRed(color) * k), (uint8_t)(chartGreen(color) * k),
+                                (uint8_t)(chartBlue(color) * k));
+        }
+    }
+    m_lutPalette = palette;
+    m_lutColor = color;
+}
+
+void ChartPersistence::render(int64_t nowNs, ChartPersistencePalette palette, ChartColor color,
+                              int outWidth, int outHeight, std::vector<ChartColor>& out) {
+    if (outWidth < 0) outWidth = 0;
+    if (outHeight < 0) outHeight = 0;
+    size_t count = m_hits.size();
+    out.resize((size_t)outWidth * outHeight);
+    buildLut(palette, color);
+
+    // Zanik wg czasu danych (zatrzymany strumień = zatrzymany obraz)
+    float factor = 1.0f;
+    if (m_hasDecayTime && nowNs > m_decayNs && m_decaySec > 0.0) {
+        factor = (float)std::exp(-(double)(nowNs - m_decayNs) / (m_decaySec * 1e9));
+    }
+    if (!m_hasDecayTime || nowNs > m_decayNs) {
+        m_decayNs = nowNs;
+        m_hasDecayTime = true;
+    }
+
+    float peak = 0.0f;
+    float* hits = m_hits.data();
+    for (size_t i = 0; i < count; i++) {
+        float v = hits[i] * factor;
+        if (v < HIT_FLOOR) v = 0.0f;
+        hits[i] = v;
+        if (v > peak) peak = v;
+    }
+
+    if (peak <= 0.0f || out.empty()) {
+        std::fill(out.begin(), out.end(), CHART_COLOR_NONE);
+        return;
+    }
+
+    // Skala logarytmiczna względem najjaśniejszego piksela — rzadkie zdarzenia nie giną
+    float scale = 254.0f / std::log1p(peak);
+    if (outWidth == m_width && outHeight == m_height) {
+        for (size_t i = 0; i < count; i++) {
+            float v = hits[i];
+            if (v <= 0.0f) {
+                out[i] = CHART_COLOR_NONE;
+                continue;
+            }
+            int index = 1 + (int)(std::log1p(v) * scale);
+            out[i] = m_lut[index > 255 ? 255 : index];
+        }
+        return;
+    }
+
+    // Inny rozmiar (eksport): piksel wyjścia = najjaśniejsze trafienie z pokrytego
+    // obszaru bufora — cienki ślad nie znika przy zmniejszeniu
+    for (int y = 0; y < outHeight; y++) {
+        int y0 = (int)((int64_t)y * m_height / outHeight);
+        int y1 = std::max(y0 + 1, (int)((int64_t)(y + 1) * m_height / outHeight));
+        for (int x = 0; x < outWidth; x++) {
+            int x0 = (int)((int64_t)x * m_width / outWidth);
+            int x1 = std::max(x0 + 1, (int)((int64_t)(x + 1) * m_width / outWidth));
+            float v = 0.0f;
+            for (int sy = y0; sy < y1; sy++) {
+                const float* row = hits + (size_t)sy * m_width;
+                for (int sx = x0; sx < x1; sx++) {
+                    if (row[sx] > v) v = row[sx];
+                }
+            }
+            ChartColor& pixel = out[(size_t)y * outWidth + x];
+            if (v <= 0.0f) {
+                pixel = CHART_COLOR_NONE;
+                continue;
+            }
+            int index = 1 + (int)(std::log1p(v) * scale);
+            pixel = m_lut[index > 255 ? 255 : index];
+        }
+    }
+}
@@ -0,0 +1,105 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 JAQUBA (https://github.com/JAQUBA)
+// Part of JQB_WindowsLib — https://github.com/JAQUBA/JQB_WindowsLib
+
+/**
+ * ChartPersistence.h — phosphor-style (intensity graded) display of a stream
+ *
+ * Samples are not stored: each one is rasterised straight into a per-pixel
+ * hit-count buffer as part of a sweep across the plot (free-running, or
+ * started by a trigger crossing). Hits decay exponentially with data time;
+ * rendering maps density to a colour palette (log scale, any hit visible).
+ *
+ * Ingest costs O(samples) — each sample adds one short vector; rendering
+ * costs O(plot pixels) and is independent of the sample rate.
+ *
+ * Nie zależy od WinAPI.
+ */
+
+#ifndef CHART_PERSISTENCE_H
+#define CHART_PERSISTENCE_H
+
+#include "ChartCanvas.h"
+#include <cstdint>
+#include <vector>
+
+enum ChartPersistencePalette {
+    CHART_PALETTE_MONO = 0,     // series colour, dim → bright (default)
+    CHART_PALETTE_THERMAL       // blue → cyan → green → yellow → red → white
+};
+
+class ChartPersistence {
+public:
+    ChartPersistence();
+
+    // Plot area size and sweep length — a change clears the buffer
+    void configure(int width, int height, int64_t sweepNs);
+    bool ready() const { return m_width > 0 && m_height > 0 && m_sweepNs > 0; }
+    int width() const  { return m_width; }
+    int height() const { return m_height; }
+
+    // Manual Y range, or auto: grows to fit the data (buffer restarts on growth)
+    void setRange(double minY, double maxY);
+    void setAutoRange();
+    bool rangeValid() const { return m_rangeValid; }
+    double rangeMin() const { return m_minY; }
+    double rangeMax() const { return m_maxY; }
+
+    // Czas zaniku do 1/e w sekundach (0 = bez zaniku, nieskończona poświata)
+    void setDecay(double seconds) { m_decaySec = seconds > 0.0 ? seconds : 0.0; }
+    double getDecay() const { return m_decaySec; }
+
+    // Triggered sweeps start at a crossing; autoFreeRun starts one anyway
+    // after a sweep-long wait (like CHART_TRIGGER_AUTO)
+    void setTriggered(bool triggered, bool autoFreeRun);
+
+    void clear();
+
+    // One sample of the stream; crossingNs = newest trigger crossing (hasCrossing = false: none yet)
+    void push(int64_t timeNs, double value, bool newSegment, bool hasCrossing, int64_t crossingNs);
+
+    // Decay to nowNs, then map hits to colours (CHART_COLOR_NONE where empty).
+    // out has outWidth × outHeight pixels, rows top-down; another size than the
+    // buffer is scaled (max of the covered hits) without touching the buffer.
+    void render(int64_t nowNs, ChartPersistencePalette palette, ChartColor color,
+                int outWidth, int outHeight, std::vector<ChartColor>& out);
+
+    size_t memoryBytes() const { return m_hits.capacity() * sizeof(float); }
+
+private:
+    int m_width;
+    int m_height;
+    int64_t m_sweepNs;
+    std::vector<float> m_hits;          // width × height, rows top-down
+
+    double m_minY;
+    double m_maxY;
+    bool m_rangeValid;
+    bool m_autoRange;
+
+    double m_decaySec;
+    int64_t m_decayNs;                  // Czas danych, do którego bufor jest wygaszony
+    bool m_hasDecayTime;
+
+    bool m_triggered;
+    bool m_autoFreeRun;
+    bool m_sweeping;
+    int64_t m_sweepStart;
+    int64_t m_sweepEnd;                 // Koniec poprzedniego przebiegu
+    bool m_hasSweep;
+    bool m_hasPrev;
+    double m_prevX;
+    double m_prevY;
+
+    // Paleta (256 wpisów) — przebudowywana przy zmianie palety / koloru
+    std::vector<ChartColor> m_lut;
+    ChartPersistencePalette m_lutPalette;
+    ChartColor m_lutColor;
+
+    bool startSweep(int64_t timeNs, bool hasCrossing, int64_t crossingNs);
+    void fitRange(double value);
+    void vector(double x0, double y0, double x1, double y1);
+    void buildLut(ChartPersistencePalette palette, ChartColor color);
+};
+
+#endif // CHART_PERSISTENCE_H
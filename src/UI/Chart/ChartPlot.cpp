@@ -0,0 +1,1431 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 JAQUBA (https://github.com/JAQUBA)
+// Part of JQB_WindowsLib — https://github.com/JAQUBA/JQB_WindowsLib
+
+#include "ChartPlot.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+// Etykiety są czystym ASCII — formatowanie przez snprintf, bez zależności od wariantu swprintf
+static std::wstring formatLabel(const char* format, double value) {
+    char buf[32];
+    snprintf(buf, sizeof(buf), format, value);
+    return std::wstring(buf, buf + strlen(buf));
+}
+
+// Etykieta częstotliwości: 20, 500, 1k, 2.5k
+static std::wstring formatFrequency(double hz) {
+    if (hz >= 1000.0) return formatLabel("%gk", std::round(hz / 100.0) / 10.0);
+    if (hz >= 10.0)   return formatLabel("%.0f", hz);
+    return formatLabel("%.3g", hz);
+}
+
+// Wartość z przedrostkiem SI: "12.5 mV", "3.3 kHz" (ASCII — "u" zamiast mikro)
+static std::wstring formatEng(double value, const std::wstring& unit) {
+    static const char* const prefixes[] = { "p", "n", "u", "m", "", "k", "M", "G" };
+    int p = 4;
+    double a = std::fabs(value);
+    if (a != 0.0 && !unit.empty()) {
+        while (a < 1.0 && p > 0)     { a *= 1000.0; p--; }
+        while (a >= 1000.0 && p < 7) { a /= 1000.0; p++; }
+    }
+    char buf[48];
+    snprintf(buf, sizeof(buf), unit.empty() ? "%.4g" : "%.4g %s", value < 0.0 ? -a : a, prefixes[p]);
+    return std::wstring(buf, buf + strlen(buf)) + unit;
+}
+
+ChartPlot::ChartPlot() {
+    m_series.resize(1);     // Seria 0 — addDataPoint(s)
+}
+
+// ============================================================================
+// Dodawanie danych
+// ============================================================================
+void ChartPlot::addPoint(int series, double value, int64_t timeNs) {
+    if (series < 0 || series >= (int)m_series.size()) return;
+    Series& s = m_series[series];
+    pushSample(s, timeNs, value, false);
+    cleanOldDataPoints(s);
+}
+
+void ChartPlot::addBatch(int series, const double* values, int count, double totalDurationMs, int64_t nowTimeNs) {
+    if (count <= 0 || series < 0 || series >= (int)m_series.size()) return;
+    Series& s = m_series[series];
+    int64_t batchNs = static_cast<int64_t>(totalDurationMs * 1000000.0);
+    
+    // Virtual time base: batches are spaced at exactly totalDurationMs
+    // regardless of poll jitter. Like an oscilloscope — time derived from
+    // sample rate, not from when the UI thread happened to read the data.
+    int64_t startNs = nowTimeNs - batchNs;
+    int64_t endNs = nowTimeNs;
+    bool gapDetected = false;
+    
+    if (s.hasBatchHistory) {
+        int64_t gap = nowTimeNs - s.lastBatchEndNs;
+        if (gap < batchNs * 3) {
+            // Chain: start where previous batch ended, advance by exact duration
+            startNs = s.lastBatchEndNs;
+            endNs = startNs + batchNs;
+        } else {
+            gapDetected = true;
+        }
+    }
+    
+    // Sample i at startNs + (i + 1) * period — the last one lands on endNs and
+    // the next chained batch continues the same run without a duplicate time
+    double periodNs = (double)(endNs - startNs) / count;
+    int64_t firstNs = startNs + (int64_t)periodNs;
+    
+    if (m_displayMode == CHART_MODE_PERSISTENCE && &s == &m_series[0]) {
+        for (int i = 0; i < count; i++) {
+            persistSample(firstNs + (int64_t)(i * periodNs), values[i], i == 0 && gapDetected);
+        }
+    } else {
+        pushUniform(s, firstNs, periodNs, values, count, gapDetected);
+    }
+    
+    s.lastBatchEndNs = endNs;
+    s.hasBatchHistory = true;
+    cleanOldDataPoints(s);
+    
+    // Jedno FFT na paczkę — częstotliwość próbkowania wynika z czasu trwania paczki
+    if (m_displayMode == CHART_MODE_SPECTRUM && series == 0 && totalDurationMs > 0.0) {
+        m_spectrum.process(values, count, count * 1000.0 / totalDurationMs);
+    }
+}
+
+void ChartPlot::pushSample(Series& series, int64_t timeNs, double value, bool newSegment) {
+    if (m_displayMode == CHART_MODE_PERSISTENCE && &series == &m_series[0]) {
+        persistSample(timeNs, value, newSegment);
+        return;
+    }
+    // Bufor o stałej pojemności może przy tym usunąć najstarszą próbkę
+    uint64_t seq = series.data.endSeq();
+    series.data.push(timeNs, value, newSegment);
+    series.stats.evictBefore(series.data.firstSeq());
+    series.stats.push(seq, value);
+    if (!budgetActive()) series.extrema.push(seq, value);
+    series.history.push(seq, timeNs, value, newSegment);
+    if (m_triggerEnabled && &series == &m_series[0]) {
+        m_trigger.push(timeNs, value, newSegment);
+    }
+    if (!m_hasData || timeNs > m_newestNs) m_newestNs = timeNs;
+    m_hasData = true;
+}
+
+void ChartPlot::pushUniform(Series& series, int64_t firstNs, double periodNs, const double* values, int count,
+                            bool newSegment) {
+    // Czas próbek nie jest zapisywany — bufor trzyma tylko początek i okres przebiegu
+    uint64_t seq = series.data.endSeq();
+    series.data.pushUniform(firstNs, periodNs, values, (size_t)count, newSegment);
+    ChartBuffer::Run run = series.data.runAt(series.data.size() - 1);
+    
+    series.stats.evictBefore(series.data.firstSeq());
+    
+    bool trigger = m_triggerEnabled && &series == &m_series[0];
+    bool extrema = !budgetActive();
+    for (int i = 0; i < count; i++) {
+        int64_t timeNs = ChartBuffer::uniformTime(run, seq + i);
+        // Próbki, które nie zmieściły się w buforze o stałej pojemności, trafiają tylko do historii
+        if (seq + i >= series.data.firstSeq()) series.stats.push(seq + i, values[i]);
+        if (extrema) series.extrema.push(seq + i, values[i]);
+        series.history.push(seq + i, timeNs, values[i], i == 0 && newSegment);
+        if (trigger) m_trigger.push(timeNs, values[i], i == 0 && newSegment);
+    }
+    
+    int64_t lastNs = ChartBuffer::uniformTime(run, seq + count - 1);
+    if (!m_hasData || lastNs > m_newestNs) m_newestNs = lastNs;
+    m_hasData = true;
+}
+
+void ChartPlot::persistSample(int64_t timeNs, double value, bool newSegment) {
+    int64_t crossing = 0;
+    bool hasCrossing = false;
+    if (m_triggerEnabled) {
+        m_trigger.push(timeNs, value, newSegment);
+        hasCrossing = m_trigger.lastCrossing(crossing);
+        // Potrzebne jest tylko najnowsze przejście — indeks nie rośnie
+        m_trigger.evictBefore(timeNs);
+    }
+    m_persistence.push(timeNs, value, newSegment, hasCrossing, crossing);
+    if (!m_hasData || timeNs > m_newestNs) m_newestNs = timeNs;
+    m_hasData = true;
+}
+
+void ChartPlot::cleanOldDataPoints(Series& series) {
+    if (series.data.empty()) {
+        return;
+    }
+    
+    // Use latest data timestamp (across all series) as reference, not wall-clock,
+    // so virtual time base doesn't cause premature cleanup
+    int64_t refTime = m_newestNs;
+    // Keep extra data when trigger is enabled (need history to search for crossings)
+    double retainSec = m_triggerEnabled ? m_timeWindowSec * 3.0 : m_timeWindowSec;
+    int64_t cutoff = refTime - static_cast<int64_t>(retainSec * 1e9);
+    
+    // Zatrzymana ramka SINGLE zachowuje swoje próbki do ponownego uzbrojenia
+    if (m_triggerEnabled && m_triggerMode == CHART_TRIGGER_SINGLE && m_triggerHeld) {
+        int64_t heldStart = m_heldRefNs - static_cast<int64_t>(m_timeWindowSec * 1e9);
+        if (heldStart < cutoff) cutoff = heldStart;
+    }
+    
+    // Indeks przejść trzyma pełną retencję triggera — niezależnie od tego,
+    // ile surowych próbek zostaje przy warstwach historii
+    int64_t triggerCutoff = cutoff;
+    
+    // With history tiers, raw samples only cover the newest rawSeconds —
+    // the rest of the window is served from the buckets
+    if (series.history.enabled()) {
+        series.history.dropOlderThan(cutoff);
+        if (m_historyRawSec > 0.0 && m_historyRawSec < retainSec) {
+            cutoff = refTime - static_cast<int64_t>(m_historyRawSec * 1e9);
+        }
+    }
+    
+    // Timestamps are monotonic — binary search for the cutoff, then advance the head
+    series.data.dropOlderThan(cutoff);
+    series.extrema.evictBefore(series.data.firstSeq());
+    series.stats.evictBefore(series.data.firstSeq());
+    if (&series == &m_series[0]) {
+        m_trigger.evictBefore(triggerCutoff);
+    }
+}
+
+void ChartPlot::clear() {
+    for (Series& s : m_series) {
+        s.data.clear();
+        s.extrema.clear();
+        s.stats.clear();
+        s.history.clear();
+        s.hasBatchHistory = false;
+    }
+    m_axes[0].viewValid = false;
+    m_axes[1].viewValid = false;
+    m_hasData = false;
+    m_trigger.reset();
+    m_triggerHeld = false;
+    m_layerValid = false;
+    m_spectrum.clear();
+    m_persistence.clear();
+}
+
+// ============================================================================
+// Serie
+// ============================================================================
+int ChartPlot::addSeries(const std::wstring& name, ChartColor color, const std::wstring& unit, bool secondaryAxis) {
+    Series s;
+    s.name = name;
+    s.color = color;
+    s.unit = unit;
+    s.secondaryAxis = secondaryAxis;
+    s.history.configure(m_historyBuckets);
+    m_series.push_back(std::move(s));
+    m_staticDirty = true;
+    // Budżet dzielony równo między serie — nowy podział
+    if (budgetActive()) configureStorage();
+    return (int)m_series.size() - 1;
+}
+
+void ChartPlot::setSeriesVisible(int series, bool visible) {
+    if (series < 0 || series >= (int)m_series.size()) return;
+    m_series[series].visible = visible;
+    m_staticDirty = true;
+}
+
+bool ChartPlot::isSeriesVisible(int series) const {
+    if (series < 0 || series >= (int)m_series.size()) return false;
+    return m_series[series].visible;
+}
+
+void ChartPlot::setSeriesColor(int series, ChartColor color) {
+    if (series < 0 || series >= (int)m_series.size()) return;
+    m_series[series].color = color;
+    m_staticDirty = true;
+}
+
+void ChartPlot::setSeriesUnit(int series, const std::wstring& unit) {
+    if (series < 0 || series >= (int)m_series.size()) return;
+    if (m_series[series].unit == unit) return;
+    m_series[series].unit = unit;
+    m_staticDirty = true;
+}
+
+const std::wstring& ChartPlot::getSeriesUnit(int series) const {
+    static const std::wstring empty;
+    if (series < 0 || series >= (int)m_series.size()) return empty;
+    return m_series[series].unit;
+}
+
+void ChartPlot::setSeriesAxis(int series, bool secondaryAxis) {
+    if (series < 0 || series >= (int)m_series.size()) return;
+    m_series[series].secondaryAxis = secondaryAxis;
+    m_staticDirty = true;
+    m_axes[0].viewValid = false;
+    m_axes[1].viewValid = false;
+}
+
+size_t ChartPlot::getPointCount() const {
+    size_t total = 0;
+    for (const Series& s : m_series) total += s.data.size();
+    return total;
+}
+
+size_t ChartPlot::getMemoryUsage() const {
+    size_t total = 0;
+    for (const Series& s : m_series) total += s.data.memoryBytes() + s.stats.memoryBytes() + s.history.memoryBytes();
+    return total + m_persistence.memoryBytes();
+}
+
+void ChartPlot::setHistoryTiers(double rawSeconds, size_t bucketsPerLevel) {
+    m_historyRawSec = rawSeconds > 0.0 ? rawSeconds : 0.0;
+    m_historyBuckets = m_historyRawSec > 0.0 ? bucketsPerLevel : 0;
+    configureStorage();
+}
+
+void ChartPlot::setMemoryBudget(size_t maxBytes) {
+    m_budgetBytes = maxBytes;
+    m_budgetPoints = 0;
+    configureStorage();
+}
+
+void ChartPlot::setPointBudget(size_t maxPoints) {
+    m_budgetPoints = maxPoints;
+    m_budgetBytes = 0;
+    configureStorage();
+}
+
+void ChartPlot::budgetGeometry(size_t& capacity, size_t& buckets) const {
+    size_t n = m_series.size();
+    capacity = 64;
+    if (m_budgetBytes > 0) {
+        // 1/8 udziału serii na warstwy historii — sięgają wstecz 16^6 razy dalej niż liczba kubełków
+        size_t share = m_budgetBytes / n;
+        buckets = share / 8 / (ChartHistory::MAX_LEVELS * sizeof(ChartBucket));
+        size_t raw = share - buckets * ChartHistory::MAX_LEVELS * sizeof(ChartBucket);
+        while (ChartBuffer::fixedBytes(capacity * 2) + ChartRangeStats::reserveBytes(capacity * 2) <= raw) {
+            capacity *= 2;
+        }
+    } else {
+        while (capacity * 2 <= m_budgetPoints / n) capacity *= 2;
+        buckets = capacity / 64;
+    }
+    if (buckets < 16) buckets = 16;
+}
+
+void ChartPlot::configureStorage() {
+    m_layerValid = false;
+    bool budget = budgetActive();
+    size_t capacity = 0;
+    size_t buckets = m_historyBuckets;
+    if (budget) budgetGeometry(capacity, buckets);
+    
+    for (Series& s : m_series) {
+        // Z budżetem: wszystko alokowane teraz, później już nic nie rośnie
+        s.data.setFixedCapacity(capacity);
+        if (budget) s.stats.reserve(capacity);
+        s.history.configure(buckets, budget);
+        
+        // Odbuduj warstwy (i MIN/MAX okna) z próbek, które już są w buforze
+        s.extrema.clear();
+        for (size_t i = 0; i < s.data.size(); i++) {
+            uint64_t seq = s.data.firstSeq() + i;
+            s.history.push(seq, s.data.timeAt(i), s.data.valueAt(i), s.data.isSegmentStart(i));
+            if (!budget) s.extrema.push(seq, s.data.valueAt(i));
+        }
+        cleanOldDataPoints(s);
+    }
+}
+
+void ChartPlot::setColors(ChartColor gridColor, ChartColor axisColor, ChartColor dataColor) {
+    m_gridColor = gridColor;
+    m_axisColor = axisColor;
+    m_series[0].color = dataColor;
+    m_staticDirty = true;
+}
+
+void ChartPlot::setAutoScale(int axis, bool autoScale) {
+    if (axis < 0 || axis > 1) return;
+    m_axes[axis].autoScale = autoScale;
+}
+
+void ChartPlot::setYRange(int axis, double minY, double maxY) {
+    if (axis < 0 || axis > 1) return;
+    m_axes[axis].manualMin = minY;
+    m_axes[axis].manualMax = maxY;
+    m_axes[axis].autoScale = false;
+}
+
+// ============================================================================
+// Widmo
+// ============================================================================
+void ChartPlot::setDisplayMode(ChartDisplayMode mode) {
+    if (mode == m_displayMode) return;
+    bool persistence = mode == CHART_MODE_PERSISTENCE || m_displayMode == CHART_MODE_PERSISTENCE;
+    m_displayMode = mode;
+    m_staticDirty = true;
+    m_layerValid = false;
+    if (!persistence) return;
+    
+    // Poświata nie zapisuje serii 0 — stare próbki i indeks przejść są nieaktualne
+    Series& s = m_series[0];
+    s.data.clear();
+    s.extrema.clear();
+    s.stats.clear();
+    s.history.clear();
+    m_axes[0].viewValid = false;
+    m_persistence.clear();
+    syncPersistenceTrigger();
+    rebuildTrigger();
+    
+    // Rozmiar znany z poprzednich klatek — próbki przed pierwszą klatką poświaty nie giną
+    if (mode == CHART_MODE_PERSISTENCE && m_frameWidth > 0 && m_frameHeight > 0) {
+        beginPersistenceFrame(plotArea(m_frameWidth, m_frameHeight), true);
+    }
+}
+
+void ChartPlot::configureSpectrum(size_t fftSize, FFTWindow window) {
+    m_spectrum.configure(fftSize, window);
+    m_staticDirty = true;
+}
+
+void ChartPlot::setSpectrumRange(double minDb, double maxDb) {
+    if (maxDb <= minDb) return;
+    m_spectrumMinDb = minDb;
+    m_spectrumMaxDb = maxDb;
+    m_staticDirty = true;
+}
+
+void ChartPlot::setSpectrumFrequencyRange(double minHz, double maxHz) {
+    m_spectrumMinHz = minHz > 0.0 ? minHz : 0.0;
+    m_spectrumMaxHz = maxHz > m_spectrumMinHz ? maxHz : 0.0;
+    m_staticDirty = true;
+}
+
+void ChartPlot::addSpectrumSamples(const double* samples, int count, double sampleRate) {
+    m_spectrum.process(samples, count, sampleRate);
+}
+
+void ChartPlot::setSpectrum(const double* magnitudes, size_t bins, double binHz) {
+    m_spectrum.setMagnitudes(magnitudes, bins, binHz);
+}
+
+void ChartPlot::updateFrequencyRange() {
+    // Automatycznie: pierwszy prążek (skala log) lub 0 .. Nyquist
+    double binHz = m_spectrum.binHz();
+    double nyquist = m_spectrum.nyquistHz();
+    if (m_spectrum.empty() || nyquist <= 0.0) {
+        binHz = 10.0;
+        nyquist = 1000.0;
+    }
+    double minHz = m_spectrumMinHz > 0.0 ? m_spectrumMinHz : (m_spectrumLogFreq ? binHz : 0.0);
+    double maxHz = m_spectrumMaxHz > 0.0 ? m_spectrumMaxHz : nyquist;
+    if (maxHz <= minHz) maxHz = minHz * 10.0 + 1.0;
+    m_frameMinHz = minHz;
+    m_frameMaxHz = maxHz;
+}
+
+ChartSpectrumViewport ChartPlot::spectrumViewport(const ChartRect& plot) const {
+    ChartSpectrumViewport vp;
+    vp.left         = plot.left;
+    vp.width        = plot.right - plot.left;
+    vp.bottom       = plot.bottom;
+    vp.height       = plot.bottom - plot.top;
+    vp.minHz        = m_frameMinHz;
+    vp.maxHz        = m_frameMaxHz;
+    vp.minDb        = m_spectrumMinDb;
+    vp.maxDb        = m_spectrumMaxDb;
+    vp.logFrequency = m_spectrumLogFreq && m_frameMinHz > 0.0;
+    return vp;
+}
+
+// ============================================================================
+// Skalowanie
+// ============================================================================
+bool ChartPlot::rawExtremes(const Series& series, double& lo, double& hi) const {
+    if (!budgetActive()) {
+        if (series.extrema.empty()) return false;
+        lo = series.extrema.min();
+        hi = series.extrema.max();
+        return true;
+    }
+    // Z budżetem kolejki MIN/MAX nie są prowadzone (mogłyby rosnąć) — bloki statystyk
+    ChartStats st = series.stats.query(series.data, 0, series.data.size());
+    if (st.count == 0) return false;
+    lo = st.min;
+    hi = st.max;
+    return true;
+}
+
+double ChartPlot::getMinValue(int axis) const {
+    const Axis& a = m_axes[axis];
+    if (!a.autoScale) {
+        return a.manualMin;
+    }
+    
+    bool found = false;
+    double minVal = 0.0;
+    for (size_t i = 0; i < m_series.size(); i++) {
+        const Series& s = m_series[i];
+        if (!s.visible || (int)s.secondaryAxis != axis) continue;
+        double v;
+        if (i < m_views.size() && m_views[i].level > 0) {
+            // Okno sięga poza surowe próbki — zakres z kubełków historii
+            if (m_views[i].count == 0) continue;
+            v = m_views[i].minValue;
+        } else {
+            double lo, hi;
+            if (!rawExtremes(s, lo, hi)) continue;
+            v = lo;
+        }
+        if (!found || v < minVal) minVal = v;
+        found = true;
+    }
+    if (!found) {
+        return a.manualMin;
+    }
+    
+    // Dodaj trochę marginesu
+    return minVal - std::abs(minVal * 0.1);
+}
+
+double ChartPlot::getMaxValue(int axis) const {
+    const Axis& a = m_axes[axis];
+    if (!a.autoScale) {
+        return a.manualMax;
+    }
+    
+    bool found = false;
+    double maxVal = 0.0;
+    for (size_t i = 0; i < m_series.size(); i++) {
+        const Series& s = m_series[i];
+        if (!s.visible || (int)s.secondaryAxis != axis) continue;
+        double v;
+        if (i < m_views.size() && m_views[i].level > 0) {
+            // Okno sięga poza surowe próbki — zakres z kubełków historii
+            if (m_views[i].count == 0) continue;
+            v = m_views[i].maxValue;
+        } else {
+            double lo, hi;
+            if (!rawExtremes(s, lo, hi)) continue;
+            v = hi;
+        }
+        if (!found || v > maxVal) maxVal = v;
+        found = true;
+    }
+    if (!found) {
+        return a.manualMax;
+    }
+    
+    // Dodaj trochę marginesu
+    return maxVal + std::abs(maxVal * 0.1);
+}
+
+void ChartPlot::updateScale(int axis) {
+    Axis& a = m_axes[axis];
+    double minY = getMinValue(axis);
+    double maxY = getMaxValue(axis);
+    
+    // Jeśli min i max są takie same (płaska linia), dodaj margines
+    if (std::fabs(maxY - minY) < 0.001) {
+        minY = minY * 0.9;
+        maxY = maxY * 1.1;
+        
+        // Specjalny przypadek dla zera
+        if (std::fabs(minY) < 0.001 && std::fabs(maxY) < 0.001) {
+            minY = -1.0;
+            maxY = 1.0;
+        }
+    }
+    
+    if (!a.autoScale || m_scaleHysteresis <= 0.0 || !a.viewValid) {
+        a.viewMin = minY;
+        a.viewMax = maxY;
+        a.viewValid = true;
+        return;
+    }
+    
+    // Rozszerzaj natychmiast, zwężaj dopiero po wyraźnym spadku zakresu danych
+    bool outside = minY < a.viewMin || maxY > a.viewMax;
+    bool shrunk = (maxY - minY) < (a.viewMax - a.viewMin) * (1.0 - m_scaleHysteresis);
+    if (outside || shrunk) {
+        a.viewMin = minY;
+        a.viewMax = maxY;
+    }
+}
+
+bool ChartPlot::hasSecondaryAxis() const {
+    for (const Series& s : m_series) {
+        if (s.visible && s.secondaryAxis) return true;
+    }
+    return false;
+}
+
+ChartRect ChartPlot::plotArea(int width, int height) const {
+    ChartRect plot;
+    plot.left   = 50;
+    plot.top    = 20;
+    plot.right  = width - (hasSecondaryAxis() ? 50 : 10);
+    plot.bottom = height - 20;
+    return plot;
+}
+
+// ============================================================================
+// Trigger
+// ============================================================================
+void ChartPlot::setTriggerEnabled(bool enabled) {
+    if (enabled == m_triggerEnabled) return;
+    m_triggerEnabled = enabled;
+    m_triggerHeld = false;
+    m_layerValid = false;
+    rebuildTrigger();
+    syncPersistenceTrigger();
+}
+
+void ChartPlot::setTriggerLevel(double level, ChartTriggerEdge edge, double hysteresis) {
+    m_trigger.setLevel(level);
+    m_trigger.setEdge(edge);
+    m_trigger.setHysteresis(hysteresis);
+    rebuildTrigger();
+}
+
+void ChartPlot::setTriggerHoldoff(double seconds) {
+    m_trigger.setHoldoff(static_cast<int64_t>(seconds * 1e9));
+    rebuildTrigger();
+}
+
+void ChartPlot::setTriggerMode(ChartTriggerMode mode) {
+    m_triggerMode = mode;
+    m_triggerHeld = false;
+    if (mode == CHART_TRIGGER_SINGLE) {
+        armTrigger();
+    }
+    syncPersistenceTrigger();
+}
+
+void ChartPlot::syncPersistenceTrigger() {
+    // Przebiegi poświaty: NORMAL/SINGLE czekają na przejście, AUTO po czasie przebiegu rusza sam
+    m_persistence.setTriggered(m_triggerEnabled, m_triggerMode == CHART_TRIGGER_AUTO);
+}
+
+void ChartPlot::armTrigger() {
+    m_singleArmed = true;
+    m_armTimeNs = m_newestNs;
+    m_triggerHeld = false;
+}
+
+void ChartPlot::rebuildTrigger() {
+    // Indeks przejść od nowa z próbek, które już są w buforze serii 0
+    m_trigger.reset();
+    if (!m_triggerEnabled) return;
+    const ChartBuffer& data = m_series[0].data;
+    for (size_t i = 0; i < data.size(); i++) {
+        m_trigger.push(data.timeAt(i), data.valueAt(i), data.isSegmentStart(i));
+    }
+}
+
+int64_t ChartPlot::findReferenceTime() {
+    // Czas referencyjny: najnowszy punkt danych ze wszystkich serii (nie wall-clock now)
+    // Dzięki temu dane są zawsze widoczne — prawy brzeg = najnowsza próbka
+    int64_t refTime = m_newestNs;
+    const ChartBuffer& data = m_series[0].data;
+    int64_t windowNs = static_cast<int64_t>(m_timeWindowSec * 1e9);
+
+    if (!m_triggerEnabled || data.empty()) {
+        return refTime;
+    }
+
+    // Trigger ustawia lewą krawędź okna. Wyzwolenie musi mieć za sobą pełne
+    // okno danych, więc szukamy przejścia <= najnowsza próbka - okno —
+    // wyszukiwanie binarne w indeksie przejść zamiast skanu bufora.
+    int64_t latestTime = data.newestTime();
+    int64_t crossing;
+
+    switch (m_triggerMode) {
+        case CHART_TRIGGER_SINGLE:
+            if (!m_triggerHeld && m_singleArmed &&
+                m_trigger.firstAfter(m_armTimeNs, crossing) && latestTime - crossing >= windowNs) {
+                m_triggerHeld = true;
+                m_singleArmed = false;
+                m_heldRefNs = crossing + windowNs;
+            }
+            return m_triggerHeld ? m_heldRefNs : refTime;
+
+        case CHART_TRIGGER_NORMAL:
+            if (m_trigger.latestAtOrBefore(latestTime - windowNs, crossing)) {
+                m_triggerHeld = true;
+                m_heldRefNs = crossing + windowNs;
+            }
+            return m_triggerHeld ? m_heldRefNs : refTime;
+
+        case CHART_TRIGGER_AUTO:
+        default: {
+            // Free-run, gdy ostatnie wyzwolenie jest starsze niż jedno okno (lub holdoff)
+            int64_t timeout = std::max(windowNs, m_trigger.getHoldoff());
+            if (m_trigger.latestAtOrBefore(latestTime - windowNs, crossing) &&
+                latestTime - (crossing + windowNs) <= timeout) {
+                return crossing + windowNs;
+            }
+            return refTime;
+        }
+    }
+}
+
+// ============================================================================
+// Klatka
+// ============================================================================
+void ChartPlot::beginFrame(int width, int height, bool sizePersistence) {
+    m_frameWidth = width;
+    m_frameHeight = height;
+    
+    if (m_displayMode == CHART_MODE_SPECTRUM) {
+        updateFrequencyRange();
+        return;
+    }
+    if (m_displayMode == CHART_MODE_PERSISTENCE) {
+        beginPersistenceFrame(plotArea(width, height), sizePersistence);
+        return;
+    }
+    
+    // Oś czasu i źródło próbek (surowe / warstwa historii) — raz na klatkę
+    ChartRect plot = plotArea(width, height);
+    m_frameRefNs = findReferenceTime();
+    if (scrollingActive()) alignScroll(plot);
+    prepareViews(plot);
+    
+    // Zakres osi Y — liczony raz na klatkę, wspólny dla osi i danych
+    updateScale(0);
+    if (hasSecondaryAxis()) updateScale(1);
+    
+    measure();
+}
+
+void ChartPlot::render(ChartCanvas& canvas) {
+    // Bufor poświaty należy do okna — eksport nadaje mu rozmiar tylko, gdy go jeszcze nie ma
+    beginFrame(canvas.width(), canvas.height(), !m_persistence.ready());
+    drawStatic(canvas);
+    drawData(canvas);
+    drawOverlay(canvas);
+}
+
+void ChartPlot::renderExport(ChartCanvas& canvas) {
+    FrameState saved = { m_frameWidth, m_frameHeight, m_frameRefNs, m_views,
+                         { m_axes[0], m_axes[1] }, m_triggerHeld, m_heldRefNs, m_singleArmed,
+                         m_frameMinHz, m_frameMaxHz, m_measurement };
+    render(canvas);
+    
+    m_frameWidth = saved.width;
+    m_frameHeight = saved.height;
+    m_frameRefNs = saved.refNs;
+    m_views.swap(saved.views);
+    m_axes[0] = saved.axes[0];
+    m_axes[1] = saved.axes[1];
+    m_triggerHeld = saved.triggerHeld;
+    m_heldRefNs = saved.heldRefNs;
+    m_singleArmed = saved.singleArmed;
+    m_frameMinHz = saved.minHz;
+    m_frameMaxHz = saved.maxHz;
+    m_measurement = saved.measurement;
+    
+    // Klucz warstwy statycznej opisuje teraz eksport — okno przerysuje swoją
+    // (numer warstwy statycznej się zmienił, więc warstwa danych też)
+    m_staticDirty = true;
+}
+
+void ChartPlot::prepareViews(const ChartRect& plot) {
+    int64_t windowNs = static_cast<int64_t>(m_timeWindowSec * 1e9);
+    int64_t start = m_frameRefNs - windowNs;
+    size_t width = plot.right > plot.left ? (size_t)(plot.right - plot.left) : 1;
+    
+    m_views.resize(m_series.size());
+    for (size_t index = 0; index < m_series.size(); index++) {
+        const Series& s = m_series[index];
+        SeriesView& view = m_views[index];
+        view = SeriesView();
+        
+        if (!s.data.empty()) {
+            view.first = s.data.lowerBound(start);
+            view.count = s.data.lowerBound(m_frameRefNs + 1) - view.first;
+        }
+        if (!s.history.enabled() || s.history.empty(ChartHistory::MAX_LEVELS)) continue;
+        
+        // Poziom "pokrywa" okno, gdy sięga jego lewej krawędzi
+        // (albo najstarszych danych, jeśli okno jest dłuższe niż historia)
+        int64_t need = std::max(start, s.history.oldestTime(ChartHistory::MAX_LEVELS));
+        bool rawCovers = !s.data.empty() && s.data.oldestTime() <= need;
+        
+        // Surowe próbki, dopóki ich liczba jest rozsądna względem szerokości wykresu
+        if (rawCovers && view.count <= width * ChartHistory::FANOUT * 4) continue;
+        
+        // Najdrobniejsza warstwa pokrywająca okno, ~kilka kubełków na kolumnę
+        int chosen = 0;
+        for (int level = 1; level <= ChartHistory::MAX_LEVELS; level++) {
+            if (s.history.oldestTime(level) > need) continue;
+            chosen = level;
+            size_t first = s.history.lowerBound(level, start);
+            if (s.history.size(level) - first <= width * 4) break;
+        }
+        if (chosen == 0) continue;
+        
+        view.level = chosen;
+        view.first = s.history.lowerBound(chosen, start);
+        view.count = s.history.size(chosen) - view.first;
+        bool hasMin = false, hasMax = false;
+        for (size_t i = 0; i < view.count; i++) {
+            const ChartBucket& b = s.history.at(chosen, view.first + i);
+            if (b.tStart > m_frameRefNs) {
+                view.count = i;
+                break;
+            }
+            // Kubełek z NaN / ±inf nie rozciąga skali do nieskończoności
+            if (std::isfinite(b.min) && (!hasMin || b.min < view.minValue)) view.minValue = b.min;
+            if (std::isfinite(b.max) && (!hasMax || b.max > view.maxValue)) view.maxValue = b.max;
+            hasMin = hasMin || std::isfinite(b.min);
+            hasMax = hasMax || std::isfinite(b.max);
+        }
+    }
+}
+
+// ============================================================================
+// Warstwa statyczna: tło, siatka, osie, tytuł
+// ============================================================================
+bool ChartPlot::staticLayerValid() const {
+    if (m_staticDirty) return false;
+    if (m_frameWidth != m_staticWidth || m_frameHeight != m_staticHeight) return false;
+    if (m_displayMode != m_staticMode) return false;
+    if (m_displayMode == CHART_MODE_SPECTRUM) {
+        return m_frameMinHz == m_staticMinHz && m_frameMaxHz == m_staticMaxHz;
+    }
+    bool secondary = hasSecondaryAxis();
+    if (secondary != m_staticSecondary) return false;
+    for (int axis = 0; axis < (secondary ? 2 : 1); axis++) {
+        if (m_axes[axis].viewMin != m_staticMin[axis] || m_axes[axis].viewMax != m_staticMax[axis]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void ChartPlot::drawStatic(ChartCanvas& canvas) {
+    ChartRect rect = { 0, 0, m_frameWidth, m_frameHeight };
+    ChartRect plot = plotArea(m_frameWidth, m_frameHeight);
+    
+    // Wypełnij tło
+    canvas.fillRect(rect, m_bgColor);
+    
+    if (m_displayMode == CHART_MODE_SPECTRUM) {
+        drawSpectrumAxes(canvas, rect, plot);
+    } else {
+        drawGrid(canvas, plot);
+        drawAxes(canvas, rect, plot);
+    }
+    
+    // Rysuj tytuł
+    ChartRect titleRect = rect;
+    titleRect.bottom = 20;
+    canvas.text(titleRect, m_title, chartRgb(255, 255, 255), CHART_FONT_TITLE,
+                CHART_TEXT_CENTER | CHART_TEXT_VCENTER);
+    
+    m_staticSecondary = hasSecondaryAxis();
+    for (int axis = 0; axis < 2; axis++) {
+        m_staticMin[axis] = m_axes[axis].viewMin;
+        m_staticMax[axis] = m_axes[axis].viewMax;
+    }
+    m_staticWidth = m_frameWidth;
+    m_staticHeight = m_frameHeight;
+    m_staticMode = m_displayMode;
+    m_staticMinHz = m_frameMinHz;
+    m_staticMaxHz = m_frameMaxHz;
+    m_staticDirty = false;
+    m_staticSerial++;
+}
+
+void ChartPlot::drawGrid(ChartCanvas& canvas, const ChartRect& plot) {
+    // Rysuj poziome linie siatki
+    const int horizontalLines = 4;
+    int stepY = (plot.bottom - plot.top) / horizontalLines;
+    
+    for (int i = 1; i <= horizontalLines; i++) {
+        int y = plot.bottom - i * stepY;
+        canvas.line(plot.left, y, plot.right, y, m_gridColor, 1, true);
+    }
+    
+    // Rysuj pionowe linie siatki
+    const int verticalLines = 6;
+    int stepX = (plot.right - plot.left) / verticalLines;
+    
+    for (int i = 1; i <= verticalLines; i++) {
+        int x = plot.left + i * stepX;
+        canvas.line(x, plot.top, x, plot.bottom, m_gridColor, 1, true);
+    }
+}
+
+void ChartPlot::drawAxes(ChartCanvas& canvas, const ChartRect& rect, const ChartRect& plot) {
+    bool secondary = hasSecondaryAxis();
+    
+    // Oś Y
+    canvas.line(plot.left, plot.top, plot.left, plot.bottom, m_axisColor, 2, false);
+    
+    // Druga oś Y (prawa)
+    if (secondary) {
+        canvas.line(plot.right, plot.top, plot.right, plot.bottom, m_axisColor, 2, false);
+    }
+    
+    // Oś X
+    canvas.line(plot.left, plot.bottom, plot.right, plot.bottom, m_axisColor, 2, false);
+    
+    const int horizontalLines = 4;
+    int stepY = (plot.bottom - plot.top) / horizontalLines;
+    
+    // Etykiety osi Y (lewa, opcjonalnie prawa)
+    for (int axis = 0; axis < (secondary ? 2 : 1); axis++) {
+        double minY = m_axes[axis].viewMin;
+        double maxY = m_axes[axis].viewMax;
+        
+        for (int i = 0; i <= horizontalLines; i++) {
+            int y = plot.bottom - i * stepY;
+            double value = minY + (maxY - minY) * i / horizontalLines;
+            std::wstring label = formatLabel("%.2f", value);
+            
+            if (axis == 0) {
+                ChartRect labelRect = {rect.left, y - 8, plot.left - 2, y + 8};
+                canvas.text(labelRect, label, m_axisColor, CHART_FONT_LABEL, CHART_TEXT_RIGHT | CHART_TEXT_VCENTER);
+            } else {
+                ChartRect labelRect = {plot.right + 4, y - 8, rect.right, y + 8};
+                canvas.text(labelRect, label, m_axisColor, CHART_FONT_LABEL, CHART_TEXT_LEFT | CHART_TEXT_VCENTER);
+            }
+        }
+    }
+    
+    // Etykiety osi X (czas w sekundach; w poświacie czas od początku przebiegu)
+    const int verticalLines = 6;
+    int stepX = (plot.right - plot.left) / verticalLines;
+    bool sweep = m_displayMode == CHART_MODE_PERSISTENCE;
+    
+    for (int i = 0; i <= verticalLines; i++) {
+        int x = plot.left + i * stepX;
+        double timeSec = m_timeWindowSec * (sweep ? (double)i / verticalLines : 1.0 - (double)i / verticalLines);
+        
+        // Formatowanie etykiety czasu
+        std::wstring label;
+        if (timeSec < m_timeWindowSec * 1e-3)
+            label = L"0";
+        else if (m_timeWindowSec < 0.01)
+            label = formatLabel(sweep ? "%.1fms" : "-%.1fms", timeSec * 1000.0);
+        else if (m_timeWindowSec < 0.1)
+            label = formatLabel(sweep ? "%.0fms" : "-%.0fms", timeSec * 1000.0);
+        else if (m_timeWindowSec <= 5.0)
+            label = formatLabel(sweep ? "%.2fs" : "-%.2fs", timeSec);
+        else
+            label = formatLabel(sweep ? "%.0fs" : "-%.0fs", std::floor(timeSec));
+        
+        ChartRect labelRect = {x - 20, plot.bottom, x + 20, rect.bottom};
+        canvas.text(labelRect, label, m_axisColor, CHART_FONT_LABEL, CHART_TEXT_CENTER | CHART_TEXT_TOP);
+    }
+    
+    // Jednostki miary — pierwsza widoczna seria danej osi
+    const std::wstring* units[2] = { nullptr, nullptr };
+    for (const Series& s : m_series) {
+        int axis = s.secondaryAxis ? 1 : 0;
+        if (s.visible && !units[axis] && !s.unit.empty()) units[axis] = &s.unit;
+    }
+    if (units[0]) {
+        ChartRect unitRect = {rect.left, rect.top, plot.left, plot.top};
+        canvas.text(unitRect, *units[0], m_axisColor, CHART_FONT_LABEL, CHART_TEXT_LEFT | CHART_TEXT_TOP);
+    }
+    if (units[1] && secondary) {
+        ChartRect unitRect = {plot.right, rect.top, rect.right, plot.top};
+        canvas.text(unitRect, *units[1], m_axisColor, CHART_FONT_LABEL, CHART_TEXT_RIGHT | CHART_TEXT_TOP);
+    }
+    
+    // Legenda (tylko gdy jest więcej niż jedna seria)
+    if (m_series.size() > 1) {
+        int ly = plot.top + 2;
+        for (const Series& s : m_series) {
+            if (!s.visible || s.name.empty()) continue;
+            ChartRect legendRect = {plot.left + 6, ly, plot.right - 6, ly + 14};
+            canvas.text(legendRect, s.name, s.color, CHART_FONT_LABEL, CHART_TEXT_LEFT | CHART_TEXT_TOP);
+            ly += 14;
+        }
+    }
+}
+
+// ============================================================================
+// Dane
+// ============================================================================
+void ChartPlot::drawData(ChartCanvas& canvas) {
+    ChartRect plot = plotArea(m_frameWidth, m_frameHeight);
+    if (m_displayMode == CHART_MODE_SPECTRUM) {
+        drawSpectrum(canvas, plot);
+        return;
+    }
+    if (m_displayMode == CHART_MODE_PERSISTENCE) {
+        drawPersistence(canvas, plot);
+        return;
+    }
+    
+    if (!m_hasData) {
+        return;
+    }
+    
+    drawSeries(canvas, plot, m_frameRefNs - static_cast<int64_t>(m_timeWindowSec * 1e9));
+}
+
+void ChartPlot::drawSeries(ChartCanvas& canvas, const ChartRect& plot, int64_t fromNs) {
+    int64_t windowNs = static_cast<int64_t>(m_timeWindowSec * 1e9);
+    
+    // Jedno przejście: wszystkie widoczne serie na wspólnej osi czasu
+    for (size_t index = 0; index < m_series.size(); index++) {
+        const Series& s = m_series[index];
+        if (!s.visible || index >= m_views.size()) continue;
+        const SeriesView& view = m_views[index];
+        if (view.count == 0) continue;
+        const Axis& axis = m_axes[s.secondaryAxis ? 1 : 0];
+        
+        // Tylko próbki od fromNs (+ jedna wcześniejsza — odcinek wchodzący w pas)
+        size_t first = view.first;
+        size_t count = view.count;
+        if (fromNs > m_frameRefNs - windowNs) {
+            size_t from = view.level > 0 ? s.history.lowerBound(view.level, fromNs) : s.data.lowerBound(fromNs);
+            if (from > first) from--;
+            if (from > first + count) from = first + count;
+            count -= from - first;
+            first = from;
+            if (count == 0) continue;
+        }
+        
+        // Redukcja próbek do obwiedni min/max na kolumnę pikseli (lub LTTB)
+        ChartViewport vp;
+        vp.refTimeNs = m_frameRefNs;
+        vp.windowNs  = windowNs;
+        vp.left      = plot.left;
+        vp.width     = plot.right - plot.left;
+        vp.bottom    = plot.bottom;
+        vp.height    = plot.bottom - plot.top;
+        vp.minY      = axis.viewMin;
+        vp.maxY      = axis.viewMax;
+        if (view.level > 0) {
+            m_decimator.buildBuckets(s.history, view.level, first, count, vp);
+        } else {
+            m_decimator.build(s.data, first, count, vp);
+        }
+        
+        const std::vector<ChartPoint>& pts = m_decimator.points();
+        const std::vector<uint32_t>& runs = m_decimator.runs();
+        
+        // Jedno wywołanie dla całej linii (przerwanej na granicach segmentów)
+        if (!runs.empty()) {
+            canvas.polyPolyline(pts.data(), runs.data(), runs.size(), s.color, m_lineWidth);
+        }
+        
+        // Pomijaj kropki dla gęstych danych
+        if (view.level == 0 && s.data.size() <= 200) {
+            canvas.dots(pts.data(), pts.size(), 3, s.color);
+        }
+    }
+}
+
+// ============================================================================
+// Przewijanie — warstwa danych przesuwana o całe piksele
+// ============================================================================
+bool ChartPlot::scrollingActive() const {
+    return m_scrolling && m_displayMode == CHART_MODE_TIME && !m_triggerEnabled;
+}
+
+void ChartPlot::alignScroll(const ChartRect& plot) {
+    // Prawy brzeg osi czasu = brzeg poprzedniej klatki + całkowita liczba pikseli,
+    // żeby przesunięta warstwa i nowe kolumny trafiały w tę samą siatkę pikseli
+    int width = plot.right - plot.left;
+    int64_t windowNs = static_cast<int64_t>(m_timeWindowSec * 1e9);
+    if (!m_layerValid || width <= 0 || windowNs != m_layerWindowNs || m_frameRefNs < m_layerRefNs) return;
+    if (plot.right - plot.left != m_layerPlot.right - m_layerPlot.left) return;
+    
+    double nsPerPixel = (double)windowNs / width;
+    int64_t shift = (int64_t)((double)(m_frameRefNs - m_layerRefNs) / nsPerPixel);
+    if (shift >= width) return;
+    m_frameRefNs = m_layerRefNs + (int64_t)std::llround(shift * nsPerPixel);
+}
+
+int ChartPlot::drawDataLayer(ChartCanvas& layer, ChartColor key) {
+    ChartRect rect = { 0, 0, m_frameWidth, m_frameHeight };
+    ChartRect plot = plotArea(m_frameWidth, m_frameHeight);
+    int width = plot.right - plot.left;
+    int64_t windowNs = static_cast<int64_t>(m_timeWindowSec * 1e9);
+    if (width <= 0 || windowNs <= 0) return 0;
+    
+    // Kropki znikają, gdy serii przybywa próbek — przesunięta warstwa by je zachowała
+    bool dots = false;
+    for (size_t index = 0; index < m_series.size() && index < m_views.size(); index++) {
+        const Series& s = m_series[index];
+        if (s.visible && m_views[index].count > 0 && m_views[index].level == 0 && s.data.size() <= 200) dots = true;
+    }
+    
+    bool full = !m_layerValid || m_layerStaticSerial != m_staticSerial || windowNs != m_layerWindowNs ||
+                m_frameRefNs < m_layerRefNs || std::memcmp(&plot, &m_layerPlot, sizeof(plot)) != 0 ||
+                dots || dots != m_layerDots;
+    int shift = 0;
+    if (!full) {
+        shift = (int)std::llround((double)(m_frameRefNs - m_layerRefNs) * width / (double)windowNs);
+        if (shift >= width) full = true;
+    }
+    
+    m_layerValid = true;
+    m_layerRefNs = m_frameRefNs;
+    m_layerWindowNs = windowNs;
+    m_layerPlot = plot;
+    m_layerStaticSerial = m_staticSerial;
+    m_layerDots = dots;
+    
+    if (full) {
+        layer.fillRect(rect, key);
+        if (m_hasData) drawSeries(layer, plot, m_frameRefNs - windowNs);
+        return m_frameWidth;
+    }
+    
+    // Przesuń o upływ czasu; lewy margines (etykiety osi) nie ma danych
+    layer.scroll(rect, -shift, key);
+    ChartRect margin = { 0, 0, plot.left, m_frameHeight };
+    layer.fillRect(margin, key);
+    
+    // Nowe kolumny + ostatnie kolumny poprzedniej klatki (niepełna kolumna
+    // min/max, grubość linii, kropki) — od x0 w prawo wszystko od nowa
+    int reach = std::max(m_lineWidth, 3) + 2;
+    int x0 = std::max(plot.left, plot.right - shift - reach);
+    ChartRect strip = { x0, 0, m_frameWidth, m_frameHeight };
+    layer.fillRect(strip, key);
+    int64_t fromNs = m_frameRefNs - (int64_t)((double)(plot.right - x0 + reach) * windowNs / width);
+    if (m_hasData) drawSeries(layer, plot, fromNs);
+    return m_frameWidth - x0;
+}
+
+// ============================================================================
+// Kursory pomiarowe
+// ============================================================================
+void ChartPlot::setTimeCursors(bool enabled, double t1Sec, double t2Sec) {
+    m_timeCursors = enabled;
+    m_cursorT[0] = t1Sec;
+    m_cursorT[1] = t2Sec;
+}
+
+void ChartPlot::setValueCursors(bool enabled, double v1, double v2) {
+    m_valueCursors = enabled;
+    m_cursorV[0] = v1;
+    m_cursorV[1] = v2;
+}
+
+void ChartPlot::measure() {
+    ChartMeasurement& m = m_measurement;
+    m = ChartMeasurement();
+    m.valueCursors = m_valueCursors;
+    m.v1 = m_cursorV[0];
+    m.v2 = m_cursorV[1];
+    m.dv = m.v2 - m.v1;
+    
+    m.timeCursors = m_timeCursors;
+    if (!m_timeCursors) return;
+    m.t1 = m_cursorT[0];
+    m.t2 = m_cursorT[1];
+    m.dt = m.t2 - m.t1;
+    m.frequency = m.dt != 0.0 ? 1.0 / std::fabs(m.dt) : 0.0;
+    
+    if (m_cursorSeries < 0 || m_cursorSeries >= (int)m_series.size()) return;
+    const Series& s = m_series[m_cursorSeries];
+    int64_t leftNs = m_frameRefNs - static_cast<int64_t>(m_timeWindowSec * 1e9);
+    int64_t t1Ns = leftNs + static_cast<int64_t>(m.t1 * 1e9);
+    int64_t t2Ns = leftNs + static_cast<int64_t>(m.t2 * 1e9);
+    
+    m.hasSamples = nearestValue(s, t1Ns, m.value1) && nearestValue(s, t2Ns, m.value2);
+    rangeStats(s, t1Ns < t2Ns ? t1Ns : t2Ns, t1Ns < t2Ns ? t2Ns : t1Ns, m.stats, m.exact);
+}
+
+bool ChartPlot::nearestValue(const Series& series, int64_t timeNs, double& value) const {
+    const ChartBuffer& data = series.data;
+    
+    // Surowe próbki, gdy sięgają kursora — wyszukiwanie binarne, potem bliższa z dwóch sąsiednich
+    if (!data.empty() && (timeNs >= data.oldestTime() || !series.history.enabled())) {
+        size_t i = data.lowerBound(timeNs);
+        if (i == data.size()) {
+            i--;
+        } else if (i > 0 && timeNs - data.timeAt(i - 1) < data.timeAt(i) - timeNs) {
+            i--;
+        }
+        value = data.valueAt(i);
+        return true;
+    }
+    
+    // Starsze dane: średnia kubełka najdrobniejszej warstwy, która sięga kursora
+    // (lub pierwszej próbki, jeśli kursor jest przed początkiem danych)
+    for (int level = 1; series.history.enabled() && level <= ChartHistory::MAX_LEVELS; level++) {
+        if (series.history.oldestTime(level) > timeNs && series.history.truncated(level) &&
+            level < ChartHistory::MAX_LEVELS) continue;
+        size_t i = series.history.lowerBound(level, timeNs);
+        if (i >= series.history.size(level)) return false;
+        const ChartBucket& b = series.history.at(level, i);
+        value = b.sum / b.count;
+        return true;
+    }
+    return false;
+}
+
+void ChartPlot::rangeStats(const Series& series, int64_t fromNs, int64_t toNs, ChartStats& stats, bool& exact) const {
+    const ChartBuffer& data = series.data;
+    exact = true;
+    
+    if (!data.empty() && (fromNs >= data.oldestTime() || !series.history.enabled())) {
+        size_t first = data.lowerBound(fromNs);
+        size_t end = data.lowerBound(toNs + 1);
+        if (end > first) stats = series.stats.query(data, first, end - first);
+        return;
+    }
+    if (!series.history.enabled()) return;
+    
+    // Zakres sięga poza surowe próbki — najdrobniejsza warstwa pokrywająca
+    // początek, o ile mieści go w kilku tysiącach kubełków
+    const size_t maxBuckets = 4096;
+    exact = false;
+    for (int level = 1; level <= ChartHistory::MAX_LEVELS; level++) {
+        if (series.history.oldestTime(level) > fromNs && series.history.truncated(level) &&
+            level < ChartHistory::MAX_LEVELS) continue;
+        size_t first = series.history.lowerBound(level, fromNs);
+        size_t end = series.history.lowerBound(level, toNs);
+        if (end < series.history.size(level) && series.history.at(level, end).tStart <= toNs) end++;
+        if (end - first > maxBuckets && level < ChartHistory::MAX_LEVELS) continue;
+        
+        for (size_t i = first; i < end; i++) {
+            const ChartBucket& b = series.history.at(level, i);
+            // Kubełek z NaN / ±inf — pominięty jak pojedyncza próbka w ChartStats::add()
+            if (!std::isfinite(b.min) || !std::isfinite(b.max) || !std::isfinite(b.sumSq)) continue;
+            ChartStats bucket;
+            bucket.count = b.count;
+            bucket.min = b.min;
+            bucket.max = b.max;
+            bucket.sum = b.sum;
+            bucket.sumSq = b.sumSq;
+            stats.merge(bucket);
+        }
+        return;
+    }
+}
+
+ChartCursor ChartPlot::cursorAt(int x, int y) const {
+    if (m_displayMode != CHART_MODE_TIME) return CHART_CURSOR_NONE;
+    ChartRect plot = plotArea(m_frameWidth, m_frameHeight);
+    int width = plot.right - plot.left;
+    int height = plot.bottom - plot.top;
+    const Axis& axis = m_axes[0];
+    const int tolerance = 4;
+    
+    if (m_timeCursors && width > 0 && y >= plot.top && y <= plot.bottom) {
+        for (int i = 0; i < 2; i++) {
+            int cx = plot.left + (int)(m_cursorT[i] / m_timeWindowSec * width);
+            if (std::abs(x - cx) <= tolerance) return (ChartCursor)(CHART_CURSOR_T1 + i);
+        }
+    }
+    if (m_valueCursors && height > 0 && axis.viewMax > axis.viewMin && x >= plot.left && x <= plot.right) {
+        for (int i = 0; i < 2; i++) {
+            int cy = plot.bottom - (int)((m_cursorV[i] - axis.viewMin) / (axis.viewMax - axis.viewMin) * height);
+            if (std::abs(y - cy) <= tolerance) return (ChartCursor)(CHART_CURSOR_V1 + i);
+        }
+    }
+    return CHART_CURSOR_NONE;
+}
+
+void ChartPlot::moveCursor(ChartCursor cursor, int x, int y) {
+    ChartRect plot = plotArea(m_frameWidth, m_frameHeight);
+    int width = plot.right - plot.left;
+    int height = plot.bottom - plot.top;
+    const Axis& axis = m_axes[0];
+    
+    if ((cursor == CHART_CURSOR_T1 || cursor == CHART_CURSOR_T2) && width > 0) {
+        double t = (double)(x - plot.left) / width * m_timeWindowSec;
+        m_cursorT[cursor - CHART_CURSOR_T1] = std::max(0.0, std::min(m_timeWindowSec, t));
+    } else if ((cursor == CHART_CURSOR_V1 || cursor == CHART_CURSOR_V2) && height > 0) {
+        double pos = (double)(plot.bottom - y) / height;
+        pos = std::max(0.0, std::min(1.0, pos));
+        m_cursorV[cursor - CHART_CURSOR_V1] = axis.viewMin + pos * (axis.viewMax - axis.viewMin);
+    }
+}
+
+void ChartPlot::drawOverlay(ChartCanvas& canvas) {
+    if (m_displayMode != CHART_MODE_TIME || (!m_timeCursors && !m_valueCursors)) return;
+    ChartRect plot = plotArea(m_frameWidth, m_frameHeight);
+    int width = plot.right - plot.left;
+    int height = plot.bottom - plot.top;
+    if (width <= 0 || height <= 0) return;
+    const Axis& axis = m_axes[0];
+    const ChartMeasurement& m = m_measurement;
+    
+    static const wchar_t* const timeNames[] = { L"T1", L"T2" };
+    static const wchar_t* const valueNames[] = { L"V1", L"V2" };
+    for (int i = 0; m_timeCursors && i < 2; i++) {
+        if (!(m_cursorT[i] >= 0.0 && m_cursorT[i] <= m_timeWindowSec)) continue;
+        int x = plot.left + (int)(m_cursorT[i] / m_timeWindowSec * width);
+        canvas.line(x, plot.top, x, plot.bottom, m_cursorColor, 1, true);
+        ChartRect labelRect = { x + 3, plot.top + 2, x + 40, plot.top + 16 };
+        canvas.text(labelRect, timeNames[i], m_cursorColor, CHART_FONT_LABEL, CHART_TEXT_LEFT | CHART_TEXT_TOP);
+    }
+    for (int i = 0; m_valueCursors && i < 2 && axis.viewMax > axis.viewMin; i++) {
+        double pos = (m_cursorV[i] - axis.viewMin) / (axis.viewMax - axis.viewMin);
+        if (!(pos >= 0.0 && pos <= 1.0)) continue;     // NaN przy nieskończonym zakresie
+        int y = plot.bottom - (int)(pos * height);
+        canvas.line(plot.left, y, plot.right, y, m_cursorColor, 1, true);
+        ChartRect labelRect = { plot.right - 40, y - 15, plot.right - 3, y - 1 };
+        canvas.text(labelRect, valueNames[i], m_cursorColor, CHART_FONT_LABEL, CHART_TEXT_RIGHT | CHART_TEXT_TOP);
+    }
+    
+    // Odczyty w prawym górnym rogu obszaru wykresu
+    const std::wstring& unit = m_cursorSeries >= 0 && m_cursorSeries < (int)m_series.size()
+                               ? m_series[m_cursorSeries].unit : m_series[0].unit;
+    std::vector<std::wstring> lines;
+    if (m.timeCursors) {
+        std::wstring line = L"dt = " + formatEng(m.dt, L"s");
+        if (m.frequency > 0.0) line += L"   1/dt = " + formatEng(m.frequency, L"Hz");
+        lines.push_back(line);
+        if (m.hasSamples) {
+            lines.push_back(L"T1: " + formatEng(m.value1, unit) + L"   T2: " + formatEng(m.value2, unit));
+        }
+        if (m.stats.count > 0) {
+            std::wstring approx = m.exact ? L"" : L"~";
+            lines.push_back(approx + L"min " + formatEng(m.stats.min, unit) + L"   max " + formatEng(m.stats.max, unit));
+            lines.push_back(approx + L"mean " + formatEng(m.stats.mean(), unit) + L"   rms " + formatEng(m.stats.rms(), unit));
+        }
+    }
+    if (m.valueCursors) lines.push_back(L"dV = " + formatEng(m.dv, unit));
+    
+    // Tło pod tekstem (szerokość z liczby znaków — płótno nie mierzy tekstu)
+    size_t longest = 0;
+    for (const std::wstring& line : lines) longest = std::max(longest, line.size());
+    if (!lines.empty()) {
+        int boxLeft = std::max(plot.left + 1, plot.right - 10 - (int)longest * 7);
+        ChartRect box = { boxLeft, plot.top + 2, plot.right - 1, plot.top + 6 + 14 * (int)lines.size() };
+        canvas.fillRect(box, m_bgColor);
+    }
+    
+    int ly = plot.top + 4;
+    for (const std::wstring& line : lines) {
+        ChartRect lineRect = { plot.left + 6, ly, plot.right - 6, ly + 14 };
+        canvas.text(lineRect, line, m_cursorColor, CHART_FONT_LABEL, CHART_TEXT_RIGHT | CHART_TEXT_TOP);
+        ly += 14;
+    }
+}
+
+// ============================================================================
+// Widmo: siatka dB / Hz i krzywe
+// ============================================================================
+void ChartPlot::drawSpectrumAxes(ChartCanvas& canvas, const ChartRect& rect, const ChartRect& plot) {
+    ChartSpectrumViewport vp = spectrumViewport(plot);
+    
+    // Poziomo: dB, 4 podziały jak w trybie czasu
+    const int horizontalLines = 4;
+    int stepY = (plot.bottom - plot.top) / horizontalLines;
+    for (int i = 0; i <= horizontalLines; i++) {
+        int y = plot.bottom - i * stepY;
+        if (i > 0) canvas.line(plot.left, y, plot.right, y, m_gridColor, 1, true);
+        double db = vp.minDb + (vp.maxDb - vp.minDb) * i / horizontalLines;
+        ChartRect labelRect = {rect.left, y - 8, plot.left - 2, y + 8};
+        canvas.text(labelRect, formatLabel("%.0f", db), m_axisColor, CHART_FONT_LABEL,
+                    CHART_TEXT_RIGHT | CHART_TEXT_VCENTER);
+    }
+    
+    // Pionowo: Hz — dekady 1-2-5 (log) lub 6 podziałów (lin)
+    auto xOf = [&](double hz) {
+        double pos = vp.logFrequency ? std::log10(hz / vp.minHz) / std::log10(vp.maxHz / vp.minHz)
+                                     : (hz - vp.minHz) / (vp.maxHz - vp.minHz);
+        return plot.left + (int)(pos * vp.width);
+    };
+    auto tick = [&](double hz, bool label) {
+        int x = xOf(hz);
+        if (x > plot.left && x < plot.right) canvas.line(x, plot.top, x, plot.bottom, m_gridColor, 1, true);
+        if (!label) return;
+        ChartRect labelRect = {x - 20, plot.bottom, x + 20, rect.bottom};
+        canvas.text(labelRect, formatFrequency(hz), m_axisColor, CHART_FONT_LABEL, CHART_TEXT_CENTER | CHART_TEXT_TOP);
+    };
+    
+    if (vp.logFrequency) {
+        static const double steps[] = { 1.0, 2.0, 5.0 };
+        // Przy wąskim zakresie etykiety 1-2-5, przy szerokim tylko dekady
+        bool fine = std::log10(vp.maxHz / vp.minHz) <= 3.5;
+        for (double decade = std::pow(10.0, std::floor(std::log10(vp.minHz))); decade <= vp.maxHz; decade *= 10.0) {
+            for (double step : steps) {
+                double hz = decade * step;
+                if (hz < vp.minHz || hz > vp.maxHz) continue;
+                tick(hz, step == 1.0 || fine);
+            }
+        }
+    } else {
+        const int verticalLines = 6;
+        for (int i = 0; i <= verticalLines; i++) {
+            tick(vp.minHz + (vp.maxHz - vp.minHz) * i / verticalLines, true);
+        }
+    }
+    
+    // Osie
+    canvas.line(plot.left, plot.top, plot.left, plot.bottom, m_axisColor, 2, false);
+    canvas.line(plot.left, plot.bottom, plot.right, plot.bottom, m_axisColor, 2, false);
+    
+    ChartRect unitRect = {rect.left, rect.top, plot.left, plot.top};
+    canvas.text(unitRect, L"dB", m_axisColor, CHART_FONT_LABEL, CHART_TEXT_LEFT | CHART_TEXT_TOP);
+    ChartRect hzRect = {plot.right - 40, plot.top + 2, plot.right - 4, plot.top + 16};
+    canvas.text(hzRect, L"Hz", m_axisColor, CHART_FONT_LABEL, CHART_TEXT_RIGHT | CHART_TEXT_TOP);
+}
+
+void ChartPlot::drawSpectrum(ChartCanvas& canvas, const ChartRect& plot) {
+    if (m_spectrum.empty() || !m_series[0].visible) return;
+    ChartSpectrumViewport vp = spectrumViewport(plot);
+    ChartColor color = m_series[0].color;
+    
+    // Szczyty przygaszone, pod krzywą średnią
+    if (m_spectrum.peakHold()) {
+        m_spectrum.buildPolyline(vp, true, m_spectrumPoints);
+        if (m_spectrumPoints.size() >= 2) {
+            ChartColor dim = chartRgb(chartRed(color) / 2, chartGreen(color) / 2, chartBlue(color) / 2);
+            uint32_t run = (uint32_t)m_spectrumPoints.size();
+            canvas.polyPolyline(m_spectrumPoints.data(), &run, 1, dim, 1);
+        }
+    }
+    
+    m_spectrum.buildPolyline(vp, false, m_spectrumPoints);
+    if (m_spectrumPoints.size() >= 2) {
+        uint32_t run = (uint32_t)m_spectrumPoints.size();
+        canvas.polyPolyline(m_spectrumPoints.data(), &run, 1, color, m_lineWidth);
+    }
+}
+
+// ============================================================================
+// Poświata
+// ============================================================================
+void ChartPlot::beginPersistenceFrame(const ChartRect& plot, bool sizeBuffer) {
+    m_frameRefNs = m_newestNs;
+    int width = plot.right - plot.left;
+    int height = plot.bottom - plot.top;
+    if (!sizeBuffer) {
+        width = m_persistence.width();
+        height = m_persistence.height();
+    }
+    m_persistence.configure(width, height, static_cast<int64_t>(m_timeWindowSec * 1e9));
+    
+    Axis& axis = m_axes[0];
+    if (axis.autoScale) {
+        m_persistence.setAutoRange();
+    } else {
+        m_persistence.setRange(axis.manualMin, axis.manualMax);
+    }
+    // Oś Y pokazuje zakres, w którym zbierane są trafienia
+    if (m_persistence.rangeValid()) {
+        axis.viewMin = m_persistence.rangeMin();
+        axis.viewMax = m_persistence.rangeMax();
+    } else {
+        axis.viewMin = axis.manualMin;
+        axis.viewMax = axis.manualMax;
+    }
+    axis.viewValid = true;
+}
+
+void ChartPlot::drawPersistence(ChartCanvas& canvas, const ChartRect& plot) {
+    if (!m_series[0].visible || !m_persistence.ready()) return;
+    m_persistence.render(m_frameRefNs, m_persistencePalette, m_series[0].color,
+                         plot.right - plot.left, plot.bottom - plot.top, m_persistenceImage);
+    canvas.image(plot, m_persistenceImage.data());
+}
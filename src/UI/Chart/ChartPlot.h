@@ -0,0 +1,371 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 JAQUBA (https://github.com/JAQUBA)
+// Part of JQB_WindowsLib — https://github.com/JAQUBA/JQB_WindowsLib
+
+/**
+ * ChartPlot.h — data model and frame geometry of Chart (no window, no GDI)
+ *
+ * Holds the series, retention, history tiers, trigger and Y scaling, and
+ * turns them into drawing primitives on a ChartCanvas. CHART_MODE_SPECTRUM
+ * draws the FFT amplitude spectrum of series 0 instead of the time trace,
+ * CHART_MODE_PERSISTENCE an intensity-graded (phosphor) image of it. Chart wraps it in a
+ * window with a GDI canvas; ChartRaster renders the same frame headless
+ * into a memory buffer (PNG/PPM export).
+ *
+ * Timestamps are int64 nanoseconds on any monotonic clock.
+ *
+ * Nie zależy od WinAPI.
+ */
+
+#ifndef CHART_PLOT_H
+#define CHART_PLOT_H
+
+#include "ChartCanvas.h"
+#include "ChartBuffer.h"
+#include "ChartDecimator.h"
+#include "ChartExtrema.h"
+#include "ChartHistory.h"
+#include "ChartPersistence.h"
+#include "ChartRangeStats.h"
+#include "ChartSpectrum.h"
+#include "ChartTrigger.h"
+#include <string>
+#include <vector>
+
+enum ChartDisplayMode {
+    CHART_MODE_TIME = 0,        // przebieg czasowy (domyślnie)
+    CHART_MODE_SPECTRUM,        // widmo amplitudowe serii 0 (dB / Hz)
+    CHART_MODE_PERSISTENCE      // poświata serii 0: gęstość trafień na piksel, bez przechowywania próbek
+};
+
+// Kursory pomiarowe: dwa czasu (pionowe) i dwa wartości (poziome)
+enum ChartCursor {
+    CHART_CURSOR_NONE = -1,
+    CHART_CURSOR_T1 = 0,
+    CHART_CURSOR_T2,
+    CHART_CURSOR_V1,
+    CHART_CURSOR_V2
+};
+
+// Odczyty kursorów — liczone raz na klatkę w beginFrame()
+struct ChartMeasurement {
+    bool   timeCursors = false;
+    double t1 = 0.0;            // [s] od lewej krawędzi okna
+    double t2 = 0.0;
+    double dt = 0.0;            // t2 - t1 [s]
+    double frequency = 0.0;     // 1 / |dt| [Hz], 0 gdy dt = 0
+    bool   hasSamples = false;  // value1 / value2 ważne
+    double value1 = 0.0;        // najbliższa próbka serii pod kursorem T1 / T2
+    double value2 = 0.0;
+    ChartStats stats;           // próbki między kursorami czasu
+    bool   exact = true;        // false = z kubełków historii (brzegi z dokładnością kubełka)
+
+    bool   valueCursors = false;
+    double v1 = 0.0;
+    double v2 = 0.0;
+    double dv = 0.0;            // v2 - v1
+};
+
+class ChartPlot {
+public:
+    ChartPlot();
+
+    // ---- Dane ----
+    void addPoint(int series, double value, int64_t timeNs);
+    // Paczka próbek rozłożona równo na totalDurationMs, kończąca się w nowTimeNs
+    // (wirtualna podstawa czasu — kolejne paczki są łączone bez jittera)
+    void addBatch(int series, const double* values, int count, double totalDurationMs, int64_t nowTimeNs);
+    void clear();
+
+    // ---- Serie ----
+    int  addSeries(const std::wstring& name, ChartColor color,
+                   const std::wstring& unit = L"", bool secondaryAxis = false);
+    void setSeriesVisible(int series, bool visible);
+    void setSeriesColor(int series, ChartColor color);
+    void setSeriesUnit(int series, const std::wstring& unit);
+    void setSeriesAxis(int series, bool secondaryAxis);
+    int  getSeriesCount() const { return (int)m_series.size(); }
+    bool isSeriesVisible(int series) const;
+    const std::wstring& getSeriesUnit(int series) const;
+
+    // ---- Ustawienia ----
+    void setTitle(const std::wstring& title) { m_title = title; m_staticDirty = true; }
+    void setTimeWindow(double seconds) { m_timeWindowSec = seconds; m_staticDirty = true; }
+    double getTimeWindow() const { return m_timeWindowSec; }
+    void setColors(ChartColor gridColor, ChartColor axisColor, ChartColor dataColor);
+    void setBackgroundColor(ChartColor color) { m_bgColor = color; m_staticDirty = true; }
+    void setAutoScale(int axis, bool autoScale);
+    void setYRange(int axis, double minY, double maxY);
+    void setAutoScaleHysteresis(double fraction) { m_scaleHysteresis = fraction; }
+    void setLineWidth(int width) { m_lineWidth = width; m_layerValid = false; }
+    void setDecimation(ChartDecimation mode) { m_decimator.setMode(mode); m_layerValid = false; }
+    ChartDecimation getDecimation() const    { return m_decimator.getMode(); }
+    void setHistoryTiers(double rawSeconds, size_t bucketsPerLevel);
+
+    // ---- Trigger (seria 0) ----
+    void setTriggerEnabled(bool enabled);
+    void setTriggerLevel(double level, ChartTriggerEdge edge, double hysteresis);
+    void setTriggerHoldoff(double seconds);
+    void setTriggerMode(ChartTriggerMode mode);
+    ChartTriggerMode getTriggerMode() const { return m_triggerMode; }
+    void armTrigger();
+    bool isTriggered() const { return m_triggerHeld; }
+
+    // ---- Widmo (CHART_MODE_SPECTRUM) ----
+    // W trybie widma addBatch() serii 0 liczy też FFT — jedno na paczkę,
+    // częstotliwość próbkowania = count / totalDurationMs.
+    void setDisplayMode(ChartDisplayMode mode);
+    ChartDisplayMode getDisplayMode() const { return m_displayMode; }
+    void configureSpectrum(size_t fftSize, FFTWindow window);
+    void setSpectrumAveraging(int frames) { m_spectrum.setAveraging(frames); }
+    void setSpectrumPeakHold(bool enabled) { m_spectrum.setPeakHold(enabled); }
+    void resetSpectrumPeaks() { m_spectrum.resetPeaks(); }
+    void setSpectrumLogFrequency(bool logFrequency) { m_spectrumLogFreq = logFrequency; m_staticDirty = true; }
+    void setSpectrumRange(double minDb, double maxDb);
+    // 0, 0 = automatycznie (pierwszy prążek .. Nyquist)
+    void setSpectrumFrequencyRange(double minHz, double maxHz);
+    void addSpectrumSamples(const double* samples, int count, double sampleRate);
+    // Gotowe widmo (amplitudy liniowe, prążek k = k * binHz)
+    void setSpectrum(const double* magnitudes, size_t bins, double binHz);
+    const ChartSpectrum& getSpectrum() const { return m_spectrum; }
+
+    // ---- Poświata (CHART_MODE_PERSISTENCE) ----
+    // Seria 0 nie jest wtedy zapisywana — każda próbka trafia od razu do
+    // bufora trafień (przebieg = okno czasowe, start od triggera gdy włączony).
+    // Bufor ma rozmiar obszaru wykresu z ostatniej klatki.
+    void setPersistenceDecay(double seconds) { m_persistence.setDecay(seconds); }
+    void setPersistencePalette(ChartPersistencePalette palette) { m_persistencePalette = palette; }
+    void clearPersistence() { m_persistence.clear(); }
+
+    // ---- Budżet pamięci ----
+    // Stała pojemność: bufory każdej serii (próbki, statystyki, warstwy
+    // historii) alokowane raz przy ustawieniu i nigdy nie rosną. Gdy surowe
+    // próbki przestają się mieścić, najstarsze są nadpisywane, a starsza część
+    // okna jest rysowana z warstw historii (retencja zdecymowana). Budżet
+    // dzielony równo między serie; 0 = bez limitu (domyślnie).
+    void setMemoryBudget(size_t maxBytes);
+    void setPointBudget(size_t maxPoints);
+    size_t getMemoryBudget() const { return m_budgetBytes; }
+    size_t getPointBudget() const { return m_budgetPoints; }
+    bool budgetActive() const { return m_budgetBytes > 0 || m_budgetPoints > 0; }
+
+    // ---- Statystyki pamięci ----
+    size_t getPointCount() const;
+    size_t getMemoryUsage() const;
+
+    // ---- Klatka ----
+    // beginFrame() liczy oś czasu, źródła próbek i skalę Y dla płótna w × h.
+    // Warstwa statyczna (tło, siatka, osie, tytuł) zmienia się tylko przy
+    // zmianie skali lub ustawień — staticLayerValid() pozwala ją buforować.
+    // Klatka okna nadaje rozmiar buforowi poświaty.
+    void beginFrame(int width, int height) { beginFrame(width, height, true); }
+    bool staticLayerValid() const;
+    void invalidateStatic() { m_staticDirty = true; }
+    void drawStatic(ChartCanvas& canvas);
+    void drawData(ChartCanvas& canvas);
+    // beginFrame + drawStatic + drawData. Eksport (inny rozmiar niż okno) nie
+    // zmienia bufora poświaty — obraz jest z niego skalowany.
+    void render(ChartCanvas& canvas);
+    // render() do obrazu obok okna (saveImage) — stan klatki okna (rozmiar,
+    // oś czasu, skala, trigger, pomiar kursorów) wraca po rysowaniu
+    void renderExport(ChartCanvas& canvas);
+
+    // ---- Przewijanie (strip chart) ----
+    // Warstwa danych (osobne płótno, tło = key) przesuwana o upływ czasu w
+    // pikselach — rysowane są tylko nowe kolumny. Pełne przerysowanie po
+    // zmianie skali, rozmiaru, ustawień lub warstwy statycznej. Oś czasu
+    // przesuwa się o całe piksele. Tylko tryb czasu bez triggera.
+    void setScrolling(bool enabled) { m_scrolling = enabled; m_layerValid = false; }
+    bool isScrolling() const { return m_scrolling; }
+    bool scrollingActive() const;
+    void invalidateLayer() { m_layerValid = false; }
+    // Zamiast drawData() — zwraca liczbę przerysowanych kolumn
+    int drawDataLayer(ChartCanvas& layer, ChartColor key);
+
+    // ---- Kursory pomiarowe (tryb czasu) ----
+    // Kursory czasu w sekundach od lewej krawędzi okna (0 .. getTimeWindow()),
+    // kursory wartości w jednostkach lewej osi Y. Najbliższa próbka —
+    // wyszukiwanie binarne po czasie; min/max/średnia/RMS między kursorami —
+    // bloki ChartRangeStats lub kubełki historii, bez skanowania próbek.
+    void setTimeCursors(bool enabled, double t1Sec, double t2Sec);
+    void setValueCursors(bool enabled, double v1, double v2);
+    void setCursorSeries(int series) { m_cursorSeries = series; }
+    const ChartMeasurement& getMeasurement() const { return m_measurement; }
+    // Kursor pod pikselem (±4 px) i przesunięcie kursora do piksela (przeciąganie myszą)
+    ChartCursor cursorAt(int x, int y) const;
+    void moveCursor(ChartCursor cursor, int x, int y);
+    // Linie kursorów i odczyty — na wierzchu klatki, po drawData() / drawDataLayer()
+    void drawOverlay(ChartCanvas& canvas);
+
+    ChartRect plotArea(int width, int height) const;
+
+private:
+    // Seria: próbki w buforze kolumnowym (czas ns, wartość, znacznik segmentu)
+    struct Series {
+        ChartBuffer data;
+        ChartExtrema extrema;           // MIN/MAX okna aktualizowane przy dodawaniu/usuwaniu
+        ChartRangeStats stats;          // Bloki min/max/sum/sum² — statystyki kursorów
+        ChartHistory history;           // Warstwy kubełków (gdy setHistoryTiers)
+        std::wstring name;
+        std::wstring unit;              // Jednostka — jedna dla całej serii
+        ChartColor color = 0x0000FF00;  // RGB(0, 255, 0)
+        bool visible = true;
+        bool secondaryAxis = false;
+
+        // Tracking batch continuity
+        int64_t lastBatchEndNs = 0;
+        bool hasBatchHistory = false;
+    };
+
+    // Oś Y: 0 = lewa (główna), 1 = prawa (dodatkowa)
+    struct Axis {
+        bool autoScale = true;
+        double manualMin = 0.0;
+        double manualMax = 10.0;
+        // Zakres wyliczany raz na klatkę (updateScale)
+        double viewMin = 0.0;
+        double viewMax = 10.0;
+        bool viewValid = false;
+    };
+
+    // Źródło próbek serii wybrane na bieżącą klatkę (0 = surowe, 1.. = warstwa historii)
+    struct SeriesView {
+        int level = 0;
+        size_t first = 0;
+        size_t count = 0;
+        double minValue = 0.0;          // Zakres kubełków w oknie (tylko level > 0)
+        double maxValue = 0.0;
+    };
+
+    std::vector<Series> m_series;
+    std::vector<SeriesView> m_views;
+    Axis m_axes[2];
+    int64_t m_newestNs = 0;             // Najnowsza próbka ze wszystkich serii — wspólna oś czasu
+    bool m_hasData = false;
+    ChartDecimator m_decimator;
+    double m_timeWindowSec = 30.0; // Domyślnie pokazuje 30 sekund
+    double m_historyRawSec = 0.0;       // 0 = warstwy historii wyłączone
+    size_t m_historyBuckets = 0;
+    size_t m_budgetBytes = 0;           // 0 = bez limitu
+    size_t m_budgetPoints = 0;
+    std::wstring m_title;
+
+    ChartColor m_gridColor = 0x00505050;    // RGB(80, 80, 80)
+    ChartColor m_axisColor = 0x00C8C8C8;    // RGB(200, 200, 200)
+    ChartColor m_bgColor = 0x00000000;
+    double m_scaleHysteresis = 0.0;
+    int m_lineWidth = 2;
+
+    // Wynik beginFrame() — zachowywany na czas eksportu (renderExport)
+    struct FrameState {
+        int width;
+        int height;
+        int64_t refNs;
+        std::vector<SeriesView> views;
+        Axis axes[2];
+        bool triggerHeld;
+        int64_t heldRefNs;
+        bool singleArmed;
+        double minHz;
+        double maxHz;
+        ChartMeasurement measurement;
+    };
+
+    // Bieżąca klatka
+    int m_frameWidth = 0;
+    int m_frameHeight = 0;
+    int64_t m_frameRefNs = 0;           // Prawy brzeg osi czasu bieżącej klatki
+
+    // Klucz warstwy statycznej — przerysowanie tylko gdy skala się zmieni
+    bool m_staticDirty = true;
+    double m_staticMin[2] = { 0.0, 0.0 };
+    double m_staticMax[2] = { 0.0, 0.0 };
+    bool m_staticSecondary = false;
+    int m_staticWidth = 0;
+    int m_staticHeight = 0;
+
+    // Trigger mode (oscilloscope-style sync)
+    bool m_triggerEnabled = false;
+    ChartTrigger m_trigger;             // Indeks przejść serii 0, aktualizowany przy dodawaniu
+    ChartTriggerMode m_triggerMode = CHART_TRIGGER_AUTO;
+    bool m_triggerHeld = false;         // Ramka wyzwolona i zatrzymana (NORMAL / SINGLE)
+    int64_t m_heldRefNs = 0;
+    bool m_singleArmed = false;
+    int64_t m_armTimeNs = 0;
+
+    // Strip-chart scrolling — stan warstwy danych z poprzedniej klatki
+    bool m_scrolling = false;
+    bool m_layerValid = false;
+    int64_t m_layerRefNs = 0;
+    int64_t m_layerWindowNs = 0;
+    ChartRect m_layerPlot = { 0, 0, 0, 0 };
+    uint32_t m_layerStaticSerial = 0;
+    bool m_layerDots = false;           // Kropki przy rzadkich danych — zmiana wymusza pełne odświeżenie
+    uint32_t m_staticSerial = 0;        // Zwiększany przy każdym drawStatic()
+
+    // Kursory pomiarowe
+    bool m_timeCursors = false;
+    double m_cursorT[2] = { 0.0, 0.0 };
+    bool m_valueCursors = false;
+    double m_cursorV[2] = { 0.0, 0.0 };
+    int m_cursorSeries = 0;
+    ChartMeasurement m_measurement;
+    ChartColor m_cursorColor = 0x0000C8FF;  // RGB(255, 200, 0)
+
+    // Spectrum mode
+    ChartDisplayMode m_displayMode = CHART_MODE_TIME;
+    ChartSpectrum m_spectrum;
+    bool m_spectrumLogFreq = true;
+    double m_spectrumMinDb = -120.0;
+    double m_spectrumMaxDb = 0.0;
+    double m_spectrumMinHz = 0.0;       // 0 = automatycznie
+    double m_spectrumMaxHz = 0.0;
+    double m_frameMinHz = 0.0;          // Zakres częstotliwości bieżącej klatki
+    double m_frameMaxHz = 0.0;
+    ChartDisplayMode m_staticMode = CHART_MODE_TIME;
+    double m_staticMinHz = 0.0;
+    double m_staticMaxHz = 0.0;
+    std::vector<ChartPoint> m_spectrumPoints;
+
+    // Persistence mode
+    ChartPersistence m_persistence;
+    ChartPersistencePalette m_persistencePalette = CHART_PALETTE_MONO;
+    std::vector<ChartColor> m_persistenceImage;
+
+    void pushSample(Series& series, int64_t timeNs, double value, bool newSegment);
+    void pushUniform(Series& series, int64_t firstNs, double periodNs, const double* values, int count,
+                     bool newSegment);
+    void persistSample(int64_t timeNs, double value, bool newSegment);
+    void syncPersistenceTrigger();
+    void cleanOldDataPoints(Series& series);
+    void rebuildTrigger();
+    void configureStorage();
+    void budgetGeometry(size_t& capacity, size_t& buckets) const;
+    bool rawExtremes(const Series& series, double& lo, double& hi) const;
+    int64_t findReferenceTime();
+    void prepareViews(const ChartRect& plot);
+    bool hasSecondaryAxis() const;
+
+    // Funkcje pomocnicze do skalowania danych
+    double getMinValue(int axis) const;
+    double getMaxValue(int axis) const;
+    void updateScale(int axis);
+
+    // Pomocnicze funkcje do rysowania
+    void drawGrid(ChartCanvas& canvas, const ChartRect& plot);
+    void drawAxes(ChartCanvas& canvas, const ChartRect& rect, const ChartRect& plot);
+    void drawSeries(ChartCanvas& canvas, const ChartRect& plot, int64_t fromNs);
+    void alignScroll(const ChartRect& plot);
+    void updateFrequencyRange();
+    ChartSpectrumViewport spectrumViewport(const ChartRect& plot) const;
+    void drawSpectrumAxes(ChartCanvas& canvas, const ChartRect& rect, const ChartRect& plot);
+    void drawSpectrum(ChartCanvas& canvas, const ChartRect& plot);
+    void measure();
+    bool nearestValue(const Series& series, int64_t timeNs, double& value) const;
+    void rangeStats(const Series& series, int64_t fromNs, int64_t toNs, ChartStats& stats, bool& exact) const;
+    void beginFrame(int width, int height, bool sizePersistence);
+    void beginPersistenceFrame(const ChartRect& plot, bool sizeBuffer);
+    void drawPersistence(ChartCanvas& canvas, const ChartRect& plot);
+};
+
+#endif // CHART_PLOT_H
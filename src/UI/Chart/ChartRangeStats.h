@@ -0,0 +1,185 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 JAQUBA (https://github.com/JAQUBA)
+// Part of JQB_WindowsLib — https://github.com/JAQUBA/JQB_WindowsLib
+
+/**
+ * ChartRangeStats.h — min / max / mean / RMS of any sample range without a rescan
+ *
+ * Aggregates (min, max, sum, sum of squares, count) of aligned blocks of
+ * 64, 64², 64³ and 64⁴ samples, keyed by sample sequence number like
+ * ChartExtrema. A range query reads raw samples only at its ragged edges and
+ * whole blocks in between — at most ~2 × 63 items per level, so a cursor
+ * readout over millions of samples costs a few hundred additions.
+ * Memory: ~0.6 byte per retained sample.
+ *
+ * Header-only. Nie zależy od WinAPI.
+ */
+
+#ifndef CHART_RANGE_STATS_H
+#define CHART_RANGE_STATS_H
+
+#include "ChartBuffer.h"
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+struct ChartStats {
+    size_t count = 0;           // samples (NaN and ±inf excluded)
+    double min = 0.0;
+    double max = 0.0;
+    double sum = 0.0;
+    double sumSq = 0.0;
+
+    double mean() const { return count ? sum / count : 0.0; }
+    double rms()  const { return count ? std::sqrt(sumSq / count) : 0.0; }
+
+    void add(double value) {
+        if (!std::isfinite(value)) return;
+        if (count == 0 || value < min) min = value;
+        if (count == 0 || value > max) max = value;
+        sum += value;
+        sumSq += value * value;
+        count++;
+    }
+    void merge(const ChartStats& o) {
+        if (o.count == 0) return;
+        if (count == 0 || o.min < min) min = o.min;
+        if (count == 0 || o.max > max) max = o.max;
+        sum += o.sum;
+        sumSq += o.sumSq;
+        count += o.count;
+    }
+};
+
+class ChartRangeStats {
+public:
+    static const int SHIFT  = 6;        // 64 elementów na blok każdego poziomu
+    static const int LEVELS = 4;
+
+    void push(uint64_t seq, double value) {
+        if (!m_started) {
+            m_firstSeq = seq;
+            m_started = true;
+        }
+        for (int l = 0; l < LEVELS; l++) {
+            Level& lv = m_levels[l];
+            uint64_t block = seq >> (SHIFT * (l + 1));
+            if (!lv.open || block != lv.current) {
+                if (block - (m_firstSeq >> (SHIFT * (l + 1))) >= lv.ring.size()) grow(l, block);
+                lv.ring[block & (lv.ring.size() - 1)] = ChartStats();
+                lv.current = block;
+                lv.open = true;
+            }
+            lv.ring[block & (lv.ring.size() - 1)].add(value);
+        }
+    }
+
+    // Bloki sprzed firstSeq nie są już czytane — tylko przesuwa początek
+    void evictBefore(uint64_t firstSeq) {
+        if (firstSeq > m_firstSeq) m_firstSeq = firstSeq;
+    }
+
+    void clear() {
+        for (Level& lv : m_levels) lv.open = false;
+        m_started = false;
+    }
+
+    // Statistics of buffer samples [first, first + count) (logical indices)
+    ChartStats query(const ChartBuffer& buffer, size_t first, size_t count) const {
+        ChartStats st;
+        uint64_t a = buffer.firstSeq() + first;
+        uint64_t b = a + count;
+        if (!m_started || a < m_firstSeq) {
+            // Poza indeksem (np. seria 0 w trybie poświaty) — zwykłe przejście
+            for (size_t i = 0; i < count; i++) st.add(buffer.valueAt(first + i));
+            return st;
+        }
+
+        // Poziom l: środek [A, B) to całe bloki poziomu l, brzegi — elementy poziomu l - 1
+        for (int l = 0; ; l++) {
+            uint64_t span = (uint64_t)1 << (SHIFT * (l + 1));
+            uint64_t A = (a + span - 1) & ~(span - 1);
+            uint64_t B = b & ~(span - 1);
+            if (l == LEVELS || A >= B) {
+                scan(buffer, l - 1, a, b, st);
+                break;
+            }
+            scan(buffer, l - 1, a, A, st);
+            scan(buffer, l - 1, B, b, st);
+            a = A;
+            b = B;
+        }
+        return st;
+    }
+
+    // Preallocate for up to `samples` retained samples — push() then never reallocates
+    void reserve(size_t samples) {
+        for (int l = 0; l < LEVELS; l++) {
+            size_t need = levelSize(samples, l);
+            if (m_levels[l].ring.size() < need) grow(l, (m_firstSeq >> (SHIFT * (l + 1))) + need - 1);
+        }
+    }
+    static size_t reserveBytes(size_t samples) {
+        size_t total = 0;
+        for (int l = 0; l < LEVELS; l++) total += levelSize(samples, l) * sizeof(ChartStats);
+        return total;
+    }
+
+    size_t memoryBytes() const {
+        size_t total = 0;
+        for (const Level& lv : m_levels) total += lv.ring.capacity() * sizeof(ChartStats);
+        return total;
+    }
+
+private:
+    struct Level {
+        std::vector<ChartStats> ring;   // Indeks bloku & (rozmiar - 1)
+        uint64_t current = 0;
+        bool open = false;
+    };
+
+    Level    m_levels[LEVELS];
+    uint64_t m_firstSeq = 0;
+    bool     m_started = false;
+
+    // Bloki poziomu l obejmujące `samples` kolejnych próbek (+ dwa niepełne brzegi)
+    static size_t levelSize(size_t samples, int level) {
+        size_t need = (samples >> (SHIFT * (level + 1))) + 2;
+        size_t size = 16;
+        while (size < need) size *= 2;
+        return size;
+    }
+
+    // Elementy poziomu level (-1 = surowe próbki) z zakresu sekwencji [a, b)
+    void scan(const ChartBuffer& buffer, int level, uint64_t a, uint64_t b, ChartStats& st) const {
+        if (a >= b) return;
+        if (level < 0) {
+            for (uint64_t q = a; q < b; q++) st.add(buffer.valueAt((size_t)(q - buffer.firstSeq())));
+            return;
+        }
+        const Level& lv = m_levels[level];
+        int shift = SHIFT * (level + 1);
+        for (uint64_t blk = a >> shift; blk < (b >> shift); blk++) {
+            st.merge(lv.ring[blk & (lv.ring.size() - 1)]);
+        }
+    }
+
+    void grow(int level, uint64_t block) {
+        Level& lv = m_levels[level];
+        int shift = SHIFT * (level + 1);
+        uint64_t firstBlock = m_firstSeq >> shift;
+        size_t size = lv.ring.empty() ? 16 : lv.ring.size();
+        while (block - firstBlock >= size) size *= 2;
+
+        std::vector<ChartStats> ring(size);
+        if (lv.open) {
+            for (uint64_t blk = firstBlock; blk <= lv.current; blk++) {
+                ring[blk & (size - 1)] = lv.ring[blk & (lv.ring.size() - 1)];
+            }
+        }
+        lv.ring.swap(ring);
+    }
+};
+
+#endif // CHART_RANGE_STATS_H
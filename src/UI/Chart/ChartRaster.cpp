@@ -0,0 +1,542 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 JAQUBA (https://github.com/JAQUBA)
+// Part of JQB_WindowsLib — https://github.com/JAQUBA/JQB_WindowsLib
+
+#include "ChartRaster.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cctype>
+#include <cstring>
+
+// ============================================================================
+// Czcionka 5×7 (ASCII 32..126) — wiersze od góry, bit 4 = lewa kolumna
+// ============================================================================
+static const uint8_t FONT_5X7[95][7] = {
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },  // ' '
+    { 0x04, 0x04, 0x04, 0x04, 0x04, 0x00, 0x04 },  // '!'
+    { 0x0A, 0x0A, 0x0A, 0x00, 0x00, 0x00, 0x00 },  // '"'
+    { 0x0A, 0x0A, 0x1F, 0x0A, 0x1F, 0x0A, 0x0A },  // '#'
+    { 0x04, 0x0F, 0x14, 0x0E, 0x05, 0x1E, 0x04 },  // '$'
+    { 0x18, 0x19, 0x02, 0x04, 0x08, 0x13, 0x03 },  // '%'
+    { 0x0C, 0x12, 0x14, 0x08, 0x15, 0x12, 0x0D },  // '&'
+    { 0x04, 0x04, 0x08, 0x00, 0x00, 0x00, 0x00 },  // '''
+    { 0x02, 0x04, 0x08, 0x08, 0x08, 0x04, 0x02 },  // '('
+    { 0x08, 0x04, 0x02, 0x02, 0x02, 0x04, 0x08 },  // ')'
+    { 0x00, 0x04, 0x15, 0x0E, 0x15, 0x04, 0x00 },  // '*'
+    { 0x00, 0x04, 0x04, 0x1F, 0x04, 0x04, 0x00 },  // '+'
+    { 0x00, 0x00, 0x00, 0x00, 0x0C, 0x04, 0x08 },  // ','
+    { 0x00, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x00 },  // '-'
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C },  // '.'
+    { 0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x00 },  // '/'
+    { 0x0E, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0E },  // '0'
+    { 0x04, 0x0C, 0x04, 0x04, 0x04, 0x04, 0x0E },  // '1'
+    { 0x0E, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1F },  // '2'
+    { 0x1F, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0E },  // '3'
+    { 0x02, 0x06, 0x0A, 0x12, 0x1F, 0x02, 0x02 },  // '4'
+    { 0x1F, 0x10, 0x1E, 0x01, 0x01, 0x11, 0x0E },  // '5'
+    { 0x06, 0x08, 0x10, 0x1E, 0x11, 0x11, 0x0E },  // '6'
+    { 0x1F, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08 },  // '7'
+    { 0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E },  // '8'
+    { 0x0E, 0x11, 0x11, 0x0F, 0x01, 0x02, 0x0C },  // '9'
+    { 0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x0C, 0x00 },  // ':'
+    { 0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x04, 0x08 },  // ';'
+    { 0x02, 0x04, 0x08, 0x10, 0x08, 0x04, 0x02 },  // '<'
+    { 0x00, 0x00, 0x1F, 0x00, 0x1F, 0x00, 0x00 },  // '='
+    { 0x08, 0x04, 0x02, 0x01, 0x02, 0x04, 0x08 },  // '>'
+    { 0x0E, 0x11, 0x01, 0x02, 0x04, 0x00, 0x04 },  // '?'
+    { 0x0E, 0x11, 0x01, 0x0D, 0x15, 0x15, 0x0E },  // '@'
+    { 0x0E, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11 },  // 'A'
+    { 0x1E, 0x11, 0x11, 0x1E, 0x11, 0x11, 0x1E },  // 'B'
+    { 0x0E, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0E },  // 'C'
+    { 0x1C, 0x12, 0x11, 0x11, 0x11, 0x12, 0x1C },  // 'D'
+    { 0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x1F },  // 'E'
+    { 0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x10 },  // 'F'
+    { 0x0E, 0x11, 0x10, 0x17, 0x11, 0x11, 0x0F },  // 'G'
+    { 0x11, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11 },  // 'H'
+    { 0x0E, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E },  // 'I'
+    { 0x07, 0x02, 0x02, 0x02, 0x02, 0x12, 0x0C },  // 'J'
+    { 0x11, 0x12, 0x14, 0x18, 0x14, 0x12, 0x11 },  // 'K'
+    { 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x1F },  // 'L'
+    { 0x11, 0x1B, 0x15, 0x15, 0x11, 0x11, 0x11 },  // 'M'
+    { 0x11, 0x11, 0x19, 0x15, 0x13, 0x11, 0x11 },  // 'N'
+    { 0x0E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E },  // 'O'
+    { 0x1E, 0x11, 0x11, 0x1E, 0x10, 0x10, 0x10 },  // 'P'
+    { 0x0E, 0x11, 0x11, 0x11, 0x15, 0x12, 0x0D },  // 'Q'
+    { 0x1E, 0x11, 0x11, 0x1E, 0x14, 0x12, 0x11 },  // 'R'
+    { 0x0F, 0x10, 0x10, 0x0E, 0x01, 0x01, 0x1E },  // 'S'
+    { 0x1F, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04 },  // 'T'
+    { 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E },  // 'U'
+    { 0x11, 0x11, 0x11, 0x11, 0x11, 0x0A, 0x04 },  // 'V'
+    { 0x11, 0x11, 0x11, 0x15, 0x15, 0x15, 0x0A },  // 'W'
+    { 0x11, 0x11, 0x0A, 0x04, 0x0A, 0x11, 0x11 },  // 'X'
+    { 0x11, 0x11, 0x11, 0x0A, 0x04, 0x04, 0x04 },  // 'Y'
+    { 0x1F, 0x01, 0x02, 0x04, 0x08, 0x10, 0x1F },  // 'Z'
+    { 0x0E, 0x08, 0x08, 0x08, 0x08, 0x08, 0x0E },  // '['
+    { 0x00, 0x10, 0x08, 0x04, 0x02, 0x01, 0x00 },  // '\\'
+    { 0x0E, 0x02, 0x02, 0x02, 0x02, 0x02, 0x0E },  // ']'
+    { 0x04, 0x0A, 0x11, 0x00, 0x00, 0x00, 0x00 },  // '^'
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F },  // '_'
+    { 0x08, 0x04, 0x02, 0x00, 0x00, 0x00, 0x00 },  // '`'
+    { 0x00, 0x00, 0x0E, 0x01, 0x0F, 0x11, 0x0F },  // 'a'
+    { 0x10, 0x10, 0x16, 0x19, 0x11, 0x11, 0x1E },  // 'b'
+    { 0x00, 0x00, 0x0E, 0x10, 0x10, 0x11, 0x0E },  // 'c'
+    { 0x01, 0x01, 0x0D, 0x13, 0x11, 0x11, 0x0F },  // 'd'
+    { 0x00, 0x00, 0x0E, 0x11, 0x1F, 0x10, 0x0E },  // 'e'
+    { 0x06, 0x09, 0x08, 0x1C, 0x08, 0x08, 0x08 },  // 'f'
+    { 0x00, 0x0F, 0x11, 0x11, 0x0F, 0x01, 0x0E },  // 'g'
+    { 0x10, 0x10, 0x16, 0x19, 0x11, 0x11, 0x11 },  // 'h'
+    { 0x04, 0x00, 0x0C, 0x04, 0x04, 0x04, 0x0E },  // 'i'
+    { 0x02, 0x00, 0x06, 0x02, 0x02, 0x12, 0x0C },  // 'j'
+    { 0x10, 0x10, 0x12, 0x14, 0x18, 0x14, 0x12 },  // 'k'
+    { 0x0C, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E },  // 'l'
+    { 0x00, 0x00, 0x1A, 0x15, 0x15, 0x11, 0x11 },  // 'm'
+    { 0x00, 0x00, 0x16, 0x19, 0x11, 0x11, 0x11 },  // 'n'
+    { 0x00, 0x00, 0x0E, 0x11, 0x11, 0x11, 0x0E },  // 'o'
+    { 0x00, 0x00, 0x1E, 0x11, 0x1E, 0x10, 0x10 },  // 'p'
+    { 0x00, 0x00, 0x0D, 0x13, 0x0F, 0x01, 0x01 },  // 'q'
+    { 0x00, 0x00, 0x16, 0x19, 0x10, 0x10, 0x10 },  // 'r'
+    { 0x00, 0x00, 0x0E, 0x10, 0x0E, 0x01, 0x1E },  // 's'
+    { 0x08, 0x08, 0x1C, 0x08, 0x08, 0x09, 0x06 },  // 't'
+    { 0x00, 0x00, 0x11, 0x11, 0x11, 0x13, 0x0D },  // 'u'
+    { 0x00, 0x00, 0x11, 0x11, 0x11, 0x0A, 0x04 },  // 'v'
+    { 0x00, 0x00, 0x11, 0x11, 0x15, 0x15, 0x0A },  // 'w'
+    { 0x00, 0x00, 0x11, 0x0A, 0x04, 0x0A, 0x11 },  // 'x'
+    { 0x00, 0x00, 0x11, 0x11, 0x0F, 0x01, 0x0E },  // 'y'
+    { 0x00, 0x00, 0x1F, 0x02, 0x04, 0x08, 0x1F },  // 'z'
+    { 0x02, 0x04, 0x04, 0x08, 0x04, 0x04, 0x02 },  // '{'
+    { 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04 },  // '|'
+    { 0x08, 0x04, 0x04, 0x02, 0x04, 0x04, 0x08 },  // '}'
+    { 0x00, 0x00, 0x08, 0x15, 0x02, 0x00, 0x00 },  // '~'
+};
+
+static const int GLYPH_W = 5;
+static const int GLYPH_H = 7;
+static const int GLYPH_ADVANCE = 6;
+
+// Znaki spoza ASCII → najbliższy znak czcionki
+static wchar_t fontFallback(wchar_t ch) {
+    if (ch >= 32 && ch < 127) return ch;
+    switch (ch) {
+        case L'ą': return L'a';  case L'Ą': return L'A';
+        case L'ć': return L'c';  case L'Ć': return L'C';
+        case L'ę': return L'e';  case L'Ę': return L'E';
+        case L'ł': return L'l';  case L'Ł': return L'L';
+        case L'ń': return L'n';  case L'Ń': return L'N';
+        case L'ó': return L'o';  case L'Ó': return L'O';
+        case L'ś': return L's';  case L'Ś': return L'S';
+        case L'ź': case L'ż': return L'z';
+        case L'Ź': case L'Ż': return L'Z';
+        case L'µ': case L'μ': return L'u';
+        case L'°': return L'o';
+        case L'Ω': return L'O';
+        default:   return L'?';
+    }
+}
+
+// ============================================================================
+// Bufor
+// ============================================================================
+ChartRaster::ChartRaster(int width, int height)
+    : m_width(0), m_height(0)
+{
+    resize(width, height);
+}
+
+void ChartRaster::resize(int width, int height) {
+    m_width = width > 0 ? width : 0;
+    m_height = height > 0 ? height : 0;
+    m_rgba.assign((size_t)m_width * m_height * 4, 0);
+    for (size_t i = 3; i < m_rgba.size(); i += 4) m_rgba[i] = 255;
+}
+
+ChartColor ChartRaster::pixel(int x, int y) const {
+    if (x < 0 || y < 0 || x >= m_width || y >= m_height) return 0;
+    const uint8_t* p = &m_rgba[((size_t)y * m_width + x) * 4];
+    return chartRgb(p[0], p[1], p[2]);
+}
+
+void ChartRaster::span(int x0, int x1, int y, ChartColor color) {
+    if (y < 0 || y >= m_height) return;
+    if (x0 < 0) x0 = 0;
+    if (x1 > m_width - 1) x1 = m_width - 1;
+    if (x0 > x1) return;
+    uint8_t r = chartRed(color), g = chartGreen(color), b = chartBlue(color);
+    uint8_t* p = &m_rgba[((size_t)y * m_width + x0) * 4];
+    for (int x = x0; x <= x1; x++, p += 4) {
+        p[0] = r;
+        p[1] = g;
+        p[2] = b;
+    }
+}
+
+void ChartRaster::brush(int x, int y, int size, ChartColor color) {
+    if (size <= 1) {
+        span(x, x, y, color);
+        return;
+    }
+    int half = size / 2;
+    for (int dy = 0; dy < size; dy++) {
+        span(x - half, x - half + size - 1, y - half + dy, color);
+    }
+}
+
+// ============================================================================
+// Prymitywy
+// ============================================================================
+void ChartRaster::fillRect(const ChartRect& rect, ChartColor color) {
+    // Jak GDI FillRect — prawa i dolna krawędź wyłączne
+    for (int y = rect.top; y < rect.bottom; y++) {
+        span(rect.left, rect.right - 1, y, color);
+    }
+}
+
+void ChartRaster::scroll(const ChartRect& rect, int dx, ChartColor fill) {
+    int left = std::max(rect.left, 0);
+    int right = std::min(rect.right, m_width);
+    int w = right - left;
+    if (w <= 0 || dx == 0) return;
+    if (dx >= w || -dx >= w) {
+        fillRect(rect, fill);
+        return;
+    }
+    for (int y = std::max(rect.top, 0); y < std::min(rect.bottom, m_height); y++) {
+        uint8_t* row = &m_rgba[((size_t)y * m_width + left) * 4];
+        if (dx < 0) {
+            memmove(row, row - dx * 4, (size_t)(w + dx) * 4);
+            span(right + dx, right - 1, y, fill);
+        } else {
+            memmove(row + dx * 4, row, (size_t)(w - dx) * 4);
+            span(left, left + dx - 1, y, fill);
+        }
+    }
+}
+
+void ChartRaster::image(const ChartRect& box, const ChartColor* pixels) {
+    int w = box.right - box.left;
+    int x0 = std::max(box.left, 0);
+    int x1 = std::min(box.right, m_width);
+    for (int y = std::max(box.top, 0); y < std::min(box.bottom, m_height); y++) {
+        const ChartColor* row = pixels + (size_t)(y - box.top) * w;
+        uint8_t* p = &m_rgba[((size_t)y * m_width + x0) * 4];
+        for (int x = x0; x < x1; x++, p += 4) {
+            ChartColor c = row[x - box.left];
+            if (c == CHART_COLOR_NONE) continue;
+            p[0] = chartRed(c);
+            p[1] = chartGreen(c);
+            p[2] = chartBlue(c);
+        }
+    }
+}
+
+void ChartRaster::line(int x0, int y0, int x1, int y1, ChartColor color, int width, bool dotted) {
+    // Liang–Barsky: przytnij odcinek do bufora (z zapasem na grubość pędzla),
+    // żeby punkty daleko poza wykresem nie kosztowały iteracji
+    int pad = width;
+    double xmin = -pad, ymin = -pad, xmax = m_width + pad, ymax = m_height + pad;
+    double dx = (double)x1 - x0, dy = (double)y1 - y0;
+    double t0 = 0.0, t1 = 1.0;
+    double p[4] = { -dx, dx, -dy, dy };
+    double q[4] = { x0 - xmin, xmax - x0, y0 - ymin, ymax - y0 };
+    for (int i = 0; i < 4; i++) {
+        if (p[i] == 0.0) {
+            if (q[i] < 0.0) return;
+            continue;
+        }
+        double t = q[i] / p[i];
+        if (p[i] < 0.0) { if (t > t1) return; if (t > t0) t0 = t; }
+        else            { if (t < t0) return; if (t < t1) t1 = t; }
+    }
+    int ax = (int)(x0 + t0 * dx), ay = (int)(y0 + t0 * dy);
+    int bx = (int)(x0 + t1 * dx), by = (int)(y0 + t1 * dy);
+
+    // Bresenham
+    int sx = ax < bx ? 1 : -1, sy = ay < by ? 1 : -1;
+    int ex = std::abs(bx - ax), ey = -std::abs(by - ay);
+    int err = ex + ey;
+    int step = 0;
+    for (;;) {
+        if (!dotted || (step & 1) == 0) brush(ax, ay, width, color);
+        step++;
+        if (ax == bx && ay == by) break;
+        int e2 = 2 * err;
+        if (e2 >= ey) { err += ey; ax += sx; }
+        if (e2 <= ex) { err += ex; ay += sy; }
+    }
+}
+
+void ChartRaster::polyPolyline(const ChartPoint* points, const uint32_t* runs, size_t runCount,
+                               ChartColor color, int width) {
+    size_t k = 0;
+    for (size_t r = 0; r < runCount; r++) {
+        for (uint32_t i = 1; i < runs[r]; i++) {
+            line(points[k + i - 1].x, points[k + i - 1].y, points[k + i].x, points[k + i].y, color, width, false);
+        }
+        k += runs[r];
+    }
+}
+
+void ChartRaster::dots(const ChartPoint* points, size_t count, int radius, ChartColor color) {
+    for (size_t i = 0; i < count; i++) {
+        for (int dy = -radius; dy <= radius; dy++) {
+            int dx = 0;
+            while ((dx + 1) * (dx + 1) + dy * dy <= radius * radius) dx++;
+            span(points[i].x - dx, points[i].x + dx, points[i].y + dy, color);
+        }
+    }
+}
+
+void ChartRaster::glyph(int x, int y, wchar_t ch, int scale, ChartColor color) {
+    const uint8_t* rows = FONT_5X7[fontFallback(ch) - 32];
+    for (int row = 0; row < GLYPH_H; row++) {
+        for (int col = 0; col < GLYPH_W; col++) {
+            if (!(rows[row] & (0x10 >> col))) continue;
+            for (int sy = 0; sy < scale; sy++) {
+                span(x + col * scale, x + col * scale + scale - 1, y + row * scale + sy, color);
+            }
+        }
+    }
+}
+
+void ChartRaster::text(const ChartRect& box, const std::wstring& str, ChartColor color,
+                       ChartFont font, int flags) {
+    int scale = font == CHART_FONT_TITLE ? 2 : 1;
+    int w = (int)str.size() * GLYPH_ADVANCE * scale - scale;
+    int h = GLYPH_H * scale;
+
+    int x = box.left;
+    if (flags & CHART_TEXT_RIGHT)       x = box.right - w;
+    else if (flags & CHART_TEXT_CENTER) x = box.left + (box.right - box.left - w) / 2;
+    int y = box.top + 1;
+    if (flags & CHART_TEXT_VCENTER)     y = box.top + (box.bottom - box.top - h) / 2;
+
+    for (wchar_t ch : str) {
+        glyph(x, y, ch, scale, color);
+        x += GLYPH_ADVANCE * scale;
+    }
+}
+
+// ============================================================================
+// Eksport — PPM
+// ============================================================================
+bool ChartRaster::savePpm(const std::string& path) const {
+    FILE* f = fopen(path.c_str(), "wb");
+    if (!f) return false;
+    fprintf(f, "P6\n%d %d\n255\n", m_width, m_height);
+    std::vector<uint8_t> row((size_t)m_width * 3);
+    bool ok = true;
+    for (int y = 0; y < m_height && ok; y++) {
+        const uint8_t* src = &m_rgba[(size_t)y * m_width * 4];
+        for (int x = 0; x < m_width; x++) {
+            row[x * 3 + 0] = src[x * 4 + 0];
+            row[x * 3 + 1] = src[x * 4 + 1];
+            row[x * 3 + 2] = src[x * 4 + 2];
+        }
+        ok = fwrite(row.data(), 1, row.size(), f) == row.size();
+    }
+    return fclose(f) == 0 && ok;
+}
+
+// ============================================================================
+// Eksport — PNG (zlib/deflate: LZ77 + stałe kody Huffmana)
+// ============================================================================
+namespace {
+
+class BitWriter {
+public:
+    explicit BitWriter(std::vector<uint8_t>& out) : m_out(out), m_acc(0), m_bits(0) {}
+
+    void put(uint32_t value, int count) {
+        m_acc |= value << m_bits;
+        m_bits += count;
+        while (m_bits >= 8) {
+            m_out.push_back((uint8_t)m_acc);
+            m_acc >>= 8;
+            m_bits -= 8;
+        }
+    }
+    // Kody Huffmana zapisywane od najstarszego bitu
+    void putReversed(uint32_t code, int count) {
+        uint32_t rev = 0;
+        for (int i = 0; i < count; i++) rev |= ((code >> i) & 1) << (count - 1 - i);
+        put(rev, count);
+    }
+    void flush() {
+        if (m_bits > 0) m_out.push_back((uint8_t)m_acc);
+        m_acc = 0;
+        m_bits = 0;
+    }
+
+private:
+    std::vector<uint8_t>& m_out;
+    uint32_t m_acc;
+    int m_bits;
+};
+
+const uint16_t LENGTH_BASE[29] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+                                   35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+const uint8_t  LENGTH_EXTRA[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+                                    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+const uint16_t DIST_BASE[30] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+                                 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145,
+                                 8193, 12289, 16385, 24577 };
+const uint8_t  DIST_EXTRA[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+                                  7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+void putLiteral(BitWriter& bw, int sym) {
+    if (sym < 144)      bw.putReversed(0x30 + sym, 8);
+    else if (sym < 256) bw.putReversed(0x190 + sym - 144, 9);
+    else if (sym < 280) bw.putReversed(sym - 256, 7);
+    else                bw.putReversed(0xC0 + sym - 280, 8);
+}
+
+void putMatch(BitWriter& bw, int length, int distance) {
+    int li = 28;
+    while (LENGTH_BASE[li] > length) li--;
+    putLiteral(bw, 257 + li);
+    bw.put(length - LENGTH_BASE[li], LENGTH_EXTRA[li]);
+
+    int di = 29;
+    while (DIST_BASE[di] > distance) di--;
+    bw.putReversed(di, 5);
+    bw.put(distance - DIST_BASE[di], DIST_EXTRA[di]);
+}
+
+void deflateFixed(const std::vector<uint8_t>& in, std::vector<uint8_t>& out) {
+    const int WINDOW = 32768;
+    const int HASH_BITS = 15;
+    const int MAX_CHAIN = 32;
+    const int MIN_MATCH = 3, MAX_MATCH = 258;
+
+    std::vector<int32_t> head((size_t)1 << HASH_BITS, -1);
+    std::vector<int32_t> prev(in.size(), -1);
+    auto hashAt = [&](size_t i) {
+        return (uint32_t)((in[i] << 10) ^ (in[i + 1] << 5) ^ in[i + 2]) & ((1u << HASH_BITS) - 1);
+    };
+
+    BitWriter bw(out);
+    bw.put(1, 1);   // BFINAL
+    bw.put(1, 2);   // BTYPE = stałe kody Huffmana
+
+    size_t n = in.size();
+    size_t i = 0;
+    while (i < n) {
+        int bestLen = 0, bestDist = 0;
+        if (i + MIN_MATCH <= n) {
+            uint32_t h = hashAt(i);
+            int32_t cand = head[h];
+            int chain = 0;
+            size_t limit = std::min((size_t)MAX_MATCH, n - i);
+            while (cand >= 0 && (int)(i - cand) <= WINDOW && chain++ < MAX_CHAIN) {
+                size_t len = 0;
+                while (len < limit && in[cand + len] == in[i + len]) len++;
+                if ((int)len > bestLen) {
+                    bestLen = (int)len;
+                    bestDist = (int)(i - cand);
+                    if (len == limit) break;
+                }
+                cand = prev[cand];
+            }
+        }
+
+        size_t advance = bestLen >= MIN_MATCH ? (size_t)bestLen : 1;
+        if (bestLen >= MIN_MATCH) putMatch(bw, bestLen, bestDist);
+        else                      putLiteral(bw, in[i]);
+
+        for (size_t k = 0; k < advance; k++, i++) {
+            if (i + MIN_MATCH <= n) {
+                uint32_t h = hashAt(i);
+                prev[i] = head[h];
+                head[h] = (int32_t)i;
+            }
+        }
+    }
+    putLiteral(bw, 256);    // koniec bloku
+    bw.flush();
+}
+
+uint32_t crc32(const uint8_t* data, size_t len, uint32_t crc = 0) {
+    static uint32_t table[256];
+    static bool ready = false;
+    if (!ready) {
+        for (uint32_t n = 0; n < 256; n++) {
+            uint32_t c = n;
+            for (int k = 0; k < 8; k++) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            table[n] = c;
+        }
+        ready = true;
+    }
+    crc = ~crc;
+    for (size_t i = 0; i < len; i++) crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+void putBE32(std::vector<uint8_t>& out, uint32_t v) {
+    out.push_back((uint8_t)(v >> 24));
+    out.push_back((uint8_t)(v >> 16));
+    out.push_back((uint8_t)(v >> 8));
+    out.push_back((uint8_t)v);
+}
+
+void putChunk(std::vector<uint8_t>& out, const char* type, const std::vector<uint8_t>& data) {
+    putBE32(out, (uint32_t)data.size());
+    size_t start = out.size();
+    out.insert(out.end(), type, type + 4);
+    out.insert(out.end(), data.begin(), data.end());
+    putBE32(out, crc32(&out[start], out.size() - start));
+}
+
+} // namespace
+
+bool ChartRaster::savePng(const std::string& path) const {
+    // Surowe wiersze: bajt filtra (0 = brak) + RGB
+    std::vector<uint8_t> raw;
+    raw.reserve((size_t)m_height * (m_width * 3 + 1));
+    for (int y = 0; y < m_height; y++) {
+        raw.push_back(0);
+        const uint8_t* src = &m_rgba[(size_t)y * m_width * 4];
+        for (int x = 0; x < m_width; x++) {
+            raw.push_back(src[x * 4 + 0]);
+            raw.push_back(src[x * 4 + 1]);
+            raw.push_back(src[x * 4 + 2]);
+        }
+    }
+
+    // Strumień zlib: nagłówek, deflate, Adler-32
+    std::vector<uint8_t> z;
+    z.push_back(0x78);
+    z.push_back(0x01);
+    deflateFixed(raw, z);
+    uint32_t a = 1, b = 0;
+    for (uint8_t v : raw) {
+        a = (a + v) % 65521;
+        b = (b + a) % 65521;
+    }
+    putBE32(z, (b << 16) | a);
+
+    std::vector<uint8_t> png = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    std::vector<uint8_t> ihdr;
+    putBE32(ihdr, (uint32_t)m_width);
+    putBE32(ihdr, (uint32_t)m_height);
+    ihdr.push_back(8);      // bit depth
+    ihdr.push_back(2);      // colour type: RGB
+    ihdr.push_back(0);      // compression
+    ihdr.push_back(0);      // filter
+    ihdr.push_back(0);      // interlace
+    putChunk(png, "IHDR", ihdr);
+    putChunk(png, "IDAT", z);
+    putChunk(png, "IEND", std::vector<uint8_t>());
+
+    FILE* f = fopen(path.c_str(), "wb");
+    if (!f) return false;
+    bool ok = fwrite(png.data(), 1, png.size(), f) == png.size();
+    return fclose(f) == 0 && ok;
+}
+
+bool ChartRaster::save(const std::string& path) const {
+    size_t dot = path.find_last_of('.');
+    std::string ext = dot == std::string::npos ? "" : path.substr(dot + 1);
+    for (char& c : ext) c = (char)tolower((unsigned char)c);
+    if (ext == "ppm") return savePpm(path);
+    return savePng(path);
+}
@@ -0,0 +1,65 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 JAQUBA (https://github.com/JAQUBA)
+// Part of JQB_WindowsLib — https://github.com/JAQUBA/JQB_WindowsLib
+
+/**
+ * ChartRaster.h — software rasteriser backend for ChartPlot
+ *
+ * Renders into a memory RGBA buffer (top-down rows, 4 bytes per pixel) —
+ * no window, no GDI. Used for headless batch rendering (report images,
+ * long recordings) and for profiling the render path on any platform.
+ * Lines: Bresenham with a square brush for widths > 1, clipped to the
+ * buffer. Text: built-in 5×7 bitmap font (ASCII; Polish letters drawn
+ * without diacritics).
+ *
+ * Export: PPM (P6) and PNG (RGB 8-bit, deflate with fixed Huffman codes).
+ *
+ * Nie zależy od WinAPI.
+ */
+
+#ifndef CHART_RASTER_H
+#define CHART_RASTER_H
+
+#include "ChartCanvas.h"
+#include <string>
+#include <vector>
+
+class ChartRaster : public ChartCanvas {
+public:
+    ChartRaster(int width, int height);
+
+    void resize(int width, int height);
+
+    int width() const override  { return m_width; }
+    int height() const override { return m_height; }
+
+    // RGBA, row-major, top row first
+    const uint8_t* pixels() const { return m_rgba.data(); }
+    ChartColor pixel(int x, int y) const;
+
+    bool savePpm(const std::string& path) const;
+    bool savePng(const std::string& path) const;
+    // Format by extension (.png / .ppm), PNG otherwise
+    bool save(const std::string& path) const;
+
+    void fillRect(const ChartRect& rect, ChartColor color) override;
+    void line(int x0, int y0, int x1, int y1, ChartColor color, int width, bool dotted) override;
+    void polyPolyline(const ChartPoint* points, const uint32_t* runs, size_t runCount,
+                      ChartColor color, int width) override;
+    void dots(const ChartPoint* points, size_t count, int radius, ChartColor color) override;
+    void scroll(const ChartRect& rect, int dx, ChartColor fill) override;
+    void image(const ChartRect& box, const ChartColor* pixels) override;
+    void text(const ChartRect& box, const std::wstring& str, ChartColor color,
+              ChartFont font, int flags) override;
+
+private:
+    int m_width;
+    int m_height;
+    std::vector<uint8_t> m_rgba;
+
+    void span(int x0, int x1, int y, ChartColor color);
+    void brush(int x, int y, int size, ChartColor color);
+    void glyph(int x, int y, wchar_t ch, int scale, ChartColor color);
+};
+
+#endif // CHART_RASTER_H
@@ -0,0 +1,172 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 JAQUBA (https://github.com/JAQUBA)
+// Part of JQB_WindowsLib — https://github.com/JAQUBA/JQB_WindowsLib
+
+#include "ChartSpectrum.h"
+#include <algorithm>
+#include <cmath>
+
+ChartSpectrum::ChartSpectrum()
+    : m_averaging(1)
+    , m_peakHold(false)
+    , m_binHz(0.0)
+    , m_historyPos(0)
+    , m_historyCount(0)
+    , m_hasAverage(false)
+{
+    configure(m_fft.getSize(), m_fft.getWindow());
+}
+
+void ChartSpectrum::configure(size_t fftSize, FFTWindow window) {
+    m_fft.setSize(fftSize);
+    m_fft.setWindow(window);
+    m_history.assign(m_fft.getSize(), 0.0);
+    m_frame.assign(m_fft.getSize(), 0.0);
+    m_latest.assign(m_fft.getBinCount(), 0.0);
+    m_historyPos = 0;
+    m_historyCount = 0;
+    m_power.clear();
+    m_peak.clear();
+    m_hasAverage = false;
+}
+
+void ChartSpectrum::setPeakHold(bool enabled) {
+    m_peakHold = enabled;
+    if (!enabled) m_peak.clear();
+}
+
+void ChartSpectrum::resetPeaks() {
+    m_peak.clear();
+}
+
+void ChartSpectrum::clear() {
+    std::fill(m_history.begin(), m_history.end(), 0.0);
+    m_historyPos = 0;
+    m_historyCount = 0;
+    m_power.clear();
+    m_peak.clear();
+    m_hasAverage = false;
+}
+
+// ============================================================================
+// Input
+// ============================================================================
+void ChartSpectrum::process(const double* samples, int count, double sampleRate) {
+    if (!samples || count <= 0 || sampleRate <= 0.0) return;
+
+    size_t n = m_history.size();
+    size_t len = (size_t)count;
+    // Tylko ostatnie n próbek wpływa na ramkę
+    if (len > n) {
+        samples += len - n;
+        len = n;
+    }
+    for (size_t i = 0; i < len; i++) {
+        m_history[m_historyPos] = samples[i];
+        m_historyPos = (m_historyPos + 1) % n;
+    }
+    m_historyCount = std::min(n, m_historyCount + len);
+
+    // Chronologicznie; brakujący początek (rozbieg) pozostaje zerami
+    size_t pad = n - m_historyCount;
+    std::fill(m_frame.begin(), m_frame.begin() + pad, 0.0);
+    size_t src = (m_historyPos + pad) % n;
+    for (size_t i = pad; i < n; i++) {
+        m_frame[i] = m_history[src];
+        src = (src + 1) % n;
+    }
+
+    m_fft.power(m_frame.data(), m_latest.data());
+    accumulate(sampleRate / (double)n);
+}
+
+void ChartSpectrum::setMagnitudes(const double* magnitudes, size_t bins, double binHz) {
+    if (!magnitudes || bins < 2 || binHz <= 0.0) return;
+    m_latest.resize(bins);
+    for (size_t i = 0; i < bins; i++) m_latest[i] = magnitudes[i] * magnitudes[i];
+    accumulate(binHz);
+}
+
+void ChartSpectrum::accumulate(double binHz) {
+    size_t bins = m_latest.size();
+    // Zmiana rozdzielczości unieważnia średnią i szczyty
+    if (m_power.size() != bins || m_binHz != binHz) {
+        m_power.assign(m_latest.begin(), m_latest.end());
+        m_peak.clear();
+        m_binHz = binHz;
+        m_hasAverage = true;
+    } else if (m_averaging > 1 && m_hasAverage) {
+        double alpha = 1.0 / m_averaging;
+        for (size_t i = 0; i < bins; i++) m_power[i] += (m_latest[i] - m_power[i]) * alpha;
+    } else {
+        m_power.assign(m_latest.begin(), m_latest.end());
+        m_hasAverage = true;
+    }
+
+    if (m_peakHold) {
+        if (m_peak.size() != bins) m_peak.assign(m_power.begin(), m_power.end());
+        for (size_t i = 0; i < bins; i++) {
+            if (m_power[i] > m_peak[i]) m_peak[i] = m_power[i];
+        }
+    }
+}
+
+double ChartSpectrum::magnitude(size_t bin) const {
+    return bin < m_power.size() ? std::sqrt(m_power[bin]) : 0.0;
+}
+
+double ChartSpectrum::peak(size_t bin) const {
+    return bin < m_peak.size() ? std::sqrt(m_peak[bin]) : 0.0;
+}
+
+// ============================================================================
+// Bins → pixel columns
+// ============================================================================
+void ChartSpectrum::buildPolyline(const ChartSpectrumViewport& vp, bool peaks, std::vector<ChartPoint>& out) const {
+    out.clear();
+    const std::vector<double>& src = peaks ? m_peak : m_power;
+    if (src.size() < 2 || vp.width <= 0 || vp.height <= 0 || m_binHz <= 0.0) return;
+    if (vp.maxHz <= vp.minHz || vp.maxDb <= vp.minDb) return;
+
+    bool logF = vp.logFrequency && vp.minHz > 0.0;
+    double f0 = logF ? std::log10(vp.minHz) : vp.minHz;
+    double f1 = logF ? std::log10(vp.maxHz) : vp.maxHz;
+    double xScale = vp.width / (f1 - f0);
+    double yScale = vp.height / (vp.maxDb - vp.minDb);
+    // Moc → dB amplitudy: 10·log10(P) == 20·log10(A); dolne ograniczenie 1e-12 (-240 dB)
+    const double floorPower = 1e-24;
+
+    size_t firstBin = (size_t)std::max(0.0, std::floor(vp.minHz / m_binHz));
+    size_t lastBin  = std::min(src.size() - 1, (size_t)std::ceil(vp.maxHz / m_binHz));
+    if (logF && firstBin == 0) firstBin = 1;
+
+    bool    open = false;
+    int32_t col = 0;
+    double  best = 0.0;
+    auto flush = [&]() {
+        if (!open) return;
+        double db = 10.0 * std::log10(std::max(best, floorPower));
+        double y = (db - vp.minDb) * yScale;
+        y = y < 0.0 ? 0.0 : (y > vp.height ? vp.height : y);
+        out.push_back({ col, (int32_t)(vp.bottom - y) });
+        open = false;
+    };
+
+    for (size_t k = firstBin; k <= lastBin; k++) {
+        double f = k * m_binHz;
+        double pos = logF ? std::log10(f) : f;
+        double x = vp.left + (pos - f0) * xScale;
+        if (x < vp.left) x = vp.left;
+        if (x > vp.left + vp.width) x = vp.left + vp.width;
+        int32_t c = (int32_t)x;
+        if (!open || c != col) {
+            flush();
+            open = true;
+            col = c;
+            best = src[k];
+        } else if (src[k] > best) {
+            best = src[k];
+        }
+    }
+    flush();
+}
@@ -0,0 +1,88 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 JAQUBA (https://github.com/JAQUBA)
+// Part of JQB_WindowsLib — https://github.com/JAQUBA/JQB_WindowsLib
+
+/**
+ * ChartSpectrum.h — amplitude spectrum for the Chart spectrum mode
+ *
+ * Keeps the newest fftSize samples of a stream, runs one windowed real FFT
+ * per process() call (= per incoming batch, not per sample) and maintains
+ * an exponentially averaged power spectrum plus optional peak hold.
+ * A spectrum computed elsewhere (e.g. on the producer thread with its own
+ * ChartSpectrum) can be handed over with setMagnitudes().
+ *
+ * buildPolyline() maps N/2 bins onto pixel columns (max per column, linear
+ * or log frequency, dB scale) — the UI draws at most one vertex per column.
+ *
+ * Nie zależy od WinAPI.
+ */
+
+#ifndef CHART_SPECTRUM_H
+#define CHART_SPECTRUM_H
+
+#include "ChartCanvas.h"
+#include "../../Util/FFT.h"
+#include <vector>
+
+// Mapping of (frequency, dB) onto the plot area in pixels
+struct ChartSpectrumViewport {
+    int    left;
+    int    width;
+    int    bottom;
+    int    height;
+    double minHz;
+    double maxHz;
+    double minDb;
+    double maxDb;
+    bool   logFrequency;
+};
+
+class ChartSpectrum {
+public:
+    ChartSpectrum();
+
+    void configure(size_t fftSize, FFTWindow window);
+    size_t getFftSize() const { return m_fft.getSize(); }
+    FFTWindow getWindow() const { return m_fft.getWindow(); }
+
+    // Uśrednianie mocy: nowa = stara + (widmo - stara) / frames (1 = wyłączone)
+    void setAveraging(int frames) { m_averaging = frames > 1 ? frames : 1; }
+    void setPeakHold(bool enabled);
+    void resetPeaks();
+    void clear();
+
+    // Strumień próbek → jedno FFT z najnowszych getFftSize() próbek
+    void process(const double* samples, int count, double sampleRate);
+    // Gotowe amplitudy (liniowe) — np. policzone w wątku producenta
+    void setMagnitudes(const double* magnitudes, size_t bins, double binHz);
+
+    bool   empty()       const { return m_power.empty(); }
+    size_t binCount()    const { return m_power.size(); }
+    double binHz()       const { return m_binHz; }
+    double nyquistHz()   const { return m_binHz * (m_power.empty() ? 0 : m_power.size() - 1); }
+    bool   peakHold()    const { return m_peakHold; }
+    double magnitude(size_t bin) const;
+    double peak(size_t bin) const;
+
+    // Kolumny pikseli: max amplitudy prążków kolumny (uśrednione lub szczytowe)
+    void buildPolyline(const ChartSpectrumViewport& vp, bool peaks, std::vector<ChartPoint>& out) const;
+
+private:
+    FFT m_fft;
+    int m_averaging;
+    bool m_peakHold;
+    double m_binHz;
+
+    std::vector<double> m_history;      // najnowsze próbki (bufor kołowy fftSize)
+    size_t m_historyPos;
+    size_t m_historyCount;
+    std::vector<double> m_frame;        // próbki ułożone chronologicznie dla FFT
+    std::vector<double> m_latest;       // widmo mocy ostatniej ramki
+    std::vector<double> m_power;        // uśrednione widmo mocy
+    std::vector<double> m_peak;         // szczytowe widmo mocy
+    bool m_hasAverage;
+
+    void accumulate(double binHz);
+};
+
+#endif // CHART_SPECTRUM_H
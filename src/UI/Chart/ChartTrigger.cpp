@@ -0,0 +1,95 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 JAQUBA (https://github.com/JAQUBA)
+// Part of JQB_WindowsLib — https://github.com/JAQUBA/JQB_WindowsLib
+
+#include "ChartTrigger.h"
+#include <algorithm>
+
+void ChartTrigger::push(int64_t timeNs, double value, bool segmentStart) {
+    if (value != value) return;     // NaN nie jest przejściem
+
+    if (segmentStart) {
+        m_hasPrev = false;
+        m_armedRising = false;
+        m_armedFalling = false;
+    }
+
+    bool rising  = m_edge != CHART_TRIGGER_FALLING;
+    bool falling = m_edge != CHART_TRIGGER_RISING;
+
+    // Rising: armed below (level - hysteresis), fires above level.
+    // Falling: armed above (level + hysteresis), fires below level.
+    if (rising) {
+        if (m_armedRising && value > m_level && m_hasPrev) {
+            record(timeNs, value);
+            m_armedRising = false;
+        }
+        if (value <= m_level - m_hysteresis) m_armedRising = true;
+    }
+    if (falling) {
+        if (m_armedFalling && value < m_level && m_hasPrev) {
+            record(timeNs, value);
+            m_armedFalling = false;
+        }
+        if (value >= m_level + m_hysteresis) m_armedFalling = true;
+    }
+
+    m_hasPrev = true;
+    m_prevTime = timeNs;
+    m_prevValue = value;
+}
+
+void ChartTrigger::record(int64_t timeNs, double value) {
+    // Sub-sample crossing time — linear interpolation between the two samples
+    int64_t crossing = timeNs;
+    double dv = value - m_prevValue;
+    if (dv != 0.0) {
+        double frac = (m_level - m_prevValue) / dv;
+        if (frac >= 0.0 && frac <= 1.0) {
+            crossing = m_prevTime + (int64_t)(frac * (double)(timeNs - m_prevTime));
+        }
+    }
+
+    if (m_hasLast && (crossing <= m_lastCrossing || crossing - m_lastCrossing < m_holdoffNs)) {
+        return;     // holdoff (or out-of-order time) — ignore this crossing
+    }
+    m_hasLast = true;
+    m_lastCrossing = crossing;
+
+    m_crossings.push_back(crossing);
+}
+
+void ChartTrigger::evictBefore(int64_t timeNs) {
+    while (m_head < m_crossings.size() && m_crossings[m_head] < timeNs) m_head++;
+
+    // Compact once the dead prefix dominates — amortized O(1) per crossing
+    if (m_head > 64 && m_head * 2 > m_crossings.size()) {
+        m_crossings.erase(m_crossings.begin(), m_crossings.begin() + (ptrdiff_t)m_head);
+        m_head = 0;
+    }
+}
+
+void ChartTrigger::reset() {
+    m_crossings.clear();
+    m_head = 0;
+    m_hasPrev = false;
+    m_armedRising = false;
+    m_armedFalling = false;
+    m_hasLast = false;
+}
+
+bool ChartTrigger::latestAtOrBefore(int64_t timeNs, int64_t& crossingNs) const {
+    auto begin = m_crossings.begin() + (ptrdiff_t)m_head;
+    auto it = std::upper_bound(begin, m_crossings.end(), timeNs);
+    if (it == begin) return false;
+    crossingNs = *(it - 1);
+    return true;
+}
+
+bool ChartTrigger::firstAfter(int64_t timeNs, int64_t& crossingNs) const {
+    auto begin = m_crossings.begin() + (ptrdiff_t)m_head;
+    auto it = std::upper_bound(begin, m_crossings.end(), timeNs);
+    if (it == m_crossings.end()) return false;
+    crossingNs = *it;
+    return true;
+}
@@ -0,0 +1,88 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 JAQUBA (https://github.com/JAQUBA)
+// Part of JQB_WindowsLib — https://github.com/JAQUBA/JQB_WindowsLib
+
+/**
+ * ChartTrigger.h — oscilloscope trigger with an incremental crossing index
+ *
+ * Every appended sample runs through a Schmitt-style edge detector (level,
+ * edge, hysteresis, holdoff). Detected crossings are stored as interpolated
+ * timestamps in ascending order, so finding the trigger for a frame is a
+ * binary search instead of a backward scan over the retained samples.
+ *
+ * Nie zależy od WinAPI.
+ */
+
+#ifndef CHART_TRIGGER_H
+#define CHART_TRIGGER_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+enum ChartTriggerEdge {
+    CHART_TRIGGER_RISING = 0,
+    CHART_TRIGGER_FALLING,
+    CHART_TRIGGER_BOTH
+};
+
+enum ChartTriggerMode {
+    CHART_TRIGGER_AUTO = 0,     // free-run when no trigger is found (default)
+    CHART_TRIGGER_NORMAL,       // keep the last triggered frame until a new trigger
+    CHART_TRIGGER_SINGLE        // capture one frame after armTrigger(), then hold
+};
+
+class ChartTrigger {
+public:
+    void setLevel(double level)           { m_level = level; }
+    void setEdge(ChartTriggerEdge edge)   { m_edge = edge; }
+    void setHysteresis(double hysteresis) { m_hysteresis = hysteresis < 0.0 ? -hysteresis : hysteresis; }
+    void setHoldoff(int64_t holdoffNs)    { m_holdoffNs = holdoffNs > 0 ? holdoffNs : 0; }
+
+    double getLevel() const           { return m_level; }
+    ChartTriggerEdge getEdge() const  { return m_edge; }
+    double getHysteresis() const      { return m_hysteresis; }
+    int64_t getHoldoff() const        { return m_holdoffNs; }
+
+    // Feed the next sample. A segment start breaks the edge detector (no
+    // crossing across a gap in the data).
+    void push(int64_t timeNs, double value, bool segmentStart);
+
+    // Forget crossings older than timeNs (the oldest retained sample)
+    void evictBefore(int64_t timeNs);
+
+    // Forget everything (settings are kept)
+    void reset();
+
+    // Latest crossing at or before timeNs; false when there is none
+    bool latestAtOrBefore(int64_t timeNs, int64_t& crossingNs) const;
+    // Earliest crossing after timeNs; false when there is none
+    bool firstAfter(int64_t timeNs, int64_t& crossingNs) const;
+
+    size_t crossingCount() const { return m_crossings.size() - m_head; }
+    // Newest crossing recorded so far (survives evictBefore); false before the first one
+    bool lastCrossing(int64_t& crossingNs) const { crossingNs = m_lastCrossing; return m_hasLast; }
+
+private:
+    double m_level = 0.0;
+    ChartTriggerEdge m_edge = CHART_TRIGGER_RISING;
+    double m_hysteresis = 0.0;
+    int64_t m_holdoffNs = 0;
+
+    // Edge detector state
+    bool m_hasPrev = false;
+    int64_t m_prevTime = 0;
+    double m_prevValue = 0.0;
+    bool m_armedRising = false;
+    bool m_armedFalling = false;
+    bool m_hasLast = false;
+    int64_t m_lastCrossing = 0;
+
+    // Crossing timestamps, ascending; [m_head, size) is live
+    std::vector<int64_t> m_crossings;
+    size_t m_head = 0;
+
+    void record(int64_t timeNs, double value);
+};
+
+#endif // CHART_TRIGGER_H
@@ -0,0 +1,259 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 JAQUBA (https://github.com/JAQUBA)
+// Part of JQB_WindowsLib — https://github.com/JAQUBA/JQB_WindowsLib
+
+#include "FFT.h"
+#include <cmath>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+static const double FFT_PI = 3.14159265358979323846;
+
+FFT::FFT(size_t size, FFTWindow window)
+    : m_size(0), m_window(window), m_scale(1.0), m_enbw(1.0), m_finalRadix2(false)
+{
+    setSize(size);
+}
+
+void FFT::setSize(size_t size) {
+    size_t n = 8;
+    while (n < size) n <<= 1;
+    if (n == m_size) return;
+    m_size = n;
+    build();
+}
+
+void FFT::setWindow(FFTWindow window) {
+    if (window == m_window) return;
+    m_window = window;
+    build();
+}
+
+// ============================================================================
+// Tablice: okno, odwrócenie bitów, twiddle etapów
+// ============================================================================
+void FFT::build() {
+    size_t N = m_size;
+    size_t n = N / 2;
+
+    // Okno okresowe (mianownik N) — właściwe dla analizy widmowej
+    m_windowTable.resize(N);
+    double sum = 0.0, sumSq = 0.0;
+    for (size_t i = 0; i < N; i++) {
+        double x = 2.0 * FFT_PI * (double)i / (double)N;
+        double w;
+        switch (m_window) {
+            case FFT_WINDOW_HANN:
+                w = 0.5 - 0.5 * std::cos(x);
+                break;
+            case FFT_WINDOW_BLACKMAN_HARRIS:
+                w = 0.35875 - 0.48829 * std::cos(x) + 0.14128 * std::cos(2 * x) - 0.01168 * std::cos(3 * x);
+                break;
+            case FFT_WINDOW_FLATTOP:
+                w = 0.21557895 - 0.41663158 * std::cos(x) + 0.277263158 * std::cos(2 * x)
+                  - 0.083578947 * std::cos(3 * x) + 0.006947368 * std::cos(4 * x);
+                break;
+            case FFT_WINDOW_RECT:
+            default:
+                w = 1.0;
+                break;
+        }
+        m_windowTable[i] = w;
+        sum += w;
+        sumSq += w * w;
+    }
+    m_scale = 2.0 / sum;
+    m_enbw = (double)N * sumSq / (sum * sum);
+
+    // Permutacja odwrócenia bitów dla n punktów
+    int bits = 0;
+    while (((size_t)1 << bits) < n) bits++;
+    m_bitrev.resize(n);
+    for (size_t i = 0; i < n; i++) {
+        size_t r = 0;
+        for (int b = 0; b < bits; b++) {
+            if (i & ((size_t)1 << b)) r |= (size_t)1 << (bits - 1 - b);
+        }
+        m_bitrev[i] = r;
+    }
+
+    // Etapy łączone parami: połówki h i 2h (bloki 2h i 4h)
+    m_stages.clear();
+    size_t h = 1;
+    int remaining = bits;
+    while (remaining >= 2) {
+        Stage st;
+        st.half = h;
+        st.w1r.resize(h); st.w1i.resize(h);
+        st.w2r.resize(h); st.w2i.resize(h);
+        for (size_t k = 0; k < h; k++) {
+            double a1 = -2.0 * FFT_PI * (double)k / (double)(2 * h);
+            double a2 = -2.0 * FFT_PI * (double)k / (double)(4 * h);
+            st.w1r[k] = std::cos(a1); st.w1i[k] = std::sin(a1);
+            st.w2r[k] = std::cos(a2); st.w2i[k] = std::sin(a2);
+        }
+        m_stages.push_back(st);
+        h *= 4;
+        remaining -= 2;
+    }
+    m_finalRadix2 = remaining == 1;
+    m_lastR.resize(m_finalRadix2 ? h : 0);
+    m_lastI.resize(m_finalRadix2 ? h : 0);
+    for (size_t k = 0; k < m_lastR.size(); k++) {
+        double a = -2.0 * FFT_PI * (double)k / (double)(2 * h);
+        m_lastR[k] = std::cos(a);
+        m_lastI[k] = std::sin(a);
+    }
+
+    // W_N^k dla kroku rozdzielającego widmo rzeczywiste
+    m_splitR.resize(n + 1);
+    m_splitI.resize(n + 1);
+    for (size_t k = 0; k <= n; k++) {
+        double a = -2.0 * FFT_PI * (double)k / (double)N;
+        m_splitR[k] = std::cos(a);
+        m_splitI[k] = std::sin(a);
+    }
+
+    m_re.resize(n);
+    m_im.resize(n);
+}
+
+// ============================================================================
+// Zespolona FFT (DIT, podwójne etapy radix-2 = radix-4)
+// ============================================================================
+static inline void butterfly4(double* re, double* im, size_t a, size_t h,
+                              double w1r, double w1i, double w2r, double w2i) {
+    size_t b = a + h, c = b + h, d = c + h;
+
+    // Etap 1 (połówka h): pary (a, b) i (c, d), twiddle W_{2h}^k
+    double tr = w1r * re[b] - w1i * im[b], ti = w1r * im[b] + w1i * re[b];
+    double ur = w1r * re[d] - w1i * im[d], ui = w1r * im[d] + w1i * re[d];
+    double a1r = re[a] + tr, a1i = im[a] + ti;
+    double b1r = re[a] - tr, b1i = im[a] - ti;
+    double c1r = re[c] + ur, c1i = im[c] + ui;
+    double d1r = re[c] - ur, d1i = im[c] - ui;
+
+    // Etap 2 (połówka 2h): pary (a, c) z W_{4h}^k, (b, d) z W_{4h}^{k+h} = -i · W_{4h}^k
+    double vr = w2r * c1r - w2i * c1i, vi = w2r * c1i + w2i * c1r;
+    double sr = w2r * d1r - w2i * d1i, si = w2r * d1i + w2i * d1r;
+    re[a] = a1r + vr; im[a] = a1i + vi;
+    re[c] = a1r - vr; im[c] = a1i - vi;
+    re[b] = b1r + si; im[b] = b1i - sr;
+    re[d] = b1r - si; im[d] = b1i + sr;
+}
+
+#if defined(__SSE2__)
+static inline void cmul2(__m128d ar, __m128d ai, __m128d br, __m128d bi, __m128d& r, __m128d& i) {
+    r = _mm_sub_pd(_mm_mul_pd(ar, br), _mm_mul_pd(ai, bi));
+    i = _mm_add_pd(_mm_mul_pd(ar, bi), _mm_mul_pd(ai, br));
+}
+
+// Dwa sąsiednie k naraz (a, a + 1)
+static inline void butterfly4x2(double* re, double* im, size_t a, size_t h,
+                                const double* w1r, const double* w1i,
+                                const double* w2r, const double* w2i) {
+    size_t b = a + h, c = b + h, d = c + h;
+    __m128d W1r = _mm_loadu_pd(w1r), W1i = _mm_loadu_pd(w1i);
+    __m128d W2r = _mm_loadu_pd(w2r), W2i = _mm_loadu_pd(w2i);
+    __m128d Ar = _mm_loadu_pd(re + a), Ai = _mm_loadu_pd(im + a);
+    __m128d Br = _mm_loadu_pd(re + b), Bi = _mm_loadu_pd(im + b);
+    __m128d Cr = _mm_loadu_pd(re + c), Ci = _mm_loadu_pd(im + c);
+    __m128d Dr = _mm_loadu_pd(re + d), Di = _mm_loadu_pd(im + d);
+
+    __m128d tr, ti, ur, ui;
+    cmul2(W1r, W1i, Br, Bi, tr, ti);
+    cmul2(W1r, W1i, Dr, Di, ur, ui);
+    __m128d a1r = _mm_add_pd(Ar, tr), a1i = _mm_add_pd(Ai, ti);
+    __m128d b1r = _mm_sub_pd(Ar, tr), b1i = _mm_sub_pd(Ai, ti);
+    __m128d c1r = _mm_add_pd(Cr, ur), c1i = _mm_add_pd(Ci, ui);
+    __m128d d1r = _mm_sub_pd(Cr, ur), d1i = _mm_sub_pd(Ci, ui);
+
+    __m128d vr, vi, sr, si;
+    cmul2(W2r, W2i, c1r, c1i, vr, vi);
+    cmul2(W2r, W2i, d1r, d1i, sr, si);
+    _mm_storeu_pd(re + a, _mm_add_pd(a1r, vr)); _mm_storeu_pd(im + a, _mm_add_pd(a1i, vi));
+    _mm_storeu_pd(re + c, _mm_sub_pd(a1r, vr)); _mm_storeu_pd(im + c, _mm_sub_pd(a1i, vi));
+    _mm_storeu_pd(re + b, _mm_add_pd(b1r, si)); _mm_storeu_pd(im + b, _mm_sub_pd(b1i, sr));
+    _mm_storeu_pd(re + d, _mm_sub_pd(b1r, si)); _mm_storeu_pd(im + d, _mm_add_pd(b1i, sr));
+}
+#endif
+
+void FFT::complexForward(double* re, double* im) const {
+    size_t n = m_size / 2;
+
+    for (size_t i = 0; i < n; i++) {
+        size_t j = m_bitrev[i];
+        if (j > i) {
+            double t = re[i]; re[i] = re[j]; re[j] = t;
+            t = im[i]; im[i] = im[j]; im[j] = t;
+        }
+    }
+
+    for (const Stage& st : m_stages) {
+        size_t h = st.half;
+        for (size_t base = 0; base < n; base += 4 * h) {
+            size_t k = 0;
+#if defined(__SSE2__)
+            for (; k + 1 < h; k += 2) {
+                butterfly4x2(re, im, base + k, h, &st.w1r[k], &st.w1i[k], &st.w2r[k], &st.w2i[k]);
+            }
+#endif
+            for (; k < h; k++) {
+                butterfly4(re, im, base + k, h, st.w1r[k], st.w1i[k], st.w2r[k], st.w2i[k]);
+            }
+        }
+    }
+
+    if (m_finalRadix2) {
+        size_t h = m_lastR.size();
+        for (size_t k = 0; k < h; k++) {
+            size_t a = k, b = k + h;
+            double tr = m_lastR[k] * re[b] - m_lastI[k] * im[b];
+            double ti = m_lastR[k] * im[b] + m_lastI[k] * re[b];
+            re[b] = re[a] - tr; im[b] = im[a] - ti;
+            re[a] += tr;        im[a] += ti;
+        }
+    }
+}
+
+// ============================================================================
+// Widmo rzeczywiste
+// ============================================================================
+void FFT::transform(const double* input) {
+    size_t n = m_size / 2;
+    const double* w = m_windowTable.data();
+    // Próbki parzyste → część rzeczywista, nieparzyste → urojona
+    for (size_t i = 0; i < n; i++) {
+        m_re[i] = input[2 * i] * w[2 * i];
+        m_im[i] = input[2 * i + 1] * w[2 * i + 1];
+    }
+    complexForward(m_re.data(), m_im.data());
+}
+
+void FFT::power(const double* input, double* output) {
+    transform(input);
+    size_t n = m_size / 2;
+
+    for (size_t k = 0; k <= n; k++) {
+        size_t k1 = k % n, k2 = (n - k) % n;
+        // Z[k] i sprzężenie Z[n - k]
+        double zr = m_re[k1], zi = m_im[k1];
+        double cr = m_re[k2], ci = -m_im[k2];
+        double er = 0.5 * (zr + cr), ei = 0.5 * (zi + ci);     // część parzysta
+        double dr = 0.5 * (zr - cr), di = 0.5 * (zi - ci);
+        double orr = di, oi = -dr;                              // część nieparzysta = -i·d
+        double xr = er + m_splitR[k] * orr - m_splitI[k] * oi;
+        double xi = ei + m_splitR[k] * oi + m_splitI[k] * orr;
+
+        // Prążki 0 i N/2 nie mają odpowiednika ujemnego — połowa skali
+        double s = (k == 0 || k == n) ? 0.5 * m_scale : m_scale;
+        output[k] = (xr * xr + xi * xi) * s * s;
+    }
+}
+
+void FFT::magnitude(const double* input, double* output) {
+    power(input, output);
+    for (size_t k = 0; k <= m_size / 2; k++) output[k] = std::sqrt(output[k]);
+}
@@ -0,0 +1,80 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 JAQUBA (https://github.com/JAQUBA)
+// Part of JQB_WindowsLib — https://github.com/JAQUBA/JQB_WindowsLib
+
+/**
+ * FFT.h — Okienkowana rzeczywista FFT (widmo amplitudowe)
+ *
+ * N rzeczywistych próbek → zespolona FFT o rozmiarze N/2 (dane w tablicach
+ * re/im osobno) + krok rozdzielający widmo. Etapy radix-2 są łączone parami
+ * w motylki radix-4 (jeden przebieg pamięci na dwa etapy); przy __SSE2__
+ * motylki liczą dwie wartości k naraz.
+ *
+ * Amplituda jest skorygowana o wzmocnienie okna: sinus o amplitudzie A
+ * trafiający w prążek daje A (okno flat-top — dokładnie także między prążkami).
+ *
+ * Nie korzysta z WinAPI ani std::thread — bezpieczne dla MinGW.org.
+ */
+
+#ifndef FFT_H
+#define FFT_H
+
+#include <cstddef>
+#include <vector>
+
+enum FFTWindow {
+    FFT_WINDOW_RECT = 0,
+    FFT_WINDOW_HANN,
+    FFT_WINDOW_BLACKMAN_HARRIS,     // 4-term, -92 dB sidelobes
+    FFT_WINDOW_FLATTOP              // amplitude accuracy between bins
+};
+
+class FFT {
+public:
+    explicit FFT(size_t size = 1024, FFTWindow window = FFT_WINDOW_HANN);
+
+    // Rozmiar — potęga dwójki >= 8 (zaokrąglany w górę)
+    void setSize(size_t size);
+    size_t getSize() const { return m_size; }
+    size_t getBinCount() const { return m_size / 2 + 1; }
+
+    void setWindow(FFTWindow window);
+    FFTWindow getWindow() const { return m_window; }
+
+    // getSize() próbek → getBinCount() amplitud (prążek k = k * sampleRate / size)
+    void magnitude(const double* input, double* output);
+    // Jak magnitude(), ale kwadraty amplitud (do uśredniania mocy)
+    void power(const double* input, double* output);
+
+    // Zespolona FFT w miejscu, n = getSize() / 2 punktów
+    void complexForward(double* re, double* im) const;
+
+    // Szerokość pasma szumowego okna w prążkach (ENBW)
+    double getNoiseBandwidth() const { return m_enbw; }
+
+private:
+    size_t m_size;
+    FFTWindow m_window;
+    std::vector<double> m_windowTable;
+    double m_scale;             // 2 / suma okna
+    double m_enbw;
+
+    // Połączone etapy (radix-4): twiddle W_{4h}^k i W_{2h}^k ciągłe dla k < h
+    struct Stage {
+        size_t half;
+        std::vector<double> w1r, w1i;   // W_{2h}^k
+        std::vector<double> w2r, w2i;   // W_{4h}^k
+    };
+    std::vector<Stage> m_stages;
+    bool m_finalRadix2;                 // nieparzysta liczba etapów — ostatni radix-2
+    std::vector<double> m_lastR, m_lastI;
+    std::vector<size_t> m_bitrev;
+    std::vector<double> m_splitR, m_splitI;     // W_N^k dla kroku rozdzielającego
+
+    std::vector<double> m_re, m_im;     // bufory robocze
+
+    void build();
+    void transform(const double* input);
+};
+
+#endif // FFT_H
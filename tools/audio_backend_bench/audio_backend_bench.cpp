@@ -0,0 +1,195 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 JAQUBA (https://github.com/JAQUBA)
+// Part of JQB_WindowsLib — https://github.com/JAQUBA/JQB_WindowsLib
+
+/**
+ * audio_backend_bench.cpp — AudioEngine on AudioNullBackend / AudioLoopbackBackend
+ *
+ * The engine, the null and loopback backends and AudioMeter run on
+ * AudioThread (Win32 or std::thread), so this builds with a plain compiler
+ * on Windows (MinGW) or Linux — see README.md. Measures the complete
+ * generator → backend → capture path without a sound card and checks the
+ * loopback: bit-exact PCM16, real-time pacing, AudioMeter on the generator.
+ * Exit code 1 when a check fails.
+ */
+
+#include "IO/Audio/AudioMeter.h"
+#include "IO/Audio/AudioNullBackend.h"
+#include "IO/Audio/AudioLoopbackBackend.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#define BENCH_SECONDS    0.5
+#define BENCH_RATE       48000
+#define BENCH_RAW_FILE   "audio_backend_bench.raw"
+
+typedef std::chrono::steady_clock Clock;
+
+static double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+static void sleepSeconds(double seconds) {
+    std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+}
+
+// ============================================================================
+// Throughput — AUDIO_CLOCK_FAST, stereo, 8 × 4096
+// ============================================================================
+static void benchOutput(AudioSampleFormat format, const char* name, double seconds) {
+    AudioNullBackend null(AUDIO_CLOCK_FAST);
+    AudioEngine engine;
+    engine.setBackend(&null);
+    engine.setChannels(2);
+    engine.setSampleFormat(format);
+    engine.setBufferGeometry(8, 4096);
+    engine.getWaveGen(0).setFrequency(1000.0);
+    engine.getWaveGen(1).setFrequency(997.0);
+
+    Clock::time_point start = Clock::now();
+    if (!engine.startOutput(0)) {
+        printf("%-24s start failed\n", name);
+        return;
+    }
+    sleepSeconds(seconds);
+    engine.stopOutput();
+    double rate = null.getFramesPlayed() / secondsSince(start);
+    printf("%-24s %10.1f %12.0f\n", name, rate / 1e6, rate / BENCH_RATE);
+}
+
+static void benchInput(double seconds) {
+    AudioNullBackend null(AUDIO_CLOCK_FAST);
+    AudioEngine engine;
+    engine.setBackend(&null);
+    engine.setChannels(2);
+    engine.setBufferGeometry(8, 4096);
+
+    Clock::time_point start = Clock::now();
+    if (!engine.startInput(0)) {
+        printf("%-24s start failed\n", "input (capture rings)");
+        return;
+    }
+    sleepSeconds(seconds);
+    engine.stopInput();
+    double rate = null.getFramesRecorded() / secondsSince(start);
+    printf("%-24s %10.1f %12.0f\n", "input (capture rings)", rate / 1e6, rate / BENCH_RATE);
+}
+
+// ============================================================================
+// Loopback — PCM16 → PCM16 bez zmian (wejście porównane z plikiem wyjścia)
+// ============================================================================
+static bool checkBitExact(double seconds) {
+    const size_t target = 1 << 20;
+    AudioLoopbackBackend loopback(AUDIO_CLOCK_FAST);
+    loopback.setOutputFile(BENCH_RAW_FILE);
+    AudioEngine engine;
+    engine.setBackend(&loopback);
+    engine.setChannels(1);
+    engine.setBufferGeometry(4, 1024);
+    engine.getWaveGen(0).setWaveform(WAVE_WHITE_NOISE);
+    engine.getWaveGen(0).setAmplitude(0.9);
+    engine.setCaptureCapacity(4 * target);   // Zapas na bufory po przekroczeniu celu
+
+    // Pierścień mieści całe nagranie — odczyt po zatrzymaniu, bez wyścigu z wątkiem wejścia
+    AudioCaptureRing& ring = engine.getInputCapture(0);
+    Clock::time_point start = Clock::now();
+    bool started = engine.startOutput(0) && engine.startInput(0);
+    while (started && ring.writePosition() < target && secondsSince(start) < seconds) sleepSeconds(0.001);
+    engine.stopOutput();
+    engine.stopInput();
+
+    AudioCaptureRing::Reader reader = ring.attach(4 * target);
+    std::vector<int16_t> captured(ring.available(reader));
+    captured.resize(ring.read(reader, captured.data(), captured.size()));
+
+    std::vector<int16_t> played;
+    FILE* file = fopen(BENCH_RAW_FILE, "rb");
+    if (file) {
+        int16_t sample;
+        while (fread(&sample, sizeof(sample), 1, file) == 1) played.push_back(sample);
+        fclose(file);
+    }
+    remove(BENCH_RAW_FILE);
+
+    // Bufory zagrane przed otwarciem wejścia nie wracają — wejście to ciągły
+    // fragment pliku wyjścia od pierwszego pasującego bloku
+    const size_t probe = 64;
+    size_t offset = 0;
+    bool found = false;
+    for (; captured.size() >= probe && offset + probe <= played.size(); offset++) {
+        if (std::equal(captured.begin(), captured.begin() + probe, played.begin() + offset)) {
+            found = true;
+            break;
+        }
+    }
+    size_t mismatches = 0;
+    for (size_t i = 0; found && i < captured.size(); i++) {
+        if (offset + i >= played.size() || played[offset + i] != captured[i]) mismatches++;
+    }
+    bool pass = started && found && mismatches == 0 && reader.overruns == 0;
+    printf("loopback fast PCM16: played %zu, captured %zu from %zu, mismatches %zu, overruns %llu — %s\n",
+           played.size(), captured.size(), offset, mismatches, (unsigned long long)reader.overruns,
+           pass ? "bit-exact" : "FAIL");
+    return pass;
+}
+
+// ============================================================================
+// Loopback — zegar czasu rzeczywistego i AudioMeter na wejściu
+// ============================================================================
+static bool checkRealtime(double seconds) {
+    AudioLoopbackBackend loopback(AUDIO_CLOCK_REALTIME);
+    AudioEngine engine;
+    engine.setBackend(&loopback);
+    engine.setChannels(1);
+    engine.setBufferGeometry(4, 1024);
+    engine.getWaveGen(0).setFrequency(1000.0);
+    engine.getWaveGen(0).setAmplitude(0.5);
+
+    Clock::time_point start = Clock::now();
+    bool started = engine.startOutput(0) && engine.startInput(0);
+    AudioMeter meter;
+    bool metering = started && meter.start(engine, 0);
+    sleepSeconds(seconds);
+    double wall = secondsSince(start);
+
+    AudioMeasurement m;
+    bool measured = metering && meter.getMeasurement(m);
+    meter.stop();
+    engine.stopInput();
+    engine.stopOutput();
+
+    // Odtworzone ≈ czas ściany; tolerancja 5% + jedna kolejka (numBuffers × bufferSamples)
+    double played = loopback.getFramesPlayed() / (double)BENCH_RATE;
+    bool paced = std::fabs(played - wall) < 0.05 * wall + 4 * 1024.0 / BENCH_RATE;
+    printf("loopback realtime: %.3f s wall, %.3f s played, %.3f s recorded, underruns %u, overruns %u — %s\n",
+           wall, played, loopback.getFramesRecorded() / (double)BENCH_RATE, engine.getOutputUnderruns(),
+           engine.getInputOverruns(), paced ? "paced" : "FAIL");
+
+    bool locked = measured && std::fabs(m.frequency - 1000.0) < 0.1;
+    printf("meter on loopback: %.4f Hz, RMS %.5f, THD+N %.1f dB — %s\n",
+           measured ? m.frequency : 0.0, measured ? m.rms : 0.0,
+           measured && m.thdN > 0.0 ? 20.0 * std::log10(m.thdN) : 0.0, locked ? "ok" : "FAIL");
+    return started && paced && locked;
+}
+
+int main(int argc, char** argv) {
+    double seconds = argc > 1 ? atof(argv[1]) : BENCH_SECONDS;
+    if (seconds <= 0.0) seconds = BENCH_SECONDS;
+
+    printf("%-24s %10s %12s\n", "null backend, fast", "M frames/s", "x realtime");
+    benchOutput(AUDIO_FORMAT_PCM16,   "output PCM16", seconds);
+    benchOutput(AUDIO_FORMAT_PCM24,   "output PCM24", seconds);
+    benchOutput(AUDIO_FORMAT_FLOAT32, "output float32", seconds);
+    benchInput(seconds);
+    printf("\n");
+
+    bool ok = checkBitExact(seconds * 4.0);
+    ok = checkRealtime(seconds * 2.0) && ok;
+    return ok ? 0 : 1;
+}